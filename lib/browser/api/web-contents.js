@@ -4,6 +4,7 @@ const features = process.electronBinding('features')
 const { EventEmitter } = require('events')
 const electron = require('electron')
 const path = require('path')
+const { Readable } = require('stream')
 const url = require('url')
 const { app, ipcMain, session, deprecate } = electron
 
@@ -203,9 +204,29 @@ WebContents.prototype.executeJavaScript = function (code, hasUserGesture) {
   }
 }
 
-// Translate the options of printToPDF.
-WebContents.prototype.printToPDF = function (options) {
+// Size of the chunks read by the stream of printToPDFStream.
+const pdfStreamChunkSize = 1024 * 1024
+
+// Pushes the PDF in chunks that share the memory of |data|.
+const createPDFStream = function (data) {
+  let offset = 0
+  return new Readable({
+    read () {
+      if (offset >= data.byteLength) {
+        this.push(null)
+        return
+      }
+      const size = Math.min(pdfStreamChunkSize, data.byteLength - offset)
+      this.push(data.subarray(offset, offset + size))
+      offset += size
+    }
+  })
+}
+
+// Translate the options of printToPDF, throws if they are invalid.
+const getPrintingSetting = function (options) {
   const printingSetting = Object.assign({}, defaultPrintingSetting)
+  printingSetting.requestID = getNextId()
   if (options.landscape) {
     printingSetting.landscape = options.landscape
   }
@@ -223,7 +244,7 @@ WebContents.prototype.printToPDF = function (options) {
     const pageSize = options.pageSize
     if (typeof pageSize === 'object') {
       if (!pageSize.height || !pageSize.width) {
-        return Promise.reject(new Error('Must define height and width for pageSize'))
+        throw new Error('Must define height and width for pageSize')
       }
       // Dimensions in Microns
       // 1 meter = 10^6 microns
@@ -236,7 +257,7 @@ WebContents.prototype.printToPDF = function (options) {
     } else if (PDFPageSizes[pageSize]) {
       printingSetting.mediaSize = PDFPageSizes[pageSize]
     } else {
-      return Promise.reject(new Error(`Does not support pageSize with ${pageSize}`))
+      throw new Error(`Does not support pageSize with ${pageSize}`)
     }
   } else {
     printingSetting.mediaSize = PDFPageSizes['A4']
@@ -244,13 +265,42 @@ WebContents.prototype.printToPDF = function (options) {
 
   // Chromium expects this in a 0-100 range number, not as float
   printingSetting.scaleFactor *= 100
+  return printingSetting
+}
+
+const printToPDF = function (webContents, options, output, filePath) {
+  let printingSetting
+  try {
+    printingSetting = getPrintingSetting(options)
+  } catch (error) {
+    return Promise.reject(error)
+  }
   if (features.isPrintingEnabled()) {
-    return this._printToPDF(printingSetting)
+    return webContents._printToPDF(printingSetting, output, filePath)
   } else {
     return Promise.reject(new Error('Printing feature is disabled'))
   }
 }
 
+WebContents.prototype.printToPDF = function (options) {
+  return printToPDF(this, options, 'buffer', '')
+}
+
+WebContents.prototype.printToPDFFile = function (filePath, options) {
+  if (typeof filePath !== 'string' || filePath.length === 0) {
+    return Promise.reject(new Error('Must specify a path'))
+  }
+  return printToPDF(this, options, 'file', filePath)
+}
+
+WebContents.prototype.printToPDFStream = function (options) {
+  return printToPDF(this, options, 'buffer', '').then(createPDFStream)
+}
+
+WebContents.prototype.printToPDFArrayBuffer = function (options) {
+  return printToPDF(this, options, 'arrayBuffer', '')
+}
+
 WebContents.prototype.print = function (...args) {
   if (features.isPrintingEnabled()) {
     this._print(...args)
@@ -425,6 +475,40 @@ deprecate.fnToProperty(WebContents.prototype, 'zoomLevel', '_getZoomLevel', '_se
 deprecate.fnToProperty(WebContents.prototype, 'zoomFactor', '_getZoomFactor', '_setZoomFactor')
 deprecate.fnToProperty(WebContents.prototype, 'frameRate', '_getFrameRate', '_setFrameRate')
 
+// JavaScript wrapper of PDFRenderPool.
+if (features.isPrintingEnabled()) {
+  const { PDFRenderPool } = binding
+
+  // The longest URL a WebContents loads, url::kMaxURLChars.
+  const kMaxURLChars = 2 * 1024 * 1024
+
+  PDFRenderPool.prototype.render = function (job) {
+    let url = job.url
+    if (typeof job.html === 'string') {
+      url = `data:text/html;charset=utf-8;base64,${Buffer.from(job.html).toString('base64')}`
+      if (url.length > kMaxURLChars) {
+        return Promise.reject(new Error(`html is too large to be loaded as a data: URL (${url.length} of at most ${kMaxURLChars} characters), write it to a file and pass its url instead`))
+      }
+    } else if (typeof url !== 'string') {
+      return Promise.reject(new Error('Must specify either url or html'))
+    }
+
+    let output = job.output || 'buffer'
+    if (output !== 'buffer' && output !== 'arrayBuffer') {
+      return Promise.reject(new Error(`Does not support output with ${output}`))
+    }
+    if (job.path) output = 'file'
+
+    let printingSetting
+    try {
+      printingSetting = getPrintingSetting(job)
+    } catch (error) {
+      return Promise.reject(error)
+    }
+    return this._render(url, printingSetting, output, job.path || '')
+  }
+}
+
 // JavaScript wrapper of Debugger.
 const { Debugger } = process.electronBinding('debugger')
 Object.setPrototypeOf(Debugger.prototype, EventEmitter.prototype)
@@ -453,5 +537,29 @@ module.exports = {
 
   getAllWebContents () {
     return binding.getAllWebContents()
+  },
+
+  capturePages (contents, options = {}) {
+    // The captures run concurrently and are encoded on the thread pool.
+    return Promise.all(contents.map(async (webContents) => {
+      return webContents.capturePageToBuffer(undefined, options)
+    }))
+  },
+
+  createPDFRenderPool (options = {}) {
+    if (!features.isPrintingEnabled()) {
+      throw new Error('Printing feature is disabled')
+    }
+    const webContentsOptions = Object.assign({}, options.webPreferences, {
+      offscreen: true,
+      show: false,
+      backgroundThrottling: false
+    })
+    return binding.createPDFRenderPool({
+      size: options.size,
+      maxJobsPerRenderer: options.maxJobsPerRenderer,
+      timeout: options.timeout,
+      webContentsOptions
+    })
   }
 }
@@ -9,21 +9,65 @@ let currentlyRunning: {
   getSources: Promise<ElectronInternal.GetSourcesResult[]>;
 }[] = []
 
+// A capturer that finished its last request. It keeps its media lists, so
+// reusing it avoids recreating the platform capturers on every request.
+let idleCapturer: ElectronInternal.DesktopCapturer | null = null
+let idleTimeout: NodeJS.Timeout | null = null
+
+// How long an idle capturer keeps its media lists before releasing them.
+const IDLE_CAPTURER_TIMEOUT = 10 * 1000
+
+const takeIdleCapturer = () => {
+  const capturer = idleCapturer
+  idleCapturer = null
+  if (idleTimeout) {
+    clearTimeout(idleTimeout)
+    idleTimeout = null
+  }
+  return capturer
+}
+
+const setIdleCapturer = (capturer: ElectronInternal.DesktopCapturer) => {
+  const previous = takeIdleCapturer()
+  if (previous) previous.releaseLists()
+  idleCapturer = capturer
+  idleTimeout = setTimeout(() => {
+    const capturer = takeIdleCapturer()
+    if (capturer) capturer.releaseLists()
+  }, IDLE_CAPTURER_TIMEOUT)
+}
+
+const serializeSource = (source: Electron.DesktopCapturerSource, fetchWindowIcons: boolean): ElectronInternal.GetSourcesResult => ({
+  id: source.id,
+  name: source.name,
+  thumbnail: source.thumbnail.toDataURL(),
+  display_id: source.display_id,
+  appIcon: (fetchWindowIcons && source.appIcon) ? source.appIcon.toDataURL() : null
+})
+
 export const getSources = (event: Electron.IpcMainEvent, options: ElectronInternal.GetSourcesOptions) => {
-  for (const running of currentlyRunning) {
-    if (deepEqual(running.options, options)) {
-      // If a request is currently running for the same options
-      // return that promise
-      return running.getSources
+  // Streaming requests report to their own sender, so they are never shared.
+  if (options.streamId === undefined) {
+    for (const running of currentlyRunning) {
+      if (deepEqual(running.options, options)) {
+        // If a request is currently running for the same options
+        // return that promise
+        return running.getSources
+      }
     }
   }
 
   const getSources = new Promise<ElectronInternal.GetSourcesResult[]>((resolve, reject) => {
-    let capturer: ElectronInternal.DesktopCapturer | null = createDesktopCapturer()
+    let capturer: ElectronInternal.DesktopCapturer | null = takeIdleCapturer() || createDesktopCapturer()
 
-    const stopRunning = () => {
+    const stopRunning = (reusable: boolean) => {
       if (capturer) {
         capturer.emit = null
+        if (reusable) {
+          setIdleCapturer(capturer)
+        } else {
+          capturer.releaseLists()
+        }
         capturer = null
       }
       // Remove from currentlyRunning once we resolve or reject
@@ -33,28 +77,42 @@ export const getSources = (event: Electron.IpcMainEvent, options: ElectronIntern
     const emitter = new EventEmitter()
 
     emitter.once('error', (event, error: string) => {
-      stopRunning()
+      stopRunning(false)
       reject(error)
     })
 
     emitter.once('finished', (event, sources: Electron.DesktopCapturerSource[], fetchWindowIcons: boolean) => {
-      stopRunning()
-      resolve(sources.map(source => ({
-        id: source.id,
-        name: source.name,
-        thumbnail: source.thumbnail.toDataURL(),
-        display_id: source.display_id,
-        appIcon: (fetchWindowIcons && source.appIcon) ? source.appIcon.toDataURL() : null
-      })))
+      stopRunning(true)
+      resolve(sources.map(source => serializeSource(source, fetchWindowIcons)))
     })
 
+    if (options.streamId !== undefined) {
+      const sender = event.sender as Electron.WebContentsInternal
+      const channel = `ELECTRON_RENDERER_DESKTOP_CAPTURER_STREAM_${options.streamId}`
+      const send = (...args: any[]) => {
+        if (!sender.isDestroyed()) sender._sendInternal(channel, ...args)
+      }
+
+      emitter.on('source', (event, source: Electron.DesktopCapturerSource) => {
+        send('source', serializeSource(source, options.fetchWindowIcons))
+      })
+
+      emitter.on('thumbnail', (event, id: string, thumbnail: Electron.NativeImage, index: number) => {
+        send('thumbnail', id, thumbnail.toDataURL(), index)
+      })
+    }
+
     capturer.emit = emitter.emit.bind(emitter)
-    capturer.startHandling(options.captureWindow, options.captureScreen, options.thumbnailSize, options.fetchWindowIcons)
+    if (options.streamId !== undefined) {
+      capturer.startStreaming(options.captureWindow, options.captureScreen, options.thumbnailSizes || [options.thumbnailSize], options.fetchWindowIcons)
+    } else {
+      capturer.startHandling(options.captureWindow, options.captureScreen, options.thumbnailSize, options.fetchWindowIcons)
+    }
 
     // If the WebContents is destroyed before receiving result, just remove the
     // reference to emit and the capturer itself so that it never dispatches
     // back to the renderer
-    event.sender.once('destroyed', () => stopRunning())
+    event.sender.once('destroyed', () => stopRunning(false))
   })
 
   currentlyRunning.push({
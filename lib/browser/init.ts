@@ -1,4 +1,5 @@
 import { Buffer } from 'buffer'
+import { EventEmitter } from 'events'
 import * as fs from 'fs'
 import * as path from 'path'
 import * as util from 'util'
@@ -15,6 +16,9 @@ require('../common/reset-search-paths')
 // Import common settings.
 require('@electron/internal/common/init')
 
+// Lets native code skip emitting events that have no listener.
+process.electronBinding('event').setDefaultEmit(EventEmitter.prototype.emit)
+
 if (process.platform === 'win32') {
   // Redirect node's console to use our own implementations, since node can not
   // handle console output when running as GUI program.
@@ -30,6 +30,11 @@ const FUNCTION_PROPERTIES = [
 // id => Function
 const rendererFunctions = v8Util.createDoubleIDWeakMap()
 
+// Whether the value can be sent as it is.
+const isPrimitive = function (value) {
+  return value == null || ['boolean', 'number', 'string'].includes(typeof value)
+}
+
 // Return the description of object's members:
 const getObjectMembers = function (object) {
   let names = Object.getOwnPropertyNames(object)
@@ -49,6 +54,12 @@ const getObjectMembers = function (object) {
     } else {
       if (descriptor.set || descriptor.writable) member.writable = true
       member.type = 'get'
+      if (!descriptor.get && !descriptor.set && !descriptor.writable &&
+          !descriptor.configurable && isPrimitive(descriptor.value)) {
+        // The value can never change, send it along with the member.
+        member.cached = true
+        member.value = descriptor.value
+      }
     }
     return member
   })
@@ -432,7 +443,7 @@ handleRemoteCommand('ELECTRON_BROWSER_MEMBER_SET', function (event, contextId, i
   return null
 })
 
-handleRemoteCommand('ELECTRON_BROWSER_MEMBER_GET', function (event, contextId, id, name) {
+const getMember = function (event, contextId, id, name) {
   const obj = objectsRegistry.get(id)
 
   if (obj == null) {
@@ -440,10 +451,31 @@ handleRemoteCommand('ELECTRON_BROWSER_MEMBER_GET', function (event, contextId, i
   }
 
   return valueToMeta(event.sender, contextId, obj[name])
+}
+
+handleRemoteCommand('ELECTRON_BROWSER_MEMBER_GET', getMember)
+
+// Runs several property reads in one round trip, each command gets its own
+// result or exception.
+handleRemoteCommand('ELECTRON_BROWSER_BATCH', function (event, contextId, commands) {
+  return commands.map(({ command, id, name }) => {
+    try {
+      switch (command) {
+        case 'get':
+          return getMember(event, contextId, id, name)
+        default:
+          throwRPCError(`Unknown batch command: ${command}`)
+      }
+    } catch (error) {
+      return exceptionToMeta(error)
+    }
+  })
 })
 
-handleRemoteCommand('ELECTRON_BROWSER_DEREFERENCE', function (event, contextId, id, rendererSideRefCount) {
-  objectsRegistry.remove(event.sender, contextId, id, rendererSideRefCount)
+handleRemoteCommand('ELECTRON_BROWSER_DEREFERENCE', function (event, contextId, refs) {
+  for (const [id, rendererSideRefCount] of refs) {
+    objectsRegistry.remove(event.sender, contextId, id, rendererSideRefCount)
+  }
 })
 
 handleRemoteCommand('ELECTRON_BROWSER_CONTEXT_RELEASE', (event, contextId) => {
@@ -497,13 +529,21 @@ const allowedClipboardMethods = (() => {
 })()
 
 ipcMainUtils.handleSync('ELECTRON_BROWSER_CLIPBOARD', function (event, method, ...args) {
-  if (!allowedClipboardMethods.has(method)) {
+  if (!allowedClipboardMethods.has(method) || clipboardUtils.isAsyncMethod(method)) {
     throw new Error(`Invalid method: ${method}`)
   }
 
   return clipboardUtils.serialize(electron.clipboard[method](...clipboardUtils.deserialize(args)))
 })
 
+ipcMainInternal.handle('ELECTRON_BROWSER_CLIPBOARD_ASYNC', async function (event, method, ...args) {
+  if (!allowedClipboardMethods.has(method) || !clipboardUtils.isAsyncMethod(method)) {
+    throw new Error(`Invalid method: ${method}`)
+  }
+
+  return clipboardUtils.serialize(await electron.clipboard[method](...clipboardUtils.deserialize(args)))
+})
+
 if (features.isDesktopCapturerEnabled()) {
   const desktopCapturer = require('@electron/internal/browser/desktop-capturer')
 
@@ -3,10 +3,18 @@
 const clipboard = process.electronBinding('clipboard')
 
 if (process.type === 'renderer') {
+  const { ipcRendererInternal } = require('@electron/internal/renderer/ipc-renderer-internal')
   const ipcRendererUtils = require('@electron/internal/renderer/ipc-renderer-internal-utils')
   const clipboardUtils = require('@electron/internal/common/clipboard-utils')
 
   const makeRemoteMethod = function (method) {
+    if (clipboardUtils.isAsyncMethod(method)) {
+      return async (...args) => {
+        args = clipboardUtils.serialize(args)
+        const result = await ipcRendererInternal.invoke('ELECTRON_BROWSER_CLIPBOARD_ASYNC', method, ...args)
+        return clipboardUtils.deserialize(result)
+      }
+    }
     return (...args) => {
       args = clipboardUtils.serialize(args)
       const result = ipcRendererUtils.invokeSync('ELECTRON_BROWSER_CLIPBOARD', method, ...args)
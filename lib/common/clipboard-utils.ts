@@ -6,6 +6,11 @@ const objectMap = function (source: Object, mapper: (value: any) => any) {
   return Object.fromEntries(targetEntries)
 }
 
+// Methods which return a promise are forwarded without blocking the renderer.
+export function isAsyncMethod (method: string) {
+  return method.endsWith('Async')
+}
+
 export function serialize (value: any): any {
   if (value instanceof NativeImage) {
     return {
@@ -1,33 +1,75 @@
 import { nativeImage } from 'electron'
 import { ipcRendererInternal } from '@electron/internal/renderer/ipc-renderer-internal'
 
+let nextStreamId = 0
+
 // |options.types| can't be empty and must be an array
 function isValid (options: Electron.SourcesOptions) {
   const types = options ? options.types : undefined
   return Array.isArray(types)
 }
 
+const deserializeSource = (source: ElectronInternal.GetSourcesResult): Electron.DesktopCapturerSource => ({
+  id: source.id,
+  name: source.name,
+  thumbnail: nativeImage.createFromDataURL(source.thumbnail),
+  display_id: source.display_id,
+  appIcon: source.appIcon ? nativeImage.createFromDataURL(source.appIcon) : null
+})
+
 export async function getSources (options: Electron.SourcesOptions) {
   if (!isValid(options)) throw new Error('Invalid options')
 
   const captureWindow = options.types.includes('window')
   const captureScreen = options.types.includes('screen')
 
-  const { thumbnailSize = { width: 150, height: 150 } } = options
+  const { thumbnailSizes, onSource } = options
+  let { thumbnailSize = { width: 150, height: 150 } } = options
   const { fetchWindowIcons = false } = options
 
-  const sources = await ipcRendererInternal.invoke<ElectronInternal.GetSourcesResult[]>('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', {
+  if (Array.isArray(thumbnailSizes) && thumbnailSizes.length > 0) {
+    thumbnailSize = thumbnailSizes[thumbnailSizes.length - 1]
+  }
+
+  const getSourcesOptions: ElectronInternal.GetSourcesOptions = {
     captureWindow,
     captureScreen,
     thumbnailSize,
     fetchWindowIcons
-  } as ElectronInternal.GetSourcesOptions)
-
-  return sources.map(source => ({
-    id: source.id,
-    name: source.name,
-    thumbnail: nativeImage.createFromDataURL(source.thumbnail),
-    display_id: source.display_id,
-    appIcon: source.appIcon ? nativeImage.createFromDataURL(source.appIcon) : null
-  }))
+  }
+
+  if (typeof onSource !== 'function') {
+    const sources = await ipcRendererInternal.invoke<ElectronInternal.GetSourcesResult[]>('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', getSourcesOptions)
+    return sources.map(deserializeSource)
+  }
+
+  const streamId = nextStreamId++
+  const channel = `ELECTRON_RENDERER_DESKTOP_CAPTURER_STREAM_${streamId}`
+  const streamed = new Map<string, Electron.DesktopCapturerSource>()
+  const listener = (event: Electron.IpcRendererEvent, type: string, ...args: any[]) => {
+    if (type === 'source') {
+      const source = deserializeSource(args[0])
+      streamed.set(source.id, source)
+      onSource(source)
+    } else if (type === 'thumbnail') {
+      const [id, thumbnail] = args
+      const source = streamed.get(id)
+      if (source) {
+        source.thumbnail = nativeImage.createFromDataURL(thumbnail)
+        onSource(source)
+      }
+    }
+  }
+
+  ipcRendererInternal.on(channel, listener)
+  try {
+    const sources = await ipcRendererInternal.invoke<ElectronInternal.GetSourcesResult[]>('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', {
+      ...getSourcesOptions,
+      streamId,
+      thumbnailSizes: (Array.isArray(thumbnailSizes) && thumbnailSizes.length > 0) ? thumbnailSizes : [thumbnailSize]
+    })
+    return sources.map(deserializeSource)
+  } finally {
+    ipcRendererInternal.removeListener(channel, listener)
+  }
 }
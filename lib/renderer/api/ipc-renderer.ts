@@ -29,4 +29,12 @@ ipcRenderer.invoke = async function (channel, ...args) {
   return result
 }
 
+ipcRenderer.getStats = function () {
+  return ipc.getStats()
+}
+
+ipcRenderer.resetStats = function () {
+  ipc.resetStats()
+}
+
 export default ipcRenderer
@@ -138,10 +138,14 @@ function setObjectMembers (ref, object, metaId, members) {
       }
       descriptor.configurable = true
     } else if (member.type === 'get') {
-      descriptor.get = () => {
-        const command = 'ELECTRON_BROWSER_MEMBER_GET'
-        const meta = ipcRendererInternal.sendSync(command, contextId, metaId, member.name)
-        return metaToValue(meta)
+      if (member.cached) {
+        descriptor.get = () => member.value
+      } else {
+        descriptor.get = () => {
+          const command = 'ELECTRON_BROWSER_MEMBER_GET'
+          const meta = ipcRendererInternal.sendSync(command, contextId, metaId, member.name)
+          return metaToValue(meta)
+        }
       }
 
       if (member.writable) {
@@ -286,9 +290,13 @@ handleMessage('ELECTRON_RENDERER_CALLBACK', (id, args) => {
   callbacksRegistry.apply(id, metaToValue(args))
 })
 
-// A callback in browser is released.
-handleMessage('ELECTRON_RENDERER_RELEASE_CALLBACK', (id) => {
-  callbacksRegistry.remove(id)
+// Callbacks in browser are released, the callbacks collected by a garbage
+// collection come in one message.
+ipcRendererInternal.on('ELECTRON_RENDERER_RELEASE_CALLBACK', (event, passedContextId, ids) => {
+  if (passedContextId !== contextId) return
+  for (const id of ids) {
+    callbacksRegistry.remove(id)
+  }
 })
 
 exports.require = (module) => {
@@ -336,6 +344,24 @@ exports.createFunctionWithReturnValue = (returnValue) => {
   return func
 }
 
+// Read several properties of a remote object in one round trip.
+exports.getProperties = (object, names) => {
+  const id = v8Util.getHiddenValue(object, 'atomId')
+  if (id == null) throw new TypeError('Expected a remote object')
+  if (!Array.isArray(names)) throw new TypeError('Expected an array of property names')
+
+  const command = 'ELECTRON_BROWSER_BATCH'
+  const commands = names.map((name) => ({ command: 'get', id, name: String(name) }))
+  const metas = ipcRendererInternal.sendSync(command, contextId, commands)
+  if (!Array.isArray(metas)) return metaToValue(metas)
+
+  const properties = {}
+  names.forEach((name, index) => {
+    properties[name] = metaToValue(metas[index])
+  })
+  return properties
+}
+
 // Get the guest WebContents from guestInstanceId.
 exports.getGuestWebContents = (guestInstanceId) => {
   const command = 'ELECTRON_BROWSER_GUEST_WEB_CONTENTS'
@@ -5,6 +5,7 @@
 #ifndef NATIVE_MATE_NATIVE_MATE_DICTIONARY_H_
 #define NATIVE_MATE_NATIVE_MATE_DICTIONARY_H_
 
+#include "../shell/common/gin_helper/key_cache.h"
 #include "native_mate/converter.h"
 #include "native_mate/object_template_builder.h"
 
@@ -45,7 +46,7 @@ class Dictionary {
     // Check for existence before getting, otherwise this method will always
     // returns true when T == v8::Local<v8::Value>.
     v8::Local<v8::Context> context = isolate_->GetCurrentContext();
-    v8::Local<v8::String> v8_key = StringToV8(isolate_, key);
+    v8::Local<v8::String> v8_key = gin_helper::KeyToV8(isolate_, key);
     if (!internal::IsTrue(GetHandle()->Has(context, v8_key)))
       return false;
 
@@ -60,8 +61,9 @@ class Dictionary {
     v8::Local<v8::Value> v8_value;
     if (!TryConvertToV8(isolate_, val, &v8_value))
       return false;
-    v8::Maybe<bool> result = GetHandle()->Set(
-        isolate_->GetCurrentContext(), StringToV8(isolate_, key), v8_value);
+    v8::Maybe<bool> result =
+        GetHandle()->Set(isolate_->GetCurrentContext(),
+                         gin_helper::KeyToV8(isolate_, key), v8_value);
     return !result.IsNothing() && result.FromJust();
   }
 
@@ -71,15 +73,16 @@ class Dictionary {
     if (!TryConvertToV8(isolate_, val, &v8_value))
       return false;
     v8::Maybe<bool> result = GetHandle()->DefineOwnProperty(
-        isolate_->GetCurrentContext(), StringToV8(isolate_, key), v8_value,
-        v8::ReadOnly);
+        isolate_->GetCurrentContext(), gin_helper::KeyToV8(isolate_, key),
+        v8_value, v8::ReadOnly);
     return !result.IsNothing() && result.FromJust();
   }
 
   template <typename T>
   bool SetMethod(base::StringPiece key, const T& callback) {
     return GetHandle()
-        ->Set(isolate_->GetCurrentContext(), StringToV8(isolate_, key),
+        ->Set(isolate_->GetCurrentContext(),
+              gin_helper::KeyToV8(isolate_, key),
               CallbackTraits<T>::CreateTemplate(isolate_, callback)
                   ->GetFunction(isolate_->GetCurrentContext())
                   .ToLocalChecked())
@@ -87,8 +90,8 @@ class Dictionary {
   }
 
   bool Delete(base::StringPiece key) {
-    v8::Maybe<bool> result = GetHandle()->Delete(isolate_->GetCurrentContext(),
-                                                 StringToV8(isolate_, key));
+    v8::Maybe<bool> result = GetHandle()->Delete(
+        isolate_->GetCurrentContext(), gin_helper::KeyToV8(isolate_, key));
     return !result.IsNothing() && result.FromJust();
   }
 
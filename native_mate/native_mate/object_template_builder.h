@@ -42,7 +42,9 @@ struct CallbackTraits<base::Callback<T>> {
 template <typename T>
 struct CallbackTraits<
     T,
-    typename std::enable_if<std::is_member_function_pointer<T>::value>::type> {
+    typename std::enable_if<std::is_member_function_pointer<T>::value &&
+                            !internal::MemberFunctionTraits<T>::is_simple>::
+        type> {
   static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate* isolate,
                                                         T callback) {
     int flags = HolderIsFirstArgument;
@@ -50,6 +52,19 @@ struct CallbackTraits<
   }
 };
 
+// Member functions that only take simple arguments, like most getters, are
+// called directly on the holder instead of through a base::Callback.
+template <typename T>
+struct CallbackTraits<
+    T,
+    typename std::enable_if<internal::MemberFunctionTraits<T>::is_simple>::
+        type> {
+  static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate* isolate,
+                                                        T callback) {
+    return mate::CreateMemberFunctionTemplate(isolate, callback);
+  }
+};
+
 // This specialization allows people to construct function templates directly if
 // they need to do fancier stuff.
 template <>
@@ -0,0 +1,74 @@
+#!/usr/bin/env node
+
+// Runs one of the Electron apps in script/benchmarks/ against the local
+// build and summarizes the samples it reports.
+//
+// Each benchmark app prints one JSON object per line on stdout of the form
+// { "metric": "name", "value": 12.3, "unit": "ms" } and then quits, see
+// report() in script/benchmarks/helpers.js.
+//
+// Usage: node script/benchmark.js <name> [--runs=N] [-- app args]
+
+const childProcess = require('child_process')
+const path = require('path')
+
+const utils = require('./lib/utils')
+
+const args = require('minimist')(process.argv.slice(2), {
+  default: { runs: 1 },
+  '--': true
+})
+
+const name = args._[0]
+if (!name) {
+  console.error('Usage: node script/benchmark.js <name> [--runs=N]')
+  process.exit(1)
+}
+
+const appPath = path.resolve(__dirname, 'benchmarks', name)
+const electron = utils.getAbsoluteElectronExec()
+
+function runOnce () {
+  const result = childProcess.spawnSync(electron, [appPath, ...args['--']], {
+    encoding: 'utf8',
+    env: Object.assign({}, process.env, { ELECTRON_ENABLE_LOGGING: '' })
+  })
+  if (result.status !== 0) {
+    console.error(result.stderr)
+    throw new Error(`Benchmark ${name} exited with ${result.status}`)
+  }
+  const samples = []
+  for (const line of result.stdout.split(/\r?\n/)) {
+    if (!line.startsWith('{')) continue
+    try {
+      samples.push(JSON.parse(line))
+    } catch {
+      // Ignore output that isn't a sample.
+    }
+  }
+  return samples
+}
+
+function summarize (values) {
+  const sorted = [...values].sort((a, b) => a - b)
+  const median = sorted[Math.floor(sorted.length / 2)]
+  const mean = sorted.reduce((a, b) => a + b, 0) / sorted.length
+  return { min: sorted[0], median, mean, max: sorted[sorted.length - 1] }
+}
+
+const metrics = new Map()
+for (let i = 0; i < args.runs; i++) {
+  for (const sample of runOnce()) {
+    if (!metrics.has(sample.metric)) {
+      metrics.set(sample.metric, { unit: sample.unit, values: [] })
+    }
+    metrics.get(sample.metric).values.push(sample.value)
+  }
+}
+
+for (const [metric, { unit, values }] of metrics) {
+  const { min, median, mean, max } = summarize(values)
+  const format = v => `${Number(v.toFixed(3))}${unit ? ' ' + unit : ''}`
+  console.log(`${metric}: median ${format(median)}, mean ${format(mean)}, ` +
+              `min ${format(min)}, max ${format(max)} (${values.length} samples)`)
+}
@@ -0,0 +1,43 @@
+// Measures the cost of calling small native API methods from JavaScript,
+// where the binding overhead is most of the work. Run with
+// `node script/benchmark.js api-calls --runs=5 -- --iterations=1000000`.
+
+const { app, BrowserWindow } = require('electron')
+
+const { arg, report } = require('../helpers')
+
+const iterations = parseInt(arg('iterations', '1000000'), 10)
+
+// Returns the average time of one call to |fn| in nanoseconds.
+function measure (fn) {
+  // Warm up so that the call sites are optimized before timing them.
+  for (let i = 0; i < 10000; i++) fn()
+  const start = process.hrtime.bigint()
+  for (let i = 0; i < iterations; i++) fn()
+  return Number(process.hrtime.bigint() - start) / iterations
+}
+
+app.once('ready', async () => {
+  const w = new BrowserWindow({ show: false })
+  await w.loadURL('data:text/html,<title>api-calls</title>')
+  const contents = w.webContents
+
+  let sink
+  const calls = {
+    'webContents.id': () => { sink = contents.id },
+    'webContents.isDestroyed()': () => { sink = contents.isDestroyed() },
+    'webContents.getURL()': () => { sink = contents.getURL() },
+    'webContents.getTitle()': () => { sink = contents.getTitle() },
+    'webContents.isLoading()': () => { sink = contents.isLoading() },
+    'webContents.zoomFactor': () => { sink = contents.zoomFactor },
+    'webContents.setBackgroundThrottling()': () => { contents.setBackgroundThrottling(true) },
+    'BrowserWindow.isVisible()': () => { sink = w.isVisible() },
+    'BrowserWindow.getBounds()': () => { sink = w.getBounds() }
+  }
+  for (const [name, fn] of Object.entries(calls)) {
+    report(name, measure(fn), 'ns')
+  }
+  void sink
+
+  app.quit()
+})
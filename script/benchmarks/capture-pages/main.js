@@ -0,0 +1,56 @@
+// Times making PNG thumbnails of many windows: capturing each page at full
+// size and encoding it on the main thread, against capturing all of them
+// scaled and encoded on the thread pool. Also reports the longest stall of
+// the main thread during each. Run with
+// `node script/benchmark.js capture-pages --runs=5 -- --windows=8`.
+
+const { app, BrowserWindow, webContents } = require('electron')
+
+const { arg, report } = require('../helpers')
+
+const windowCount = parseInt(arg('windows', '8'), 10)
+const thumbnailWidth = parseInt(arg('width', '320'), 10)
+
+// Returns the duration of |fn| and the longest gap between two timer ticks
+// while it ran.
+async function measure (fn) {
+  let longestStall = 0
+  let last = process.hrtime.bigint()
+  const timer = setInterval(() => {
+    const now = process.hrtime.bigint()
+    longestStall = Math.max(longestStall, Number(now - last) / 1e6)
+    last = now
+  }, 1)
+  const start = process.hrtime.bigint()
+  await fn()
+  const elapsed = Number(process.hrtime.bigint() - start) / 1e6
+  clearInterval(timer)
+  return { elapsed, longestStall }
+}
+
+app.once('ready', async () => {
+  const windows = []
+  for (let i = 0; i < windowCount; i++) {
+    const w = new BrowserWindow({ width: 1280, height: 800 })
+    await w.loadURL(`data:text/html,<body style="background: hsl(${i * 40}, 60%, 50%)"><h1>Window ${i}</h1></body>`)
+    windows.push(w)
+  }
+  const contents = windows.map(w => w.webContents)
+
+  const sync = await measure(async () => {
+    for (const c of contents) {
+      const image = await c.capturePage()
+      image.resize({ width: thumbnailWidth }).toPNG()
+    }
+  })
+  report('sequential-sync-encode', sync.elapsed)
+  report('sequential-sync-encode-longest-stall', sync.longestStall)
+
+  const batch = await measure(() => {
+    return webContents.capturePages(contents, { width: thumbnailWidth })
+  })
+  report('batch-pool-encode', batch.elapsed)
+  report('batch-pool-encode-longest-stall', batch.longestStall)
+
+  app.quit()
+})
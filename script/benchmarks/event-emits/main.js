@@ -0,0 +1,52 @@
+// Measures navigation-heavy workloads and counts how many of the events
+// emitted from native code had to reach JavaScript. Run with
+// `node script/benchmark.js event-emits --runs=5`.
+
+const { app, BrowserWindow } = require('electron')
+
+const { report } = require('../helpers')
+
+const navigations = 100
+const eventBinding = process.electronBinding('event')
+
+async function navigate (w) {
+  const before = eventBinding.getEmitStats()
+  const start = process.hrtime.bigint()
+  for (let i = 0; i < navigations; i++) {
+    // Each page also logs to the console and changes the title, which emit
+    // 'console-message' and 'page-title-updated'.
+    await w.loadURL(`data:text/html,<title>${i}</title><script>console.log(${i})</script>`)
+  }
+  const elapsed = Number(process.hrtime.bigint() - start) / 1e6
+  const after = eventBinding.getEmitStats()
+  return {
+    perNavigation: elapsed / navigations,
+    emits: (after.emits - before.emits) / navigations,
+    skipped: (after.skipped - before.skipped) / navigations
+  }
+}
+
+app.once('ready', async () => {
+  const w = new BrowserWindow({ show: false })
+
+  const quiet = await navigate(w)
+  report('navigation', quiet.perNavigation)
+  report('emits-per-navigation', quiet.emits, '')
+  report('skipped-per-navigation', quiet.skipped, '')
+
+  // Same workload with a listener on every event, so nothing can be skipped.
+  const emit = w.webContents.emit
+  const names = new Set()
+  w.webContents.emit = function (name, ...args) {
+    names.add(name)
+    return emit.call(this, name, ...args)
+  }
+  await navigate(w)
+  w.webContents.emit = emit
+  for (const name of names) w.webContents.on(name, () => {})
+  const busy = await navigate(w)
+  report('navigation-all-listened', busy.perNavigation)
+  report('skipped-per-navigation-all-listened', busy.skipped, '')
+
+  app.quit()
+})
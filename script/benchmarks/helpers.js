@@ -0,0 +1,15 @@
+// Helpers shared by the benchmark apps in this directory.
+
+// Returns the value of a `--name=value` argument passed after `--` to
+// script/benchmark.js, or |fallback| when it is not given.
+function arg (name, fallback) {
+  const found = process.argv.find(a => a.startsWith(`--${name}=`))
+  return found ? found.split('=')[1] : fallback
+}
+
+// Prints a sample in the format script/benchmark.js collects.
+function report (metric, value, unit = 'ms') {
+  console.log(JSON.stringify({ metric, value, unit }))
+}
+
+module.exports = { arg, report }
@@ -0,0 +1,57 @@
+// Times the image.transform() kernels and the toBitmap() conversions with the
+// SIMD implementations and with the portable C ones. The Lanczos resize and
+// composite steps use Skia, which is not affected by the switch. Run with
+// `node script/benchmark.js image-ops --runs=5 -- --image-ops-simd-toggle`.
+
+const { app, nativeImage } = require('electron')
+
+const { report } = require('../helpers')
+
+const binding = process.electronBinding('native_image')
+const size = 2048
+const iterations = 10
+
+function time (fn) {
+  fn()
+  const start = process.hrtime.bigint()
+  for (let i = 0; i < iterations; i++) fn()
+  return Number(process.hrtime.bigint() - start) / 1e6 / iterations
+}
+
+app.once('ready', () => {
+  if (!binding._setSIMDEnabled) {
+    console.error('The image-ops benchmark needs the --image-ops-simd-toggle switch')
+    app.exit(1)
+    return
+  }
+
+  const pixels = Buffer.alloc(size * size * 4)
+  for (let i = 0; i < pixels.length; i += 4) {
+    pixels[i] = i & 0xff
+    pixels[i + 1] = (i >> 8) & 0xff
+    pixels[i + 2] = (i >> 16) & 0xff
+    pixels[i + 3] = 0xff
+  }
+  const image = nativeImage.createFromBitmap(pixels, { width: size, height: size })
+
+  const cases = {
+    'resize-box': () => image.transform([{ type: 'resize', width: size / 4, filter: 'box' }]),
+    'resize-bilinear': () => image.transform([{ type: 'resize', width: size / 4, filter: 'bilinear' }]),
+    'blur': () => image.transform([{ type: 'blur', radius: 8 }]),
+    'grayscale': () => image.transform([{ type: 'grayscale' }]),
+    'to-rgba': () => image.toBitmap({ format: 'rgba' }),
+    'to-unpremultiplied': () => image.toBitmap({ premultiplied: false }),
+    'to-i420': () => image.toBitmap({ format: 'i420' }),
+    'from-rgba': () => nativeImage.createFromBitmap(pixels, { width: size, height: size, format: 'rgba' })
+  }
+
+  for (const [name, fn] of Object.entries(cases)) {
+    binding._setSIMDEnabled(true)
+    report(`${name}-simd`, time(fn))
+    binding._setSIMDEnabled(false)
+    report(`${name}-scalar`, time(fn))
+  }
+  binding._setSIMDEnabled(true)
+
+  app.quit()
+})
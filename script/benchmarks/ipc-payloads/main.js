@@ -0,0 +1,54 @@
+// Measures the round trip of representative IPC payloads between the main
+// process and a renderer, which is dominated by V8ValueConverter on both
+// ends. Run with `node script/benchmark.js ipc-payloads --runs=5`.
+
+const { app, BrowserWindow, ipcMain } = require('electron')
+
+const { report } = require('../helpers')
+
+const iterations = 200
+
+// Each payload is built in the renderer so only the conversion and transport
+// are measured.
+const payloads = {
+  'small-object': `({ id: 1, name: 'item', enabled: true, ratio: 0.5 })`,
+  'number-array': `Array.from({ length: 10000 }, (_, i) => i * 1.5)`,
+  'string-array': `Array.from({ length: 10000 }, (_, i) => 'string ' + i)`,
+  'object-array': `Array.from({ length: 2000 }, (_, i) => ({ id: i, title: 'row ' + i, tags: ['a', 'b'], meta: { visible: i % 2 === 0 } }))`,
+  'nested-object': `(function make (depth) { return depth === 0 ? { leaf: true } : { left: make(depth - 1), right: make(depth - 1) } })(10)`,
+  'buffer-1mb': `new Uint8Array(1024 * 1024).fill(7)`
+}
+
+app.once('ready', () => {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: { nodeIntegration: true }
+  })
+
+  ipcMain.on('echo', (event, payload) => {
+    event.sender.send('echo-reply', payload)
+  })
+
+  w.webContents.once('did-finish-load', async () => {
+    for (const [name, source] of Object.entries(payloads)) {
+      const elapsed = await w.webContents.executeJavaScript(`new Promise(resolve => {
+        const { ipcRenderer } = require('electron')
+        const payload = ${source}
+        let remaining = ${iterations}
+        const start = performance.now()
+        ipcRenderer.on('echo-reply', function onReply () {
+          if (--remaining > 0) {
+            ipcRenderer.send('echo', payload)
+          } else {
+            ipcRenderer.removeListener('echo-reply', onReply)
+            resolve(performance.now() - start)
+          }
+        })
+        ipcRenderer.send('echo', payload)
+      })`)
+      report(`${name}-round-trip`, elapsed / iterations)
+    }
+    app.quit()
+  })
+  w.loadURL('data:text/html,<body></body>')
+})
@@ -0,0 +1,77 @@
+// Measures decode -> resize -> encode throughput over a set of images, with
+// the synchronous nativeImage APIs and with their thread pool variants. Run
+// with `node script/benchmark.js native-image --runs=5 -- --images=64`.
+
+const { app, nativeImage } = require('electron')
+
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+
+const { arg, report } = require('../helpers')
+
+const imageCount = parseInt(arg('images', '32'), 10)
+const imageSize = 1024
+
+function writeImages (dir) {
+  const files = []
+  for (let i = 0; i < imageCount; i++) {
+    const pixels = Buffer.alloc(imageSize * imageSize * 4)
+    for (let p = 0; p < pixels.length; p += 4) {
+      pixels[p] = (p / 4 + i) & 0xff
+      pixels[p + 1] = (p / 4 / imageSize) & 0xff
+      pixels[p + 2] = i & 0xff
+      pixels[p + 3] = 0xff
+    }
+    const image = nativeImage.createFromBitmap(pixels, { width: imageSize, height: imageSize })
+    const file = path.join(dir, `image-${i}.png`)
+    fs.writeFileSync(file, image.toPNG())
+    files.push(file)
+  }
+  return files
+}
+
+// Tracks the longest time the main thread was unable to run a timer.
+function watchStalls () {
+  let last = process.hrtime.bigint()
+  let longest = 0
+  const timer = setInterval(() => {
+    const now = process.hrtime.bigint()
+    longest = Math.max(longest, Number(now - last) / 1e6)
+    last = now
+  }, 1)
+  return () => {
+    clearInterval(timer)
+    return longest
+  }
+}
+
+async function measure (name, files, processOne) {
+  const stop = watchStalls()
+  const start = process.hrtime.bigint()
+  await Promise.all(files.map(processOne))
+  const elapsed = Number(process.hrtime.bigint() - start) / 1e6
+  report(`${name}-throughput`, files.length / (elapsed / 1000), 'images/s')
+  report(`${name}-longest-stall`, stop())
+}
+
+app.once('ready', async () => {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-native-image-'))
+  const files = writeImages(dir)
+  report('cores', os.cpus().length, '')
+
+  await measure('sync', files, async (file) => {
+    const image = nativeImage.createFromPath(file)
+    return image.resize({ width: 256 }).toPNG()
+  })
+
+  await measure('async', files, async (file) => {
+    const image = await nativeImage.createFromPathAsync(file)
+    const resized = await image.resizeAsync({ width: 256 })
+    return resized.toPNGAsync()
+  })
+
+  for (const file of files) fs.unlinkSync(file)
+  fs.rmdirSync(dir)
+  app.quit()
+})
@@ -0,0 +1,76 @@
+// Measures the frame rate and the main process CPU time per frame of encoding
+// an animated offscreen page, next to copying every frame out of its
+// NativeImage as apps feeding an encoder in JavaScript do. Run with
+// `node script/benchmark.js osr-encode --runs=5 -- --codec=vp9`.
+
+const { app, BrowserWindow } = require('electron')
+
+const { arg, report } = require('../helpers')
+
+const width = parseInt(arg('width', '1280'), 10)
+const height = parseInt(arg('height', '720'), 10)
+const duration = parseInt(arg('duration', '3000'), 10)
+const codec = arg('codec', 'vp8')
+
+const page = `<style>
+  body { margin: 0; background: #234; }
+  #box { width: 200px; height: 200px; background: #f80; margin: 100px;
+         animation: spin 1s linear infinite; }
+  @keyframes spin { to { transform: rotate(360deg); } }
+</style><div id="box"></div>`
+
+function cpuMs (since) {
+  const usage = process.cpuUsage(since)
+  return (usage.user + usage.system) / 1000
+}
+
+// |stop| returns, or resolves with, the number of frames handled.
+async function measure (name, start, stop) {
+  const cpu = process.cpuUsage()
+  const total = await new Promise(resolve => {
+    start()
+    setTimeout(() => resolve(stop()), duration)
+  })
+  report(`${name}-frames-per-second`, total / (duration / 1000), 'fps')
+  report(`${name}-cpu-per-frame`, cpuMs(cpu) / total, 'ms')
+}
+
+app.once('ready', async () => {
+  const w = new BrowserWindow({
+    width,
+    height,
+    show: false,
+    webPreferences: { offscreen: true, backgroundThrottling: false }
+  })
+  w.webContents.frameRate = 60
+  await w.loadURL(`data:text/html,${encodeURIComponent(page)}`)
+
+  // What apps do today: copy each frame and hand it to an encoder.
+  let copied = 0
+  const onPaint = (event, dirty, image) => {
+    image.toBitmap()
+    copied++
+  }
+  await measure('js-copy', () => {
+    w.webContents.on('paint', onPaint)
+  }, () => {
+    w.webContents.removeListener('paint', onPaint)
+    return copied
+  })
+
+  let packets = 0
+  const onPacket = () => { packets++ }
+  await measure(`${codec}-encode`, () => {
+    w.webContents.on('video-packet', onPacket)
+    w.webContents.startVideoEncoding({ codec })
+  }, async () => {
+    const stats = await w.webContents.stopVideoEncoding()
+    w.webContents.removeListener('video-packet', onPacket)
+    report(`${codec}-dropped-frames`, stats.droppedFrames, 'frames')
+    report(`${codec}-bytes-per-frame`, stats.bytes / stats.frames, 'B')
+    report(`${codec}-encode-time-per-frame`, stats.encodeTime / stats.frames, 'ms')
+    return stats.frames
+  })
+
+  app.quit()
+})
@@ -0,0 +1,46 @@
+// Measures how many bytes offscreen rendering copies per frame while a small
+// part of a large page is animated. Run with
+// `node script/benchmark.js osr-paint --runs=5 -- --width=3840 --height=2160`.
+
+const { app, BrowserWindow } = require('electron')
+
+const { arg, report } = require('../helpers')
+
+const width = parseInt(arg('width', '1920'), 10)
+const height = parseInt(arg('height', '1080'), 10)
+const duration = parseInt(arg('duration', '3000'), 10)
+
+const page = `<style>
+  body { margin: 0; background: linear-gradient(45deg, #345, #abc); }
+  #box { width: 64px; height: 64px; background: #f80; will-change: transform;
+         animation: spin 1s linear infinite; margin: 32px; }
+  @keyframes spin { to { transform: rotate(360deg); } }
+</style><div id="box"></div>`
+
+app.once('ready', async () => {
+  const w = new BrowserWindow({
+    width,
+    height,
+    show: false,
+    webPreferences: { offscreen: true, backgroundThrottling: false }
+  })
+  w.webContents.frameRate = 60
+  // Keep the frames referenced for a while, like a consumer doing some work
+  // with each of them.
+  let lastImage = null
+  w.webContents.on('paint', (event, dirty, image) => { lastImage = image })
+  w.webContents.on('destroyed', () => { lastImage = null })
+  await w.loadURL(`data:text/html,${encodeURIComponent(page)}`)
+
+  const before = w.webContents.getPaintStats()
+  await new Promise(resolve => setTimeout(resolve, duration))
+  const after = w.webContents.getPaintStats()
+
+  const frames = after.frames - before.frames
+  report('frames-per-second', frames / (duration / 1000), 'fps')
+  report('bytes-copied-per-frame', (after.bytesCopied - before.bytesCopied) / frames, 'B')
+  report('bytes-allocated-per-frame', (after.bytesAllocated - before.bytesAllocated) / frames, 'B')
+  report('full-frame-bytes', width * height * 4, 'B')
+
+  app.quit()
+})
@@ -0,0 +1,67 @@
+// Measures how many documents per second are rendered to PDF by a
+// PDFRenderPool, next to loading each document in a new BrowserWindow and
+// calling printToPDF one after the other. Run with
+// `node script/benchmark.js pdf-batch --runs=5 -- --documents=200`.
+
+const { app, BrowserWindow, webContents } = require('electron')
+
+const { arg, report } = require('../helpers')
+
+const documents = parseInt(arg('documents', '100'), 10)
+const size = arg('size') ? parseInt(arg('size'), 10) : undefined
+
+// A small invoice-like report, different for every document.
+function page (index) {
+  const rows = []
+  for (let i = 0; i < 50; i++) {
+    rows.push(`<tr><td>Item ${index}-${i}</td><td>${(index * 31 + i * 7) % 1000}</td></tr>`)
+  }
+  return `<h1>Report ${index}</h1><table>${rows.join('')}</table>`
+}
+
+function dataURL (html) {
+  return `data:text/html;charset=utf-8;base64,${Buffer.from(html).toString('base64')}`
+}
+
+async function serial () {
+  for (let i = 0; i < documents; i++) {
+    const w = new BrowserWindow({ show: false })
+    await w.loadURL(dataURL(page(i)))
+    await w.webContents.printToPDF({})
+    w.destroy()
+  }
+}
+
+async function pooled (timings) {
+  const pool = webContents.createPDFRenderPool({ size })
+  const jobs = []
+  for (let i = 0; i < documents; i++) {
+    jobs.push(pool.render({ html: page(i) }).then(({ timing }) => {
+      timings.push(timing)
+    }))
+  }
+  await Promise.all(jobs)
+  pool.close()
+  return pool.size
+}
+
+function average (timings, key) {
+  return timings.reduce((sum, timing) => sum + timing[key], 0) / timings.length
+}
+
+app.once('ready', async () => {
+  let start = Date.now()
+  await serial()
+  report('serial-documents-per-second', documents / ((Date.now() - start) / 1000), 'docs/s')
+
+  const timings = []
+  start = Date.now()
+  const poolSize = await pooled(timings)
+  report('pool-documents-per-second', documents / ((Date.now() - start) / 1000), 'docs/s')
+  report('pool-size', poolSize, 'renderers')
+  report('pool-load-time', average(timings, 'load'), 'ms')
+  report('pool-print-time', average(timings, 'print'), 'ms')
+  report('pool-queue-time', average(timings, 'queue'), 'ms')
+
+  app.quit()
+})
@@ -0,0 +1,76 @@
+// Measures what a UI action costs a renderer that uses the remote module:
+// reading the data properties of a main process object, calling its methods
+// and releasing the objects it was sent. Run with
+// `node script/benchmark.js remote-calls --runs=5 -- --iterations=1000`.
+
+const { app, BrowserWindow } = require('electron')
+
+const { arg, report } = require('../helpers')
+
+const iterations = parseInt(arg('iterations', '1000'), 10)
+
+// The object the renderer reads, shaped like the state of an editor.
+global.document = {
+  title: 'untitled',
+  path: '/tmp/untitled.txt',
+  modified: false,
+  lineCount: 120,
+  cursorLine: 12,
+  cursorColumn: 4,
+  selectionLength: 0,
+  encoding: 'utf8',
+  readOnly: false,
+  zoom: 1,
+  getRange (start, end) {
+    return { start, end }
+  }
+}
+Object.defineProperty(global.document, 'id', { value: 7, enumerable: true })
+
+const cases = {
+  // Ten data properties of the same object.
+  'read-properties': `() => {
+    const d = doc
+    return [d.title, d.path, d.modified, d.lineCount, d.cursorLine,
+      d.cursorColumn, d.selectionLength, d.encoding, d.readOnly, d.zoom]
+  }`,
+  // The same properties read with remote.getProperties().
+  'get-properties': `() => remote.getProperties(doc, ['title', 'path',
+    'modified', 'lineCount', 'cursorLine', 'cursorColumn', 'selectionLength',
+    'encoding', 'readOnly', 'zoom'])`,
+  'read-immutable-property': `() => doc.id`,
+  'call-method': `() => doc.getRange(1, 2)`,
+  'get-object': `() => remote.getGlobal('document')`
+}
+
+app.once('ready', async () => {
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: { nodeIntegration: true, enableRemoteModule: true }
+  })
+  await w.loadURL('data:text/html,<body></body>')
+
+  await w.webContents.executeJavaScript(`
+    var remote = require('electron').remote
+    var doc = remote.getGlobal('document')
+  `)
+  for (const [name, source] of Object.entries(cases)) {
+    // Every action ends its task, like an event handler would.
+    const elapsed = await w.webContents.executeJavaScript(`(async () => {
+      const run = ${source}
+      for (let i = 0; i < 10; i++) {
+        run()
+        await null
+      }
+      const start = performance.now()
+      for (let i = 0; i < ${iterations}; i++) {
+        run()
+        await null
+      }
+      return performance.now() - start
+    })()`)
+    report(`${name}-per-action`, elapsed / iterations)
+  }
+
+  app.quit()
+})
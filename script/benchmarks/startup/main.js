@@ -0,0 +1,28 @@
+// Measures how long it takes to get from process start to a ready app and
+// to a shown window. Run with `node script/benchmark.js startup --runs=20`.
+
+const { app, BrowserWindow } = require('electron')
+
+const { report } = require('../helpers')
+
+const uptimeMs = () => process.uptime() * 1000
+
+report('main-init', uptimeMs())
+report('code-cache', process.electronBinding('features').isCodeCacheEnabled() ? 1 : 0, '')
+
+app.once('ready', () => {
+  report('app-ready', uptimeMs())
+
+  const start = uptimeMs()
+  const w = new BrowserWindow({
+    show: false,
+    webPreferences: { nodeIntegration: true }
+  })
+  w.webContents.once('did-finish-load', async () => {
+    report('window-load', uptimeMs() - start)
+    const rendererUptime = await w.webContents.executeJavaScript('process.uptime() * 1000')
+    report('renderer-uptime', rendererUptime)
+    app.quit()
+  })
+  w.loadURL('data:text/html,<body></body>')
+})
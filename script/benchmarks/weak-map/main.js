@@ -0,0 +1,63 @@
+// Measures ID lookups in the weak maps that back TrackableObjects and
+// remote object caches, with 10k live objects. Run with
+// `node script/benchmark.js weak-map --runs=5`.
+
+const { app, BrowserWindow, webContents } = require('electron')
+
+const { report } = require('../helpers')
+
+const v8Util = process.electronBinding('v8_util')
+
+const liveObjects = 10000
+const lookups = 1000000
+
+// Returns the average time of |fn| in nanoseconds.
+function time (iterations, fn) {
+  const start = process.hrtime.bigint()
+  for (let i = 0; i < iterations; i++) fn(i)
+  return Number(process.hrtime.bigint() - start) / iterations
+}
+
+function benchmarkIDWeakMap () {
+  const map = v8Util.createIDWeakMap()
+  // Keep the objects alive so that nothing is collected while measuring.
+  const objects = []
+  let nextId = 0
+  for (let i = 0; i < liveObjects; i++) {
+    const object = { id: ++nextId }
+    objects.push(object)
+    map.set(object.id, object)
+  }
+
+  report('id-weak-map-get', time(lookups, i => map.get((i % liveObjects) + 1)), 'ns')
+  report('id-weak-map-has-missing', time(lookups, i => map.has(-i - 1)), 'ns')
+
+  // Replace the oldest object with a new one, like remote objects being
+  // released while new ones are created.
+  report('id-weak-map-churn', time(lookups / 10, () => {
+    const oldest = objects.shift()
+    map.remove(oldest.id)
+    const object = { id: ++nextId }
+    objects.push(object)
+    map.set(object.id, object)
+  }), 'ns')
+  report('id-weak-map-get-after-churn', time(lookups, i => map.get(objects[i % liveObjects].id)), 'ns')
+}
+
+function benchmarkTrackableObjects () {
+  const windows = []
+  for (let i = 0; i < 8; i++) windows.push(new BrowserWindow({ show: false }))
+  const ids = windows.map(w => w.webContents.id)
+
+  report('web-contents-from-id', time(lookups, i => webContents.fromId(ids[i % ids.length])), 'ns')
+  report('browser-window-from-id', time(lookups / 10, i => BrowserWindow.fromId(windows[i % windows.length].id)), 'ns')
+  report('get-all-web-contents', time(lookups / 10, () => webContents.getAllWebContents()), 'ns')
+
+  for (const w of windows) w.destroy()
+}
+
+app.once('ready', () => {
+  benchmarkIDWeakMap()
+  benchmarkTrackableObjects()
+  app.quit()
+})
@@ -0,0 +1,76 @@
+// Measures the cost webRequest listeners add to each request, most of which
+// is building the details objects passed to them. Run with
+// `node script/benchmark.js web-request --runs=5 -- --requests=2000`.
+
+const { app, BrowserWindow, session } = require('electron')
+
+const http = require('http')
+
+const { arg, report } = require('../helpers')
+
+const requests = parseInt(arg('requests', '1000'), 10)
+
+const events = [
+  'onBeforeRequest',
+  'onBeforeSendHeaders',
+  'onSendHeaders',
+  'onHeadersReceived',
+  'onResponseStarted',
+  'onCompleted'
+]
+
+// Listeners that pass the request through after touching every property of
+// the details, so lazily created values are created too.
+function listen (ses, counter) {
+  for (const event of events) {
+    ses.webRequest[event]((details, callback) => {
+      for (const key in details) counter.properties += details[key] ? 1 : 0
+      counter.details++
+      if (callback) callback({})
+    })
+  }
+}
+
+function unlisten (ses) {
+  for (const event of events) ses.webRequest[event](null)
+}
+
+// Fetches |requests| URLs one after the other from the page and returns the
+// average time of one request.
+async function run (w, url) {
+  return w.webContents.executeJavaScript(`(async () => {
+    const start = performance.now()
+    for (let i = 0; i < ${requests}; i++) {
+      await (await fetch('${url}?' + i, { headers: { 'X-Benchmark': String(i) } })).text()
+    }
+    return (performance.now() - start) / ${requests}
+  })()`)
+}
+
+app.once('ready', async () => {
+  const server = http.createServer((req, res) => {
+    res.setHeader('Content-Type', 'text/plain')
+    res.setHeader('Cache-Control', 'no-store')
+    res.end('ok')
+  })
+  await new Promise(resolve => server.listen(0, '127.0.0.1', resolve))
+  const url = `http://127.0.0.1:${server.address().port}/`
+
+  const ses = session.fromPartition('web-request-benchmark')
+  const w = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+  await w.loadURL(url)
+
+  const baseline = await run(w, url)
+  report('request', baseline)
+
+  const counter = { details: 0, properties: 0 }
+  listen(ses, counter)
+  const listened = await run(w, url)
+  unlisten(ses)
+  report('request-all-listened', listened)
+  report('listener-overhead-per-details', (listened - baseline) / events.length)
+  report('properties-per-details', counter.properties / counter.details, '')
+
+  server.close()
+  app.quit()
+})
@@ -865,10 +865,15 @@ void App::ChildProcessLaunched(int process_type, base::ProcessHandle handle) {
 #endif
   app_metrics_[pid] = std::make_unique<electron::ProcessMetric>(
       process_type, handle, std::move(metrics));
+  if (metrics_sampler_)
+    metrics_sampler_->AddProcess(process_type,
+                                 app_metrics_[pid]->process.Duplicate());
 }
 
 void App::ChildProcessDisconnected(base::ProcessId pid) {
   app_metrics_.erase(pid);
+  if (metrics_sampler_)
+    metrics_sampler_->RemoveProcess(pid);
 }
 
 base::FilePath App::GetAppPath() const {
@@ -1307,7 +1312,6 @@ std::vector<mate::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
     pid_dict.Set("creationTime",
                  process_metric.second->process.CreationTime().ToJsTime());
 
-#if !defined(OS_LINUX)
     auto memory_info = process_metric.second->GetMemoryInfo();
 
     mate::Dictionary memory_dict = mate::Dictionary::CreateEmpty(isolate);
@@ -1326,7 +1330,6 @@ std::vector<mate::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
 #endif
 
     pid_dict.Set("memory", memory_dict);
-#endif
 
 #if defined(OS_MACOSX)
     pid_dict.Set("sandboxed", process_metric.second->IsSandboxed());
@@ -1343,6 +1346,65 @@ std::vector<mate::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   return result;
 }
 
+void App::StartMetricsSampling(mate::Arguments* args) {
+  int interval = 1000;
+  int buffer_size = 60;
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("interval", &interval);
+    options.Get("bufferSize", &buffer_size);
+  }
+  if (interval < 100) {
+    args->ThrowError("interval must be at least 100 milliseconds");
+    return;
+  }
+  if (buffer_size < 1) {
+    args->ThrowError("bufferSize must be a positive number");
+    return;
+  }
+
+  metrics_sampler_ = std::make_unique<ProcessMetricsSampler>(
+      base::TimeDelta::FromMilliseconds(interval), buffer_size);
+  for (const auto& process_metric : app_metrics_) {
+    metrics_sampler_->AddProcess(process_metric.second->type,
+                                 process_metric.second->process.Duplicate());
+  }
+}
+
+void App::StopMetricsSampling() {
+  metrics_sampler_.reset();
+}
+
+v8::Local<v8::Promise> App::GetMetricsSamples(v8::Isolate* isolate) {
+  util::Promise<mate::Dictionary> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!metrics_sampler_) {
+    promise.RejectWithErrorMessage("Metrics sampling has not been started");
+    return handle;
+  }
+
+  metrics_sampler_->TakeSamples(base::BindOnce(
+      [](util::Promise<mate::Dictionary> promise, std::vector<double> samples) {
+        v8::Isolate* isolate = promise.isolate();
+        v8::HandleScope handle_scope(isolate);
+        v8::Context::Scope context_scope(promise.GetContext());
+
+        size_t byte_length = samples.size() * sizeof(double);
+        auto array_buffer = v8::ArrayBuffer::New(isolate, byte_length);
+        if (byte_length > 0)
+          memcpy(array_buffer->GetContents().Data(), samples.data(),
+                 byte_length);
+
+        mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+        dict.Set("fields", ProcessMetricsSampler::GetFieldNames());
+        dict.Set("samples", v8::Local<v8::Value>(v8::Float64Array::New(
+                                array_buffer, 0, samples.size())));
+        promise.Resolve(dict);
+      },
+      std::move(promise)));
+  return handle;
+}
+
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   auto status = content::GetFeatureStatus();
   base::DictionaryValue temp;
@@ -1596,6 +1658,9 @@ void App::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("localServe", &App::LocalServe)
       .SetMethod("_loadServer", &App::LoadInProcServer)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("startMetricsSampling", &App::StartMetricsSampling)
+      .SetMethod("stopMetricsSampling", &App::StopMetricsSampling)
+      .SetMethod("getMetricsSamples", &App::GetMetricsSamples)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
 #if defined(MAS_BUILD)
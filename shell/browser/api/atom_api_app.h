@@ -24,6 +24,7 @@
 #include "net/ssl/client_cert_identity.h"
 #include "shell/browser/api/event_emitter.h"
 #include "shell/browser/api/process_metric.h"
+#include "shell/browser/api/process_metrics_sampler.h"
 #include "shell/browser/atom_browser_client.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/browser_observer.h"
@@ -199,6 +200,9 @@ class App : public AtomBrowserClient::Delegate,
   v8::Local<v8::Promise> LoadInProcServer(const std::string& path);
 
   std::vector<mate::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  void StartMetricsSampling(mate::Arguments* args);
+  void StopMetricsSampling();
+  v8::Local<v8::Promise> GetMetricsSamples(v8::Isolate* isolate);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -245,6 +249,9 @@ class App : public AtomBrowserClient::Delegate,
                          std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  // Samples the processes in |app_metrics_| while metrics sampling is on.
+  std::unique_ptr<ProcessMetricsSampler> metrics_sampler_;
+
   DISALLOW_COPY_AND_ASSIGN(App);
 };
 
@@ -5,6 +5,7 @@
 #include "shell/browser/api/atom_api_desktop_capturer.h"
 
 #include <memory>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -58,6 +59,20 @@ namespace electron {
 
 namespace api {
 
+namespace {
+
+#if defined(OS_WIN)
+std::string DisplayIdFromDeviceName(const std::string& device_name) {
+  std::wstring wide_device_name;
+  base::UTF8ToWide(device_name.c_str(), device_name.size(), &wide_device_name);
+  const int64_t device_id = display::win::DisplayInfo::DeviceIdFromDeviceName(
+      wide_device_name.c_str());
+  return base::NumberToString(device_id);
+}
+#endif  // defined(OS_WIN)
+
+}  // namespace
+
 DesktopCapturer::DesktopCapturer(v8::Isolate* isolate) {
   Init(isolate);
 }
@@ -68,6 +83,24 @@ void DesktopCapturer::StartHandling(bool capture_window,
                                     bool capture_screen,
                                     const gfx::Size& thumbnail_size,
                                     bool fetch_window_icons) {
+  Start(capture_window, capture_screen, {thumbnail_size}, fetch_window_icons,
+        false);
+}
+
+void DesktopCapturer::StartStreaming(
+    bool capture_window,
+    bool capture_screen,
+    const std::vector<gfx::Size>& thumbnail_sizes,
+    bool fetch_window_icons) {
+  Start(capture_window, capture_screen, thumbnail_sizes, fetch_window_icons,
+        true);
+}
+
+void DesktopCapturer::Start(bool capture_window,
+                            bool capture_screen,
+                            const std::vector<gfx::Size>& thumbnail_sizes,
+                            bool fetch_window_icons,
+                            bool streaming) {
   fetch_window_icons_ = fetch_window_icons;
 #if defined(OS_WIN)
   if (content::desktop_capture::CreateDesktopCaptureOptions()
@@ -81,35 +114,83 @@ void DesktopCapturer::StartHandling(bool capture_window,
 
   // clear any existing captured sources.
   captured_sources_.clear();
+  emitted_sources_.clear();
 
-  // Start listening for captured sources.
   capture_window_ = capture_window;
   capture_screen_ = capture_screen;
+  streaming_ = streaming;
+  thumbnail_sizes_ = thumbnail_sizes;
+  if (thumbnail_sizes_.empty())
+    thumbnail_sizes_.emplace_back();
+  pass_ = 0;
+
+  // Release the capturers this call does not need.
+  std::set<ListKey> used_lists;
+  for (const auto& size : thumbnail_sizes_) {
+    if (capture_window)
+      used_lists.emplace(content::DesktopMediaID::TYPE_WINDOW, size.width(),
+                         size.height());
+    if (capture_screen)
+      used_lists.emplace(content::DesktopMediaID::TYPE_SCREEN, size.width(),
+                         size.height());
+  }
+  for (auto it = lists_.begin(); it != lists_.end();) {
+    if (used_lists.count(it->first))
+      ++it;
+    else
+      it = lists_.erase(it);
+  }
 
-  {
-    // Initialize the source list.
-    // Apply the new thumbnail size and restart capture.
-    if (capture_window) {
-      window_capturer_ = std::make_unique<NativeDesktopMediaList>(
-          content::DesktopMediaID::TYPE_WINDOW,
-          content::desktop_capture::CreateWindowCapturer());
-      window_capturer_->SetThumbnailSize(thumbnail_size);
-      window_capturer_->AddObserver(this);
-      window_capturer_->StartUpdating();
-    }
+  StartPass();
+}
 
-    if (capture_screen) {
-      screen_capturer_ = std::make_unique<NativeDesktopMediaList>(
-          content::DesktopMediaID::TYPE_SCREEN,
-          content::desktop_capture::CreateScreenCapturer());
-      screen_capturer_->SetThumbnailSize(thumbnail_size);
-      screen_capturer_->AddObserver(this);
-      screen_capturer_->StartUpdating();
-    }
+void DesktopCapturer::ReleaseLists() {
+  pending_lists_.clear();
+  lists_.clear();
+}
+
+DesktopMediaList* DesktopCapturer::GetOrCreateList(
+    content::DesktopMediaID::Type type,
+    const gfx::Size& thumbnail_size) {
+  auto& list =
+      lists_[ListKey(type, thumbnail_size.width(), thumbnail_size.height())];
+  if (!list) {
+    list = std::make_unique<NativeDesktopMediaList>(
+        type, type == content::DesktopMediaID::TYPE_WINDOW
+                  ? content::desktop_capture::CreateWindowCapturer()
+                  : content::desktop_capture::CreateScreenCapturer());
+    list->SetThumbnailSize(thumbnail_size);
+    list->AddObserver(this);
+  }
+  return list.get();
+}
+
+void DesktopCapturer::StartPass() {
+  emitted_thumbnails_.clear();
+  const gfx::Size& thumbnail_size = thumbnail_sizes_[pass_];
+  std::vector<DesktopMediaList*> lists;
+  if (capture_window_) {
+    lists.push_back(GetOrCreateList(content::DesktopMediaID::TYPE_WINDOW,
+                                    thumbnail_size));
   }
+  if (capture_screen_) {
+    lists.push_back(GetOrCreateList(content::DesktopMediaID::TYPE_SCREEN,
+                                    thumbnail_size));
+  }
+  if (lists.empty()) {
+    Emit("finished", captured_sources_, fetch_window_icons_);
+    return;
+  }
+
+  pending_lists_.insert(lists.begin(), lists.end());
+  for (auto* list : lists)
+    list->StartUpdating();
 }
 
-void DesktopCapturer::OnSourceAdded(DesktopMediaList* list, int index) {}
+void DesktopCapturer::OnSourceAdded(DesktopMediaList* list, int index) {
+  if (streaming_ && pending_lists_.count(list))
+    EmitSource(list, index);
+}
 
 void DesktopCapturer::OnSourceRemoved(DesktopMediaList* list, int index) {}
 
@@ -120,7 +201,10 @@ void DesktopCapturer::OnSourceMoved(DesktopMediaList* list,
 void DesktopCapturer::OnSourceNameChanged(DesktopMediaList* list, int index) {}
 
 void DesktopCapturer::OnSourceThumbnailChanged(DesktopMediaList* list,
-                                               int index) {}
+                                               int index) {
+  if (streaming_ && pending_lists_.count(list))
+    EmitThumbnail(list, index);
+}
 
 void DesktopCapturer::OnSourceUnchanged(DesktopMediaList* list) {
   UpdateSourcesList(list);
@@ -132,74 +216,139 @@ bool DesktopCapturer::ShouldScheduleNextRefresh(DesktopMediaList* list) {
 }
 
 void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
-  if (capture_window_ &&
-      list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW) {
-    capture_window_ = false;
-    const auto& media_list_sources = list->GetSources();
-    std::vector<DesktopCapturer::Source> window_sources;
-    window_sources.reserve(media_list_sources.size());
-    for (const auto& media_list_source : media_list_sources) {
-      window_sources.emplace_back(DesktopCapturer::Source{
-          media_list_source, std::string(), fetch_window_icons_});
+  if (!pending_lists_.erase(list))
+    return;
+
+  if (streaming_) {
+    // A reused list only notifies about sources and frames that changed since
+    // its previous refresh, report the others now.
+    for (int i = 0; i < list->GetSourceCount(); ++i) {
+      EmitSource(list, i);
+      EmitThumbnail(list, i);
     }
-    std::move(window_sources.begin(), window_sources.end(),
-              std::back_inserter(captured_sources_));
-    window_capturer_.reset();
   }
 
+  if (!pending_lists_.empty())
+    return;
+
+  if (pass_ + 1 < thumbnail_sizes_.size()) {
+    ++pass_;
+    StartPass();
+    return;
+  }
+
+  const gfx::Size& thumbnail_size = thumbnail_sizes_[pass_];
+  if (capture_window_) {
+    GetSources(GetOrCreateList(content::DesktopMediaID::TYPE_WINDOW,
+                               thumbnail_size),
+               &captured_sources_);
+  }
   if (capture_screen_ &&
-      list->GetMediaListType() == content::DesktopMediaID::TYPE_SCREEN) {
-    capture_screen_ = false;
-    const auto& media_list_sources = list->GetSources();
-    std::vector<DesktopCapturer::Source> screen_sources;
-    screen_sources.reserve(media_list_sources.size());
+      !GetSources(GetOrCreateList(content::DesktopMediaID::TYPE_SCREEN,
+                                  thumbnail_size),
+                  &captured_sources_)) {
+    Emit("error", "Failed to get sources.");
+    return;
+  }
+
+  Emit("finished", captured_sources_, fetch_window_icons_);
+}
+
+bool DesktopCapturer::GetSources(
+    DesktopMediaList* list,
+    std::vector<DesktopCapturer::Source>* sources) {
+  const auto& media_list_sources = list->GetSources();
+  if (list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW) {
     for (const auto& media_list_source : media_list_sources) {
-      screen_sources.emplace_back(
-          DesktopCapturer::Source{media_list_source, std::string()});
+      sources->emplace_back(DesktopCapturer::Source{
+          media_list_source, std::string(), fetch_window_icons_});
     }
+    return true;
+  }
+
+  std::vector<DesktopCapturer::Source> screen_sources;
+  screen_sources.reserve(media_list_sources.size());
+  for (const auto& media_list_source : media_list_sources) {
+    screen_sources.emplace_back(
+        DesktopCapturer::Source{media_list_source, std::string()});
+  }
 #if defined(OS_WIN)
-    // Gather the same unique screen IDs used by the electron.screen API in
-    // order to provide an association between it and
-    // desktopCapturer/getUserMedia. This is only required when using the
-    // DirectX capturer, otherwise the IDs across the APIs already match.
-    if (using_directx_capturer_) {
-      std::vector<std::string> device_names;
-      // Crucially, this list of device names will be in the same order as
-      // |media_list_sources|.
-      if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
-              &device_names)) {
-        Emit("error", "Failed to get sources.");
-        return;
-      }
-
-      int device_name_index = 0;
-      for (auto& source : screen_sources) {
-        const auto& device_name = device_names[device_name_index++];
-        std::wstring wide_device_name;
-        base::UTF8ToWide(device_name.c_str(), device_name.size(),
-                         &wide_device_name);
-        const int64_t device_id =
-            display::win::DisplayInfo::DeviceIdFromDeviceName(
-                wide_device_name.c_str());
-        source.display_id = base::NumberToString(device_id);
-      }
+  // Gather the same unique screen IDs used by the electron.screen API in
+  // order to provide an association between it and
+  // desktopCapturer/getUserMedia. This is only required when using the
+  // DirectX capturer, otherwise the IDs across the APIs already match.
+  if (using_directx_capturer_) {
+    std::vector<std::string> device_names;
+    // Crucially, this list of device names will be in the same order as
+    // |media_list_sources|.
+    if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
+            &device_names)) {
+      return false;
     }
-#elif defined(OS_MACOSX)
-    // On Mac, the IDs across the APIs match.
+
+    int device_name_index = 0;
     for (auto& source : screen_sources) {
-      source.display_id = base::NumberToString(source.media_list_source.id.id);
+      source.display_id =
+          DisplayIdFromDeviceName(device_names[device_name_index++]);
     }
+  }
+#elif defined(OS_MACOSX)
+  // On Mac, the IDs across the APIs match.
+  for (auto& source : screen_sources) {
+    source.display_id = base::NumberToString(source.media_list_source.id.id);
+  }
 #endif  // defined(OS_WIN)
-    // TODO(ajmacd): Add Linux support. The IDs across APIs differ but Chrome
-    // only supports capturing the entire desktop on Linux. Revisit this if
-    // individual screen support is added.
-    std::move(screen_sources.begin(), screen_sources.end(),
-              std::back_inserter(captured_sources_));
-    screen_capturer_.reset();
+  // TODO(ajmacd): Add Linux support. The IDs across APIs differ but Chrome
+  // only supports capturing the entire desktop on Linux. Revisit this if
+  // individual screen support is added.
+  std::move(screen_sources.begin(), screen_sources.end(),
+            std::back_inserter(*sources));
+  return true;
+}
+
+std::string DesktopCapturer::GetDisplayId(DesktopMediaList* list, int index) {
+  if (list->GetMediaListType() != content::DesktopMediaID::TYPE_SCREEN)
+    return std::string();
+#if defined(OS_WIN)
+  if (using_directx_capturer_) {
+    std::vector<std::string> device_names;
+    if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
+            &device_names) ||
+        static_cast<size_t>(index) >= device_names.size()) {
+      return std::string();
+    }
+    return DisplayIdFromDeviceName(device_names[index]);
   }
+  return std::string();
+#elif defined(OS_MACOSX)
+  return base::NumberToString(list->GetSource(index).id.id);
+#else
+  return std::string();
+#endif  // defined(OS_WIN)
+}
 
-  if (!capture_window_ && !capture_screen_)
-    Emit("finished", captured_sources_, fetch_window_icons_);
+void DesktopCapturer::EmitSource(DesktopMediaList* list, int index) {
+  const DesktopMediaList::Source& media_list_source = list->GetSource(index);
+  if (!emitted_sources_.insert(media_list_source.id.ToString()).second)
+    return;
+  bool fetch_icon =
+      fetch_window_icons_ &&
+      list->GetMediaListType() == content::DesktopMediaID::TYPE_WINDOW;
+  Emit("source", DesktopCapturer::Source{media_list_source,
+                                         GetDisplayId(list, index),
+                                         fetch_icon});
+}
+
+void DesktopCapturer::EmitThumbnail(DesktopMediaList* list, int index) {
+  const DesktopMediaList::Source& media_list_source = list->GetSource(index);
+  if (media_list_source.thumbnail.isNull())
+    return;
+  std::string id = media_list_source.id.ToString();
+  if (!emitted_thumbnails_.insert(id).second)
+    return;
+  Emit("thumbnail", id,
+       NativeImage::Create(isolate(), gfx::Image(media_list_source.thumbnail)),
+       static_cast<int>(pass_));
 }
 
 // static
@@ -213,7 +362,9 @@ void DesktopCapturer::BuildPrototype(
     v8::Local<v8::FunctionTemplate> prototype) {
   prototype->SetClassName(mate::StringToV8(isolate, "DesktopCapturer"));
   mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
-      .SetMethod("startHandling", &DesktopCapturer::StartHandling);
+      .SetMethod("startHandling", &DesktopCapturer::StartHandling)
+      .SetMethod("startStreaming", &DesktopCapturer::StartStreaming)
+      .SetMethod("releaseLists", &DesktopCapturer::ReleaseLists);
 }
 
 }  // namespace api
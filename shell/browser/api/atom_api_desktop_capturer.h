@@ -5,8 +5,11 @@
 #ifndef SHELL_BROWSER_API_ATOM_API_DESKTOP_CAPTURER_H_
 #define SHELL_BROWSER_API_ATOM_API_DESKTOP_CAPTURER_H_
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "chrome/browser/media/webrtc/desktop_media_list_observer.h"
@@ -40,6 +43,17 @@ class DesktopCapturer : public mate::TrackableObject<DesktopCapturer>,
                      const gfx::Size& thumbnail_size,
                      bool fetch_window_icons);
 
+  // Like StartHandling, but emits "source" as soon as each source is
+  // enumerated and "thumbnail" as each thumbnail is captured, once for every
+  // size in |thumbnail_sizes|, smallest first.
+  void StartStreaming(bool capture_window,
+                      bool capture_screen,
+                      const std::vector<gfx::Size>& thumbnail_sizes,
+                      bool fetch_window_icons);
+
+  // Destroys the media lists kept from previous calls, and their capturers.
+  void ReleaseLists();
+
  protected:
   explicit DesktopCapturer(v8::Isolate* isolate);
   ~DesktopCapturer() override;
@@ -56,14 +70,40 @@ class DesktopCapturer : public mate::TrackableObject<DesktopCapturer>,
   bool ShouldScheduleNextRefresh(DesktopMediaList* list) override;
 
  private:
+  // Media lists are kept per type and thumbnail size between calls, which
+  // reuses their capturers and lets them skip scaling unchanged frames.
+  using ListKey = std::tuple<content::DesktopMediaID::Type, int, int>;
+
+  void Start(bool capture_window,
+             bool capture_screen,
+             const std::vector<gfx::Size>& thumbnail_sizes,
+             bool fetch_window_icons,
+             bool streaming);
+  DesktopMediaList* GetOrCreateList(content::DesktopMediaID::Type type,
+                                    const gfx::Size& thumbnail_size);
+  // Starts a refresh of the lists for the current thumbnail size.
+  void StartPass();
   void UpdateSourcesList(DesktopMediaList* list);
-
-  std::unique_ptr<DesktopMediaList> window_capturer_;
-  std::unique_ptr<DesktopMediaList> screen_capturer_;
+  bool GetSources(DesktopMediaList* list,
+                  std::vector<DesktopCapturer::Source>* sources);
+  std::string GetDisplayId(DesktopMediaList* list, int index);
+  void EmitSource(DesktopMediaList* list, int index);
+  void EmitThumbnail(DesktopMediaList* list, int index);
+
+  std::map<ListKey, std::unique_ptr<DesktopMediaList>> lists_;
+  // Lists of the current pass which have not finished refreshing.
+  std::set<DesktopMediaList*> pending_lists_;
+  std::vector<gfx::Size> thumbnail_sizes_;
+  size_t pass_ = 0;
+  // Ids of the sources reported to JavaScript by a streaming capture, and of
+  // the ones whose thumbnail was reported in the current pass.
+  std::set<std::string> emitted_sources_;
+  std::set<std::string> emitted_thumbnails_;
   std::vector<DesktopCapturer::Source> captured_sources_;
   bool capture_window_ = false;
   bool capture_screen_ = false;
   bool fetch_window_icons_ = false;
+  bool streaming_ = false;
 #if defined(OS_WIN)
   bool using_directx_capturer_ = false;
 #endif  // defined(OS_WIN)
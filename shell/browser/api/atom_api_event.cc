@@ -17,6 +17,14 @@ v8::Local<v8::Object> CreateEmpty(v8::Isolate* isolate) {
   return mate::internal::CreateEmptyJSEvent(isolate);
 }
 
+v8::Local<v8::Value> GetEmitStats(v8::Isolate* isolate) {
+  mate::internal::EmitStats stats = mate::internal::GetEmitStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("emits", static_cast<double>(stats.emits));
+  dict.Set("skipped", static_cast<double>(stats.skipped));
+  return dict.GetHandle();
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -24,6 +32,8 @@ void Initialize(v8::Local<v8::Object> exports,
   mate::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("createWithSender", &CreateWithSender);
   dict.SetMethod("createEmpty", &CreateEmpty);
+  dict.SetMethod("setDefaultEmit", &mate::internal::SetDefaultEmit);
+  dict.SetMethod("getEmitStats", &GetEmitStats);
 }
 
 }  // namespace
@@ -0,0 +1,452 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/atom_api_pdf_render_pool.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/stl_util.h"
+#include "base/system/sys_info.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/timer/timer.h"
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "electron/buildflags/buildflags.h"
+#include "native_mate/dictionary.h"
+#include "native_mate/object_template_builder.h"
+#include "net/base/net_errors.h"
+#include "shell/browser/api/atom_api_web_contents.h"
+#include "shell/browser/browser.h"
+#include "shell/common/api/locker.h"
+#include "shell/common/native_mate_converters/file_path_converter.h"
+#include "shell/common/native_mate_converters/gurl_converter.h"
+#include "shell/common/native_mate_converters/value_converter.h"
+#include "url/url_constants.h"
+
+namespace electron {
+
+namespace api {
+
+namespace {
+
+// Replacing a renderer costs a process launch, keeping one forever lets
+// whatever the documents leak pile up.
+const int kDefaultMaxJobsPerRenderer = 50;
+
+const base::TimeDelta kDefaultTimeout = base::TimeDelta::FromSeconds(30);
+
+}  // namespace
+
+struct PDFRenderPool::Job {
+  explicit Job(util::Promise<v8::Local<v8::Value>> promise)
+      : promise(std::move(promise)) {}
+
+  GURL url;
+  std::unique_ptr<base::DictionaryValue> settings;
+  PrintPreviewMessageHandler::Output output;
+  base::FilePath path;
+  util::Promise<v8::Local<v8::Value>> promise;
+
+  base::TimeTicks queued;
+  base::TimeTicks started;
+  base::TimeTicks loaded;
+  base::TimeTicks printed;
+};
+
+// A hidden WebContents that loads and prints one job at a time.
+class PDFRenderPool::Renderer : public content::WebContentsObserver {
+ public:
+  using DoneCallback =
+      base::RepeatingCallback<void(Renderer* renderer,
+                                   std::unique_ptr<Job> job,
+                                   const std::string& error,
+                                   scoped_refptr<base::RefCountedMemory>)>;
+
+  Renderer(v8::Isolate* isolate,
+           v8::Local<v8::Object> options,
+           base::TimeDelta timeout,
+           const DoneCallback& done)
+      : isolate_(isolate),
+        timeout_(timeout),
+        done_(done),
+        weak_factory_(this) {
+    mate::Handle<WebContents> web_contents =
+        WebContents::Create(isolate, mate::Dictionary(isolate, options));
+    wrapper_.Reset(isolate, web_contents.ToV8());
+    api_web_contents_ = web_contents->GetWeakPtr();
+    Observe(web_contents->web_contents());
+#if BUILDFLAG(ENABLE_OSR)
+    // Printing does not need the frames of the page.
+    if (web_contents->IsOffScreen())
+      web_contents->StopPainting();
+#endif
+  }
+
+  ~Renderer() override {
+    Observe(nullptr);
+    if (api_web_contents_)
+      api_web_contents_->DestroyWebContents(
+          !Browser::Get()->is_shutting_down());
+  }
+
+  bool busy() const { return !!job_; }
+  // Whether the renderer should be replaced instead of taking more jobs.
+  bool broken() const { return broken_ || !api_web_contents_; }
+  int jobs() const { return jobs_; }
+
+  void Start(std::unique_ptr<Job> job) {
+    DCHECK(!job_);
+    job_ = std::move(job);
+    job_->started = base::TimeTicks::Now();
+    ++jobs_;
+    load_error_.clear();
+    loading_ = true;
+    if (!timeout_.is_zero()) {
+      timer_.Start(FROM_HERE, timeout_,
+                   base::BindOnce(&Renderer::OnTimeout,
+                                  base::Unretained(this)));
+    }
+
+    v8::HandleScope handle_scope(isolate_);
+    api_web_contents_->LoadURL(job_->url,
+                               mate::Dictionary::CreateEmpty(isolate_));
+  }
+
+  // Fails the current job with |error|.
+  void Cancel(const std::string& error) {
+    broken_ = true;
+    if (job_)
+      Finish(error, nullptr);
+  }
+
+ private:
+  // content::WebContentsObserver:
+  void DidFinishNavigation(content::NavigationHandle* handle) override {
+    if (!job_ || !handle->IsInMainFrame() || handle->IsSameDocument())
+      return;
+    // A navigation replaced by another one, like a redirect done by the page
+    // itself, is not an error.
+    int error = handle->GetNetErrorCode();
+    if (error != net::OK && error != net::ERR_ABORTED)
+      load_error_ = net::ErrorToShortString(error);
+  }
+
+  void DidStopLoading() override {
+    if (!job_ || !loading_)
+      return;
+    loading_ = false;
+    if (!load_error_.empty()) {
+      Finish("Failed to load " + job_->url.possibly_invalid_spec() + ": " +
+                 load_error_,
+             nullptr);
+      return;
+    }
+
+    job_->loaded = base::TimeTicks::Now();
+    PrintPreviewMessageHandler::FromWebContents(web_contents())
+        ->PrintToPDF(*job_->settings,
+                     base::BindOnce(&Renderer::OnPrinted,
+                                    weak_factory_.GetWeakPtr()));
+  }
+
+  void RenderProcessGone(base::TerminationStatus status) override {
+    Cancel("The renderer process is gone");
+  }
+
+  void WebContentsDestroyed() override {
+    Cancel("The WebContents was destroyed");
+  }
+
+  void OnPrinted(const std::string& error,
+                 scoped_refptr<base::RefCountedMemory> data) {
+    if (!job_)
+      return;
+    job_->printed = base::TimeTicks::Now();
+    Finish(error, std::move(data));
+  }
+
+  void OnTimeout() { Cancel("Timed out rendering PDF"); }
+
+  void Finish(const std::string& error,
+              scoped_refptr<base::RefCountedMemory> data) {
+    timer_.Stop();
+    loading_ = false;
+    done_.Run(this, std::move(job_), error, std::move(data));
+  }
+
+  v8::Isolate* isolate_;
+  const base::TimeDelta timeout_;
+  DoneCallback done_;
+
+  // Keeps the JavaScript wrapper, and with it the WebContents, alive.
+  v8::Global<v8::Value> wrapper_;
+  base::WeakPtr<WebContents> api_web_contents_;
+
+  std::unique_ptr<Job> job_;
+  bool loading_ = false;
+  std::string load_error_;
+  base::OneShotTimer timer_;
+  int jobs_ = 0;
+  bool broken_ = false;
+
+  base::WeakPtrFactory<Renderer> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(Renderer);
+};
+
+PDFRenderPool::PDFRenderPool(v8::Isolate* isolate,
+                             const mate::Dictionary& options)
+    : size_(base::SysInfo::NumberOfProcessors()),
+      max_jobs_per_renderer_(kDefaultMaxJobsPerRenderer),
+      timeout_(kDefaultTimeout),
+      weak_factory_(this) {
+  int size = 0;
+  if (options.Get("size", &size) && size > 0)
+    size_ = size;
+  int max_jobs = 0;
+  if (options.Get("maxJobsPerRenderer", &max_jobs) && max_jobs > 0)
+    max_jobs_per_renderer_ = max_jobs;
+  double timeout = 0;
+  if (options.Get("timeout", &timeout) && timeout >= 0)
+    timeout_ = base::TimeDelta::FromMillisecondsD(timeout);
+
+  mate::Dictionary web_contents_options;
+  if (!options.Get("webContentsOptions", &web_contents_options))
+    web_contents_options = mate::Dictionary::CreateEmpty(isolate);
+  web_contents_options_.Reset(isolate, web_contents_options.GetHandle());
+
+  Init(isolate);
+}
+
+PDFRenderPool::~PDFRenderPool() = default;
+
+v8::Local<v8::Promise> PDFRenderPool::Render(
+    const GURL& url,
+    const base::DictionaryValue& settings,
+    PrintPreviewMessageHandler::Output output,
+    const base::FilePath& path) {
+  util::Promise<v8::Local<v8::Value>> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (closed_) {
+    promise.RejectWithErrorMessage("The PDF render pool is closed");
+    return handle;
+  }
+  // WebContents::LoadURL fails these without ever finishing the load.
+  if (!url.is_valid()) {
+    promise.RejectWithErrorMessage("Invalid URL");
+    return handle;
+  }
+  if (url.possibly_invalid_spec().size() > url::kMaxURLChars) {
+    promise.RejectWithErrorMessage(
+        "URL is longer than the maximum of " +
+        std::to_string(url::kMaxURLChars) + " characters");
+    return handle;
+  }
+
+  auto job = std::make_unique<Job>(std::move(promise));
+  job->url = url;
+  job->settings = settings.CreateDeepCopy();
+  job->output = output;
+  job->path = path;
+  job->queued = base::TimeTicks::Now();
+  queue_.push_back(std::move(job));
+  Pin();
+  ScheduleDispatch();
+  return handle;
+}
+
+void PDFRenderPool::Close() {
+  if (closed_)
+    return;
+  closed_ = true;
+
+  base::circular_deque<std::unique_ptr<Job>> queue;
+  queue.swap(queue_);
+  for (auto& job : queue)
+    job->promise.RejectWithErrorMessage("The PDF render pool is closed");
+
+  std::vector<std::unique_ptr<Renderer>> renderers;
+  renderers.swap(renderers_);
+  for (auto& renderer : renderers) {
+    renderer->Cancel("The PDF render pool is closed");
+    base::ThreadTaskRunnerHandle::Get()->DeleteSoon(FROM_HERE,
+                                                    std::move(renderer));
+  }
+  Unpin();
+}
+
+int PDFRenderPool::GetSize() const {
+  return size_;
+}
+
+int PDFRenderPool::GetPendingJobCount() const {
+  int count = queue_.size();
+  for (const auto& renderer : renderers_) {
+    if (renderer->busy())
+      ++count;
+  }
+  return count;
+}
+
+bool PDFRenderPool::IsClosed() const {
+  return closed_;
+}
+
+void PDFRenderPool::ScheduleDispatch() {
+  if (dispatch_scheduled_)
+    return;
+  dispatch_scheduled_ = true;
+  base::ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&PDFRenderPool::DispatchJobs,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void PDFRenderPool::DispatchJobs() {
+  dispatch_scheduled_ = false;
+  if (closed_)
+    return;
+
+  base::EraseIf(renderers_, [](const std::unique_ptr<Renderer>& renderer) {
+    return !renderer->busy() && renderer->broken();
+  });
+
+  if (queue_.empty()) {
+    // Runs in its own task, so the pool can safely be collected from here on.
+    if (GetPendingJobCount() == 0)
+      Unpin();
+    return;
+  }
+
+  for (auto& renderer : renderers_) {
+    if (queue_.empty())
+      return;
+    if (renderer->busy())
+      continue;
+    std::unique_ptr<Job> job = std::move(queue_.front());
+    queue_.pop_front();
+    renderer->Start(std::move(job));
+  }
+
+  if (queue_.empty() || renderers_.size() >= size_)
+    return;
+
+  // Creating a WebContents runs its JavaScript constructor.
+  mate::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  v8::Context::Scope context_scope(GetWrapper()->CreationContext());
+  while (!queue_.empty() && renderers_.size() < size_) {
+    renderers_.push_back(std::make_unique<Renderer>(
+        isolate(), web_contents_options_.Get(isolate()), timeout_,
+        base::BindRepeating(&PDFRenderPool::OnJobDone,
+                            weak_factory_.GetWeakPtr())));
+    std::unique_ptr<Job> job = std::move(queue_.front());
+    queue_.pop_front();
+    renderers_.back()->Start(std::move(job));
+  }
+}
+
+void PDFRenderPool::OnJobDone(Renderer* renderer,
+                              std::unique_ptr<Job> job,
+                              const std::string& error,
+                              scoped_refptr<base::RefCountedMemory> data) {
+  // This runs from within the renderer, which is only deleted, or given the
+  // next job, once it has returned.
+  if (!closed_) {
+    if (renderer->broken() || renderer->jobs() >= max_jobs_per_renderer_)
+      RetireRenderer(renderer);
+    ScheduleDispatch();
+  }
+
+  if (!error.empty()) {
+    job->promise.RejectWithErrorMessage(error);
+    return;
+  }
+  if (job->output == PrintPreviewMessageHandler::Output::kFile) {
+    base::FilePath path = job->path;
+    PrintPreviewMessageHandler::WritePdf(
+        path, std::move(data),
+        base::BindOnce(&PDFRenderPool::ResolveJob, std::move(job),
+                       scoped_refptr<base::RefCountedMemory>()));
+    return;
+  }
+  ResolveJob(std::move(job), std::move(data), true);
+}
+
+// static
+void PDFRenderPool::ResolveJob(std::unique_ptr<Job> job,
+                               scoped_refptr<base::RefCountedMemory> data,
+                               bool written) {
+  if (!written) {
+    job->promise.RejectWithErrorMessage("Failed to write PDF to " +
+                                        job->path.AsUTF8Unsafe());
+    return;
+  }
+
+  v8::Isolate* isolate = job->promise.isolate();
+  mate::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(job->promise.GetContext());
+
+  mate::Dictionary timing = mate::Dictionary::CreateEmpty(isolate);
+  timing.Set("queue", (job->started - job->queued).InMillisecondsF());
+  timing.Set("load", (job->loaded - job->started).InMillisecondsF());
+  timing.Set("print", (job->printed - job->loaded).InMillisecondsF());
+  timing.Set("total",
+             (base::TimeTicks::Now() - job->queued).InMillisecondsF());
+
+  mate::Dictionary result = mate::Dictionary::CreateEmpty(isolate);
+  if (data) {
+    result.Set("data", PrintPreviewMessageHandler::PdfToV8(
+                           isolate, job->output, std::move(data)));
+  }
+  result.Set("timing", timing);
+  job->promise.Resolve(result.GetHandle());
+}
+
+void PDFRenderPool::RetireRenderer(Renderer* renderer) {
+  auto it = std::find_if(
+      renderers_.begin(), renderers_.end(),
+      [renderer](const std::unique_ptr<Renderer>& r) {
+        return r.get() == renderer;
+      });
+  if (it == renderers_.end())
+    return;
+  base::ThreadTaskRunnerHandle::Get()->DeleteSoon(FROM_HERE, std::move(*it));
+  renderers_.erase(it);
+}
+
+void PDFRenderPool::Pin() {
+  if (wrapper_.IsEmpty())
+    wrapper_.Reset(isolate(), GetWrapper());
+}
+
+void PDFRenderPool::Unpin() {
+  wrapper_.Reset();
+}
+
+// static
+mate::Handle<PDFRenderPool> PDFRenderPool::Create(
+    v8::Isolate* isolate,
+    const mate::Dictionary& options) {
+  return mate::CreateHandle(isolate, new PDFRenderPool(isolate, options));
+}
+
+// static
+void PDFRenderPool::BuildPrototype(v8::Isolate* isolate,
+                                   v8::Local<v8::FunctionTemplate> prototype) {
+  prototype->SetClassName(mate::StringToV8(isolate, "PDFRenderPool"));
+  mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("_render", &PDFRenderPool::Render)
+      .SetMethod("close", &PDFRenderPool::Close)
+      .SetProperty("size", &PDFRenderPool::GetSize)
+      .SetProperty("pendingJobCount", &PDFRenderPool::GetPendingJobCount)
+      .SetProperty("closed", &PDFRenderPool::IsClosed);
+}
+
+}  // namespace api
+
+}  // namespace electron
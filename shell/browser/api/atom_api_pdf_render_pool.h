@@ -0,0 +1,109 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_ATOM_API_PDF_RENDER_POOL_H_
+#define SHELL_BROWSER_API_ATOM_API_PDF_RENDER_POOL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "native_mate/handle.h"
+#include "shell/browser/api/trackable_object.h"
+#include "shell/browser/printing/print_preview_message_handler.h"
+#include "shell/common/promise_util.h"
+#include "url/gurl.h"
+
+namespace mate {
+class Dictionary;
+}
+
+namespace electron {
+
+namespace api {
+
+// Renders documents to PDF on a pool of hidden WebContents.
+//
+// Jobs are queued and handed to the first idle renderer, so as many documents
+// load and print at the same time as there are renderers. A renderer loads
+// the next document as soon as it is done printing one, its renderer process
+// is only replaced after a number of jobs, after a crash or when a job times
+// out. Each job resolves its own promise, in the order they complete.
+class PDFRenderPool : public mate::TrackableObject<PDFRenderPool> {
+ public:
+  static mate::Handle<PDFRenderPool> Create(v8::Isolate* isolate,
+                                            const mate::Dictionary& options);
+
+  static void BuildPrototype(v8::Isolate* isolate,
+                             v8::Local<v8::FunctionTemplate> prototype);
+
+ protected:
+  PDFRenderPool(v8::Isolate* isolate, const mate::Dictionary& options);
+  ~PDFRenderPool() override;
+
+ private:
+  class Renderer;
+  struct Job;
+
+  // Queues loading |url| and printing it with |settings|, the promise is
+  // resolved with the PDF as |output| and the timing of the job.
+  v8::Local<v8::Promise> Render(
+      const GURL& url,
+      const base::DictionaryValue& settings,
+      PrintPreviewMessageHandler::Output output,
+      const base::FilePath& path);
+  // Rejects the pending jobs and closes the renderers.
+  void Close();
+
+  int GetSize() const;
+  int GetPendingJobCount() const;
+  bool IsClosed() const;
+
+  // Hands queued jobs to idle renderers, creating renderers as needed.
+  void DispatchJobs();
+  void ScheduleDispatch();
+  void OnJobDone(Renderer* renderer,
+                 std::unique_ptr<Job> job,
+                 const std::string& error,
+                 scoped_refptr<base::RefCountedMemory> data);
+  void RetireRenderer(Renderer* renderer);
+
+  // Keeps the JavaScript wrapper alive while jobs are pending, so that their
+  // promises are settled even if JavaScript drops the pool.
+  void Pin();
+  void Unpin();
+
+  // Resolves the promise of |job| with |data| and its timing, or rejects it
+  // if the PDF could not be |written| to a file.
+  static void ResolveJob(std::unique_ptr<Job> job,
+                         scoped_refptr<base::RefCountedMemory> data,
+                         bool written);
+
+  size_t size_;
+  int max_jobs_per_renderer_;
+  base::TimeDelta timeout_;
+  // The options the WebContents of the renderers are created with.
+  v8::Global<v8::Object> web_contents_options_;
+  v8::Global<v8::Object> wrapper_;
+
+  base::circular_deque<std::unique_ptr<Job>> queue_;
+  std::vector<std::unique_ptr<Renderer>> renderers_;
+  bool dispatch_scheduled_ = false;
+  bool closed_ = false;
+
+  base::WeakPtrFactory<PDFRenderPool> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(PDFRenderPool);
+};
+
+}  // namespace api
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_ATOM_API_PDF_RENDER_POOL_H_
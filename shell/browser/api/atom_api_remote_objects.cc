@@ -0,0 +1,63 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "native_mate/dictionary.h"
+#include "shell/browser/remote_objects_registry.h"
+#include "shell/common/node_includes.h"
+
+namespace {
+
+using electron::RemoteObjectsRegistry;
+
+int32_t Add(v8::Isolate* isolate,
+            const std::string& owner,
+            v8::Local<v8::Object> object) {
+  return RemoteObjectsRegistry::GetInstance()->Add(isolate, owner, object);
+}
+
+v8::Local<v8::Value> Get(v8::Isolate* isolate, int32_t id) {
+  v8::Local<v8::Object> object =
+      RemoteObjectsRegistry::GetInstance()->Get(isolate, id);
+  if (object.IsEmpty())
+    return v8::Undefined(isolate);
+  return object;
+}
+
+void Remove(v8::Isolate* isolate,
+            const std::string& owner,
+            int32_t id,
+            int ref_count) {
+  RemoteObjectsRegistry::GetInstance()->Remove(isolate, owner, id, ref_count);
+}
+
+void Clear(v8::Isolate* isolate, const std::string& owner) {
+  RemoteObjectsRegistry::GetInstance()->Clear(isolate, owner);
+}
+
+bool HasOwner(const std::string& owner) {
+  return RemoteObjectsRegistry::GetInstance()->HasOwner(owner);
+}
+
+uint32_t GetSize() {
+  return static_cast<uint32_t>(RemoteObjectsRegistry::GetInstance()->size());
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  mate::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("add", &Add);
+  dict.SetMethod("get", &Get);
+  dict.SetMethod("remove", &Remove);
+  dict.SetMethod("clear", &Clear);
+  dict.SetMethod("hasOwner", &HasOwner);
+  dict.SetMethod("getSize", &GetSize);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(atom_browser_remote_objects, Initialize)
@@ -52,6 +52,7 @@
 #include "shell/browser/browser.h"
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
+#include "shell/browser/partition_pref_store.h"
 #include "shell/browser/session_preferences.h"
 #include "shell/common/native_mate_converters/callback_converter_deprecated.h"
 #include "shell/common/native_mate_converters/content_converter.h"
@@ -319,6 +320,22 @@ void Session::FlushStorageData() {
   auto* storage_partition =
       content::BrowserContext::GetStoragePartition(browser_context(), nullptr);
   storage_partition->Flush();
+  browser_context_->CommitPartitionPrefs();
+}
+
+v8::Local<v8::Value> Session::GetPreferenceWriteStats() {
+  PartitionPrefStore::Stats stats = browser_context_->GetPartitionPrefStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+  dict.Set("changes", static_cast<double>(stats.changes));
+  dict.Set("commits", static_cast<double>(stats.commits));
+  dict.Set("failedCommits", static_cast<double>(stats.failed_commits));
+  dict.Set("bytesWritten", static_cast<double>(stats.bytes_written));
+  dict.Set("averageCommitLatency",
+           stats.commits ? stats.total_commit_latency.InMillisecondsF() /
+                               stats.commits
+                         : 0.0);
+  dict.Set("maxCommitLatency", stats.max_commit_latency.InMillisecondsF());
+  return dict.GetHandle();
 }
 
 v8::Local<v8::Promise> Session::SetProxy(mate::Arguments* args) {
@@ -690,6 +707,7 @@ void Session::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("clearCache", &Session::ClearCache)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
+      .SetMethod("getPreferenceWriteStats", &Session::GetPreferenceWriteStats)
       .SetMethod("setProxy", &Session::SetProxy)
       .SetMethod("setDownloadPath", &Session::SetDownloadPath)
       .SetMethod("enableNetworkEmulation", &Session::EnableNetworkEmulation)
@@ -62,6 +62,7 @@ class Session : public mate::TrackableObject<Session>,
   v8::Local<v8::Promise> ClearCache();
   v8::Local<v8::Promise> ClearStorageData(mate::Arguments* args);
   void FlushStorageData();
+  v8::Local<v8::Value> GetPreferenceWriteStats();
   v8::Local<v8::Promise> SetProxy(mate::Arguments* args);
   void SetDownloadPath(const base::FilePath& path);
   void EnableNetworkEmulation(const mate::Dictionary& options);
@@ -18,6 +18,7 @@
 #include "shell/browser/native_window.h"
 #include "shell/browser/native_window_observer.h"
 #include "shell/common/api/atom_api_native_image.h"
+#include "shell/common/id_weak_map.h"
 
 namespace electron {
 
@@ -255,7 +256,7 @@ class TopLevelWindow : public mate::TrackableObject<TopLevelWindow>,
   std::map<int32_t, v8::Global<v8::Value>> browser_views_;
   v8::Global<v8::Value> menu_;
   v8::Global<v8::Value> parent_window_;
-  KeyWeakMap<int> child_windows_;
+  IDWeakMap child_windows_;
 
   std::unique_ptr<NativeWindow> window_;
 
@@ -4,17 +4,21 @@
 
 #include "shell/browser/api/atom_api_web_contents.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/message_loop/message_loop_current.h"
 #include "base/no_destructor.h"
 #include "base/optional.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/ssl/security_state_tab_helper.h"
@@ -58,6 +62,7 @@
 #include "shell/browser/atom_navigation_throttle.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/child_web_contents_tracker.h"
+#include "shell/browser/frame_capture_options.h"
 #include "shell/browser/lib/bluetooth_chooser.h"
 #include "shell/browser/native_window.h"
 #include "shell/browser/session_preferences.h"
@@ -76,6 +81,7 @@
 #include "shell/common/native_mate_converters/file_path_converter.h"
 #include "shell/common/native_mate_converters/gfx_converter.h"
 #include "shell/common/native_mate_converters/gurl_converter.h"
+#include "shell/common/native_mate_converters/heap_snapshot_converter.h"
 #include "shell/common/native_mate_converters/image_converter.h"
 #include "shell/common/native_mate_converters/map_converter.h"
 #include "shell/common/native_mate_converters/net_converter.h"
@@ -91,6 +97,8 @@
 #include "third_party/blink/public/platform/web_input_event.h"
 #include "ui/display/screen.h"
 #include "ui/events/base_event_utils.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
 
 #if BUILDFLAG(ENABLE_OSR)
 #include "shell/browser/osr/osr_render_widget_host_view.h"
@@ -115,6 +123,7 @@
 #if BUILDFLAG(ENABLE_PRINTING)
 #include "chrome/browser/printing/print_view_manager_basic.h"
 #include "components/printing/common/print_messages.h"
+#include "shell/browser/api/atom_api_pdf_render_pool.h"
 #endif
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
@@ -190,6 +199,26 @@ struct Converter<printing::DuplexMode> {
   }
 };
 
+bool Converter<electron::PrintPreviewMessageHandler::Output>::FromV8(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> val,
+    electron::PrintPreviewMessageHandler::Output* out) {
+  using Output = electron::PrintPreviewMessageHandler::Output;
+  std::string output;
+  if (!ConvertFromV8(isolate, val, &output))
+    return false;
+  if (output == "buffer") {
+    *out = Output::kBuffer;
+  } else if (output == "arrayBuffer") {
+    *out = Output::kArrayBuffer;
+  } else if (output == "file") {
+    *out = Output::kFile;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 #endif
 
 template <>
@@ -243,6 +272,36 @@ struct Converter<content::SavePageType> {
   }
 };
 
+template <>
+struct Converter<electron::FrameCaptureOptions> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::FrameCaptureOptions* out) {
+    mate::Dictionary dict;
+    if (!ConvertFromV8(isolate, val, &dict))
+      return false;
+    std::string pixel_format;
+    if (dict.Get("pixelFormat", &pixel_format)) {
+      if (pixel_format == "argb")
+        out->pixel_format = media::PIXEL_FORMAT_ARGB;
+      else if (pixel_format == "i420")
+        out->pixel_format = media::PIXEL_FORMAT_I420;
+      else
+        return false;
+    }
+    if (dict.Get("scaleFactor", &out->scale_factor) &&
+        !(out->scale_factor > 0 && out->scale_factor <= 1))
+      return false;
+    if (dict.Get("size", &out->max_size) &&
+        (out->max_size.width() <= 0 || out->max_size.height() <= 0))
+      return false;
+    if (dict.Get("maxFrameRate", &out->max_frame_rate) &&
+        (out->max_frame_rate < 1 || out->max_frame_rate > 240))
+      return false;
+    return true;
+  }
+};
+
 template <>
 struct Converter<electron::api::WebContents::Type> {
   static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
@@ -306,11 +365,142 @@ namespace api {
 
 namespace {
 
+// Converts the arguments of a message sent from JavaScript, failing like the
+// bindings do, and returns how long the conversion took in
+// |conversion_time|.
+bool ConvertIPCArguments(mate::Arguments* args,
+                         v8::Local<v8::Value> value,
+                         base::ListValue* arguments,
+                         base::TimeDelta* conversion_time) {
+  base::TimeTicks start = base::TimeTicks::Now();
+  if (!mate::ConvertFromV8(args->isolate(), value, arguments)) {
+    args->ThrowError();
+    return false;
+  }
+  *conversion_time = base::TimeTicks::Now() - start;
+  return true;
+}
+
+// What capturePage() and capturePageToBuffer() resolve with.
+struct CapturePageOptions {
+  enum class Format {
+    kImage,
+    kPNG,
+    kJPEG,
+  };
+
+  // The size of the captured bitmap, the captured area is scaled to it when
+  // the surface is copied.
+  gfx::Size size;
+  Format format = Format::kImage;
+  int quality = 90;
+};
+
+// Largest width or height of a captured bitmap, both for requested sizes
+// and for the ones derived from the aspect ratio of the view.
+const int kMaxCaptureSize = 16384;
+
+int ClampCaptureSize(int64_t size) {
+  return static_cast<int>(
+      std::min<int64_t>(std::max<int64_t>(size, 1), kMaxCaptureSize));
+}
+
+// Sizes that are not given keep the aspect ratio of |view_size|, like
+// nativeImage.resize().
+bool GetCapturePageOptions(const mate::Dictionary& dict,
+                           const gfx::Size& view_size,
+                           CapturePageOptions* options) {
+  int width = 0;
+  int height = 0;
+  bool width_set = dict.Get("width", &width);
+  bool height_set = dict.Get("height", &height);
+  if ((width_set && width <= 0) || (height_set && height <= 0))
+    return false;
+  width = std::min(width, kMaxCaptureSize);
+  height = std::min(height, kMaxCaptureSize);
+  if (view_size.IsEmpty()) {
+    options->size = gfx::Size(width, height);
+  } else if (width_set && height_set) {
+    options->size = gfx::Size(width, height);
+  } else if (width_set) {
+    options->size = gfx::Size(
+        width, ClampCaptureSize(int64_t{width} * view_size.height() /
+                                view_size.width()));
+  } else if (height_set) {
+    options->size = gfx::Size(
+        ClampCaptureSize(int64_t{height} * view_size.width() /
+                         view_size.height()),
+        height);
+  }
+
+  // The format only applies to capturePageToBuffer().
+  if (options->format == CapturePageOptions::Format::kImage)
+    return true;
+  std::string format;
+  if (dict.Get("format", &format)) {
+    if (format == "png")
+      options->format = CapturePageOptions::Format::kPNG;
+    else if (format == "jpeg")
+      options->format = CapturePageOptions::Format::kJPEG;
+    else
+      return false;
+  }
+  if (dict.Get("quality", &options->quality) &&
+      (options->quality < 0 || options->quality > 100))
+    return false;
+  return true;
+}
+
+// Runs on the thread pool, the pixels of |bitmap| are shared and never
+// written to again.
+std::vector<unsigned char> EncodeCapturedPage(const SkBitmap& bitmap,
+                                              CapturePageOptions::Format format,
+                                              int quality) {
+  std::vector<unsigned char> encoded;
+  if (bitmap.drawsNothing())
+    return encoded;
+  if (format == CapturePageOptions::Format::kJPEG)
+    gfx::JPEGCodec::Encode(bitmap, quality, &encoded);
+  else
+    gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+  return encoded;
+}
+
+void OnCapturedPageEncoded(util::Promise<v8::Local<v8::Value>> promise,
+                           std::vector<unsigned char> encoded) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(
+      node::Buffer::Copy(isolate, reinterpret_cast<char*>(encoded.data()),
+                         encoded.size())
+          .ToLocalChecked());
+}
+
 // Called when CapturePage is done.
-void OnCapturePageDone(util::Promise<gfx::Image> promise,
+void OnCapturePageDone(util::Promise<v8::Local<v8::Value>> promise,
+                       const CapturePageOptions& options,
                        const SkBitmap& bitmap) {
+  if (options.format != CapturePageOptions::Format::kImage) {
+    // Keep the UI thread free while the page is encoded.
+    SkBitmap shared = bitmap;
+    shared.setImmutable();
+    base::PostTaskWithTraitsAndReplyWithResult(
+        FROM_HERE,
+        {base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&EncodeCapturedPage, shared, options.format,
+                       options.quality),
+        base::BindOnce(&OnCapturedPageEncoded, std::move(promise)));
+    return;
+  }
+
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
   // Hack to enable transparency in captured image
-  promise.Resolve(gfx::Image::CreateFrom1xBitmap(bitmap));
+  promise.Resolve(mate::ConvertToV8(isolate,
+                                    gfx::Image::CreateFrom1xBitmap(bitmap)));
 }
 
 }  // namespace
@@ -997,37 +1187,74 @@ void WebContents::OnElectronBrowserConnectionError() {
 
 void WebContents::Message(bool internal,
                           const std::string& channel,
-                          base::Value arguments) {
+                          base::Value arguments,
+                          base::TimeTicks sent_at) {
+  TRACE_EVENT1("electron", "WebContents::Message", "channel", channel);
   // webContents.emit('-ipc-message', new Event(), internal, channel,
   // arguments);
-  EmitWithSender("-ipc-message", bindings_.dispatch_context(), base::nullopt,
-                 internal, channel, std::move(arguments));
+  EmitIPCMessage("-ipc-message", internal, channel, std::move(arguments),
+                 sent_at, base::nullopt);
 }
 
 void WebContents::Invoke(bool internal,
                          const std::string& channel,
                          base::Value arguments,
+                         base::TimeTicks sent_at,
                          InvokeCallback callback) {
+  TRACE_EVENT1("electron", "WebContents::Invoke", "channel", channel);
   // webContents.emit('-ipc-invoke', new Event(), internal, channel, arguments);
-  EmitWithSender("-ipc-invoke", bindings_.dispatch_context(),
-                 std::move(callback), internal, channel, std::move(arguments));
+  EmitIPCMessage("-ipc-invoke", internal, channel, std::move(arguments),
+                 sent_at, std::move(callback));
 }
 
 void WebContents::MessageSync(bool internal,
                               const std::string& channel,
                               base::Value arguments,
+                              base::TimeTicks sent_at,
                               MessageSyncCallback callback) {
+  TRACE_EVENT1("electron", "WebContents::MessageSync", "channel", channel);
   // webContents.emit('-ipc-message-sync', new Event(sender, message), internal,
   // channel, arguments);
-  EmitWithSender("-ipc-message-sync", bindings_.dispatch_context(),
-                 std::move(callback), internal, channel, std::move(arguments));
+  EmitIPCMessage("-ipc-message-sync", internal, channel, std::move(arguments),
+                 sent_at, std::move(callback));
+}
+
+void WebContents::EmitIPCMessage(
+    base::StringPiece name,
+    bool internal,
+    const std::string& channel,
+    base::Value arguments,
+    base::TimeTicks sent_at,
+    base::Optional<mojom::ElectronBrowser::MessageSyncCallback> callback) {
+  base::TimeTicks received_at = base::TimeTicks::Now();
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  size_t bytes = IpcStats::EstimateSize(arguments);
+  v8::Local<v8::Value> args = mate::ConvertToV8(isolate(), arguments);
+  base::TimeTicks converted_at = base::TimeTicks::Now();
+  // The handlers may destroy this WebContents.
+  auto weak_this = weak_factory_.GetWeakPtr();
+  EmitWithSender(name, bindings_.dispatch_context(), std::move(callback),
+                 internal, channel, args);
+  if (!weak_this)
+    return;
+  ipc_stats_.RecordReceived(channel, bytes, converted_at - received_at,
+                            received_at - sent_at,
+                            base::TimeTicks::Now() - converted_at);
 }
 
 void WebContents::MessageTo(bool internal,
                             bool send_to_all,
                             int32_t web_contents_id,
                             const std::string& channel,
-                            base::Value arguments) {
+                            base::Value arguments,
+                            base::TimeTicks sent_at) {
+  // The message is forwarded without being converted or handled here.
+  ipc_stats_.RecordReceived(channel, IpcStats::EstimateSize(arguments),
+                            base::TimeDelta(),
+                            base::TimeTicks::Now() - sent_at,
+                            base::TimeDelta());
+
   auto* web_contents = mate::TrackableObject<WebContents>::FromWeakMapID(
       isolate(), web_contents_id);
 
@@ -1039,10 +1266,23 @@ void WebContents::MessageTo(bool internal,
 }
 
 void WebContents::MessageHost(const std::string& channel,
-                              base::Value arguments) {
+                              base::Value arguments,
+                              base::TimeTicks sent_at) {
+  base::TimeTicks received_at = base::TimeTicks::Now();
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  size_t bytes = IpcStats::EstimateSize(arguments);
+  v8::Local<v8::Value> args = mate::ConvertToV8(isolate(), arguments);
+  base::TimeTicks converted_at = base::TimeTicks::Now();
+  auto weak_this = weak_factory_.GetWeakPtr();
   // webContents.emit('ipc-message-host', new Event(), channel, args);
   EmitWithSender("ipc-message-host", bindings_.dispatch_context(),
-                 base::nullopt, channel, std::move(arguments));
+                 base::nullopt, channel, args);
+  if (!weak_this)
+    return;
+  ipc_stats_.RecordReceived(channel, bytes, converted_at - received_at,
+                            received_at - sent_at,
+                            base::TimeTicks::Now() - converted_at);
 }
 
 void WebContents::UpdateDraggableRegions(
@@ -1356,10 +1596,9 @@ void WebContents::LoadURL(const GURL& url, const mate::Dictionary& options) {
   auto* const view = web_contents()->GetRenderWidgetHostView();
   if (view) {
     auto* web_preferences = WebContentsPreferences::From(web_contents());
-    std::string color_name;
-    if (web_preferences->GetPreference(options::kBackgroundColor,
-                                       &color_name)) {
-      view->SetBackgroundColor(ParseHexColor(color_name));
+    const auto& color_name = web_preferences->parsed().background_color;
+    if (color_name) {
+      view->SetBackgroundColor(ParseHexColor(*color_name));
     } else {
       view->SetBackgroundColor(SK_ColorTRANSPARENT);
     }
@@ -1587,8 +1826,7 @@ void WebContents::InspectServiceWorker() {
 void WebContents::SetIgnoreMenuShortcuts(bool ignore) {
   auto* web_preferences = WebContentsPreferences::From(web_contents());
   DCHECK(web_preferences);
-  web_preferences->preference()->SetKey("ignoreMenuShortcuts",
-                                        base::Value(ignore));
+  web_preferences->SetPreference("ignoreMenuShortcuts", base::Value(ignore));
 }
 
 void WebContents::SetAudioMuted(bool muted) {
@@ -1780,11 +2018,13 @@ std::vector<printing::PrinterBasicInfo> WebContents::GetPrinterList() {
 }
 
 v8::Local<v8::Promise> WebContents::PrintToPDF(
-    const base::DictionaryValue& settings) {
+    const base::DictionaryValue& settings,
+    PrintPreviewMessageHandler::Output output,
+    const base::FilePath& path) {
   util::Promise<v8::Local<v8::Value>> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
   PrintPreviewMessageHandler::FromWebContents(web_contents())
-      ->PrintToPDF(settings, std::move(promise));
+      ->PrintToPDF(settings, output, path, std::move(promise));
   return handle;
 }
 #endif
@@ -1913,18 +2153,26 @@ void WebContents::TabTraverse(bool reverse) {
   web_contents()->FocusThroughTabTraversal(reverse);
 }
 
-bool WebContents::SendIPCMessage(bool internal,
+bool WebContents::SendIPCMessage(mate::Arguments* args,
+                                 bool internal,
                                  bool send_to_all,
                                  const std::string& channel,
-                                 const base::ListValue& args) {
-  return SendIPCMessageWithSender(internal, send_to_all, channel, args);
+                                 v8::Local<v8::Value> value) {
+  base::ListValue arguments;
+  base::TimeDelta conversion_time;
+  if (!ConvertIPCArguments(args, value, &arguments, &conversion_time))
+    return false;
+  return SendIPCMessageWithSender(internal, send_to_all, channel, arguments,
+                                  0, conversion_time);
 }
 
 bool WebContents::SendIPCMessageWithSender(bool internal,
                                            bool send_to_all,
                                            const std::string& channel,
                                            const base::ListValue& args,
-                                           int32_t sender_id) {
+                                           int32_t sender_id,
+                                           base::TimeDelta conversion_time) {
+  TRACE_EVENT1("electron", "WebContents::SendIPCMessage", "channel", channel);
   std::vector<content::RenderFrameHost*> target_hosts;
   if (!send_to_all) {
     auto* frame_host = web_contents()->GetMainFrame();
@@ -1939,16 +2187,24 @@ bool WebContents::SendIPCMessageWithSender(bool internal,
     mojom::ElectronRendererAssociatedPtr electron_ptr;
     frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
         mojo::MakeRequest(&electron_ptr));
-    electron_ptr->Message(internal, false, channel, args.Clone(), sender_id);
+    electron_ptr->Message(internal, false, channel, args.Clone(), sender_id,
+                          base::TimeTicks::Now());
   }
+  ipc_stats_.RecordSent(channel, IpcStats::EstimateSize(args),
+                        conversion_time);
   return true;
 }
 
-bool WebContents::SendIPCMessageToFrame(bool internal,
+bool WebContents::SendIPCMessageToFrame(mate::Arguments* args,
+                                        bool internal,
                                         bool send_to_all,
                                         int32_t frame_id,
                                         const std::string& channel,
-                                        const base::ListValue& args) {
+                                        v8::Local<v8::Value> value) {
+  base::ListValue arguments;
+  base::TimeDelta conversion_time;
+  if (!ConvertIPCArguments(args, value, &arguments, &conversion_time))
+    return false;
   auto frames = web_contents()->GetAllFrames();
   auto iter = std::find_if(frames.begin(), frames.end(), [frame_id](auto* f) {
     return f->GetRoutingID() == frame_id;
@@ -1961,11 +2217,21 @@ bool WebContents::SendIPCMessageToFrame(bool internal,
   mojom::ElectronRendererAssociatedPtr electron_ptr;
   (*iter)->GetRemoteAssociatedInterfaces()->GetInterface(
       mojo::MakeRequest(&electron_ptr));
-  electron_ptr->Message(internal, send_to_all, channel, args.Clone(),
-                        0 /* sender_id */);
+  electron_ptr->Message(internal, send_to_all, channel, arguments.Clone(),
+                        0 /* sender_id */, base::TimeTicks::Now());
+  ipc_stats_.RecordSent(channel, IpcStats::EstimateSize(arguments),
+                        conversion_time);
   return true;
 }
 
+base::Value WebContents::GetIPCStats() const {
+  return ipc_stats_.ToValue();
+}
+
+void WebContents::ResetIPCStats() {
+  ipc_stats_.Reset();
+}
+
 void WebContents::SendInputEvent(v8::Isolate* isolate,
                                  v8::Local<v8::Value> input_event) {
   content::RenderWidgetHostView* view =
@@ -2030,16 +2296,27 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
 
 void WebContents::BeginFrameSubscription(mate::Arguments* args) {
   bool only_dirty = false;
+  FrameCaptureOptions options;
   FrameSubscriber::FrameCaptureCallback callback;
 
-  args->GetNext(&only_dirty);
+  v8::Local<v8::Value> next = args->PeekNext();
+  if (!next.IsEmpty() && next->IsObject() && !next->IsFunction()) {
+    mate::Dictionary dict(isolate(), next.As<v8::Object>());
+    dict.Get("onlyDirty", &only_dirty);
+    if (!args->GetNext(&options)) {
+      args->ThrowError("Invalid frame subscription options");
+      return;
+    }
+  } else {
+    args->GetNext(&only_dirty);
+  }
   if (!args->GetNext(&callback)) {
     args->ThrowError();
     return;
   }
 
-  frame_subscriber_ =
-      std::make_unique<FrameSubscriber>(web_contents(), callback, only_dirty);
+  frame_subscriber_ = std::make_unique<FrameSubscriber>(
+      isolate(), web_contents(), callback, only_dirty, options);
 }
 
 void WebContents::EndFrameSubscription() {
@@ -2083,16 +2360,35 @@ void WebContents::StartDrag(const mate::Dictionary& item,
 }
 
 v8::Local<v8::Promise> WebContents::CapturePage(mate::Arguments* args) {
+  return CaptureSurface(args, false);
+}
+
+v8::Local<v8::Promise> WebContents::CapturePageToBuffer(
+    mate::Arguments* args) {
+  return CaptureSurface(args, true);
+}
+
+v8::Local<v8::Promise> WebContents::CaptureSurface(mate::Arguments* args,
+                                                   bool encode) {
   gfx::Rect rect;
-  util::Promise<gfx::Image> promise(isolate());
+  util::Promise<v8::Local<v8::Value>> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  // get rect arguments if they exist
-  args->GetNext(&rect);
+  // get rect arguments if they exist, null skips them to pass options
+  if (!args->GetNext(&rect)) {
+    v8::Local<v8::Value> next = args->PeekNext();
+    if (!next.IsEmpty() && next->IsNullOrUndefined())
+      args->GetNext(&next);
+  }
+  mate::Dictionary dict;
+  args->GetNext(&dict);
 
   auto* const view = web_contents()->GetRenderWidgetHostView();
   if (!view) {
-    promise.Resolve(gfx::Image());
+    if (encode)
+      promise.Resolve(node::Buffer::New(isolate(), 0).ToLocalChecked());
+    else
+      promise.Resolve(mate::ConvertToV8(isolate(), gfx::Image()));
     return handle;
   }
 
@@ -2100,19 +2396,32 @@ v8::Local<v8::Promise> WebContents::CapturePage(mate::Arguments* args) {
   const gfx::Size view_size =
       rect.IsEmpty() ? view->GetViewBounds().size() : rect.size();
 
+  CapturePageOptions options;
+  if (encode)
+    options.format = CapturePageOptions::Format::kPNG;
+  if (!dict.IsEmpty() && !GetCapturePageOptions(dict, view_size, &options)) {
+    promise.RejectWithErrorMessage("Invalid capture options");
+    return handle;
+  }
+
   // By default, the requested bitmap size is the view size in screen
   // coordinates.  However, if there's more pixel detail available on the
   // current system, increase the requested bitmap size to capture it all.
+  // A requested size is produced by the copy request, which scales the
+  // surface on the GPU.
   gfx::Size bitmap_size = view_size;
   const gfx::NativeView native_view = view->GetNativeView();
   const float scale = display::Screen::GetScreen()
                           ->GetDisplayNearestView(native_view)
                           .device_scale_factor();
-  if (scale > 1.0f)
+  if (!options.size.IsEmpty())
+    bitmap_size = options.size;
+  else if (scale > 1.0f)
     bitmap_size = gfx::ScaleToCeiledSize(view_size, scale);
 
-  view->CopyFromSurface(gfx::Rect(rect.origin(), view_size), bitmap_size,
-                        base::BindOnce(&OnCapturePageDone, std::move(promise)));
+  view->CopyFromSurface(
+      gfx::Rect(rect.origin(), view_size), bitmap_size,
+      base::BindOnce(&OnCapturePageDone, std::move(promise), options));
   return handle;
 }
 
@@ -2150,6 +2459,14 @@ bool WebContents::IsOffScreen() const {
 
 #if BUILDFLAG(ENABLE_OSR)
 void WebContents::OnPaint(const gfx::Rect& dirty_rect, const SkBitmap& bitmap) {
+  if (video_encoder_)
+    video_encoder_->EncodeFrame(bitmap, dirty_rect, base::TimeTicks::Now());
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  if (!mate::internal::ShouldEmit(isolate(), GetWrapper(), "paint"))
+    return;
+  // The image shares the pixels of the backing store, which writes the next
+  // frames to its other bitmaps until JavaScript collects the image.
   Emit("paint", dirty_rect, gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
@@ -2180,6 +2497,116 @@ int WebContents::GetFrameRate() const {
   auto* osr_wcv = GetOffScreenWebContentsView();
   return osr_wcv ? osr_wcv->GetFrameRate() : 0;
 }
+
+v8::Local<v8::Value> WebContents::GetPaintStats() const {
+  OffScreenBackingStore::Stats stats;
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  if (osr_rwhv)
+    stats = osr_rwhv->GetPaintStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate());
+  dict.Set("frames", static_cast<double>(stats.frames));
+  dict.Set("bytesCopied", static_cast<double>(stats.bytes_copied));
+  dict.Set("bytesAllocated", static_cast<double>(stats.bytes_allocated));
+  return dict.GetHandle();
+}
+
+void WebContents::StartVideoEncoding(mate::Arguments* args) {
+  auto* osr_rwhv = GetOffScreenRenderWidgetHostView();
+  if (!osr_rwhv) {
+    args->ThrowError("Video encoding is only supported in offscreen mode");
+    return;
+  }
+  if (video_encoder_) {
+    args->ThrowError("Video encoding has already been started");
+    return;
+  }
+
+  OffScreenVideoEncoder::Options options;
+  base::FilePath path;
+  mate::Dictionary dict;
+  if (args->GetNext(&dict)) {
+    std::string codec;
+    if (dict.Get("codec", &codec)) {
+      if (codec == "vp9") {
+        options.codec = OffScreenVideoEncoder::Codec::kVP9;
+      } else if (codec != "vp8") {
+        args->ThrowError("Invalid codec: " + codec);
+        return;
+      }
+    }
+    if (dict.Get("bitrate", &options.bitrate) && options.bitrate <= 0) {
+      args->ThrowError("bitrate must be positive");
+      return;
+    }
+    dict.Get("path", &path);
+  }
+
+  base::File file;
+  if (!path.empty()) {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    file.Initialize(path,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    if (!file.IsValid()) {
+      args->ThrowError("Failed to open " + path.AsUTF8Unsafe());
+      return;
+    }
+  }
+
+  video_encoder_ = std::make_unique<OffScreenVideoEncoder>(
+      options, std::move(file),
+      base::BindRepeating(&WebContents::OnVideoPacket, GetWeakPtr()));
+  // The first frame holds everything that is currently painted.
+  osr_rwhv->Invalidate();
+}
+
+v8::Local<v8::Promise> WebContents::StopVideoEncoding() {
+  util::Promise<mate::Dictionary> promise(isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!video_encoder_) {
+    promise.RejectWithErrorMessage("Video encoding has not been started");
+    return handle;
+  }
+
+  // The encoder is kept alive until it finished on its own sequence, even
+  // if this WebContents goes away. Packets it still delivers are dropped then.
+  auto* encoder = video_encoder_.get();
+  encoder->Stop(base::BindOnce(
+      [](std::unique_ptr<OffScreenVideoEncoder> encoder,
+         util::Promise<mate::Dictionary> promise, const std::string& error,
+         const OffScreenVideoEncoder::Stats& stats) {
+        if (!error.empty()) {
+          promise.RejectWithErrorMessage(error);
+          return;
+        }
+        v8::Isolate* isolate = promise.isolate();
+        v8::HandleScope handle_scope(isolate);
+        mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+        dict.Set("frames", static_cast<double>(stats.frames));
+        dict.Set("droppedFrames", static_cast<double>(stats.dropped_frames));
+        dict.Set("bytes", static_cast<double>(stats.bytes));
+        dict.Set("encodeTime", stats.encode_time.InMillisecondsF());
+        promise.Resolve(dict);
+      },
+      std::move(video_encoder_), std::move(promise)));
+  return handle;
+}
+
+bool WebContents::IsVideoEncoding() const {
+  return !!video_encoder_;
+}
+
+void WebContents::OnVideoPacket(OffScreenVideoEncoder::Packet packet) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  mate::Dictionary details = mate::Dictionary::CreateEmpty(isolate());
+  details.Set("timestamp", packet.timestamp.InMillisecondsF());
+  details.Set("keyFrame", packet.key_frame);
+  details.Set("size", packet.size);
+  Emit("video-packet",
+       node::Buffer::Copy(isolate(), packet.data.data(), packet.data.size())
+           .ToLocalChecked(),
+       details);
+}
 #endif
 
 void WebContents::Invalidate() {
@@ -2340,10 +2767,17 @@ void WebContents::GrantOriginAccess(const GURL& url) {
 }
 
 v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
-    const base::FilePath& file_path) {
-  util::Promise<void*> promise(isolate());
+    const base::FilePath& file_path,
+    mate::Arguments* args) {
+  util::Promise<HeapSnapshotStats> promise(isolate());
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
+  HeapSnapshotOptions options;
+  if (args->Length() > 1 && !args->GetNext(&options)) {
+    promise.RejectWithErrorMessage("Invalid heap snapshot options");
+    return handle;
+  }
+
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::File file(file_path,
                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
@@ -2366,12 +2800,19 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
       mojo::MakeRequest(electron_ptr.get()));
   auto* raw_ptr = electron_ptr.get();
   (*raw_ptr)->TakeHeapSnapshot(
-      mojo::WrapPlatformFile(file.TakePlatformFile()),
+      mojo::WrapPlatformFile(file.TakePlatformFile()), options.gzip,
       base::BindOnce(
           [](mojom::ElectronRendererAssociatedPtr* ep,
-             util::Promise<void*> promise, bool success) {
+             util::Promise<HeapSnapshotStats> promise, bool success,
+             mojom::HeapSnapshotStatsPtr mojo_stats) {
             if (success) {
-              promise.Resolve();
+              HeapSnapshotStats stats;
+              stats.uncompressed_bytes = mojo_stats->uncompressed_bytes;
+              stats.bytes_written = mojo_stats->bytes_written;
+              stats.snapshot_time = mojo_stats->snapshot_time;
+              stats.serialization_time = mojo_stats->serialization_time;
+              stats.stall_time = mojo_stats->stall_time;
+              promise.Resolve(stats);
             } else {
               promise.RejectWithErrorMessage("takeHeapSnapshot failed");
             }
@@ -2442,6 +2883,8 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("tabTraverse", &WebContents::TabTraverse)
       .SetMethod("_send", &WebContents::SendIPCMessage)
       .SetMethod("_sendToFrame", &WebContents::SendIPCMessageToFrame)
+      .SetMethod("getIPCStats", &WebContents::GetIPCStats)
+      .SetMethod("resetIPCStats", &WebContents::ResetIPCStats)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
@@ -2457,6 +2900,10 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("_getFrameRate", &WebContents::GetFrameRate)
       .SetProperty("frameRate", &WebContents::GetFrameRate,
                    &WebContents::SetFrameRate)
+      .SetMethod("getPaintStats", &WebContents::GetPaintStats)
+      .SetMethod("startVideoEncoding", &WebContents::StartVideoEncoding)
+      .SetMethod("stopVideoEncoding", &WebContents::StopVideoEncoding)
+      .SetMethod("isVideoEncoding", &WebContents::IsVideoEncoding)
 #endif
       .SetMethod("invalidate", &WebContents::Invalidate)
       .SetMethod("_setZoomLevel", &WebContents::SetZoomLevel)
@@ -2485,6 +2932,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::ShowDefinitionForSelection)
       .SetMethod("copyImageAt", &WebContents::CopyImageAt)
       .SetMethod("capturePage", &WebContents::CapturePage)
+      .SetMethod("capturePageToBuffer", &WebContents::CapturePageToBuffer)
       .SetMethod("setEmbedder", &WebContents::SetEmbedder)
       .SetMethod("setDevToolsWebContents", &WebContents::SetDevToolsWebContents)
       .SetMethod("getNativeView", &WebContents::GetNativeView)
@@ -2563,6 +3011,12 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("fromId", &mate::TrackableObject<WebContents>::FromWeakMapID);
   dict.SetMethod("getAllWebContents",
                  &mate::TrackableObject<WebContents>::GetAll);
+#if BUILDFLAG(ENABLE_PRINTING)
+  dict.Set("PDFRenderPool", PDFRenderPool::GetConstructor(isolate)
+                                ->GetFunction(context)
+                                .ToLocalChecked());
+  dict.SetMethod("createPDFRenderPool", &PDFRenderPool::Create);
+#endif
 }
 
 }  // namespace
@@ -28,6 +28,7 @@
 #include "shell/browser/api/save_page_handler.h"
 #include "shell/browser/api/trackable_object.h"
 #include "shell/browser/common_web_contents_delegate.h"
+#include "shell/common/ipc_stats.h"
 #include "ui/gfx/image/image.h"
 
 #if BUILDFLAG(ENABLE_PRINTING)
@@ -35,6 +36,10 @@
 #include "shell/browser/printing/print_preview_message_handler.h"
 #endif
 
+#if BUILDFLAG(ENABLE_OSR)
+#include "shell/browser/osr/osr_video_encoder.h"
+#endif
+
 namespace blink {
 struct WebDeviceEmulationParams;
 }
@@ -184,7 +189,10 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void Print(mate::Arguments* args);
   std::vector<printing::PrinterBasicInfo> GetPrinterList();
   // Print current page as PDF.
-  v8::Local<v8::Promise> PrintToPDF(const base::DictionaryValue& settings);
+  v8::Local<v8::Promise> PrintToPDF(
+      const base::DictionaryValue& settings,
+      PrintPreviewMessageHandler::Output output,
+      const base::FilePath& path);
 #endif
 
   // DevTools workspace api.
@@ -214,22 +222,32 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void TabTraverse(bool reverse);
 
   // Send messages to browser.
-  bool SendIPCMessage(bool internal,
+  bool SendIPCMessage(mate::Arguments* args,
+                      bool internal,
                       bool send_to_all,
                       const std::string& channel,
-                      const base::ListValue& args);
-
-  bool SendIPCMessageWithSender(bool internal,
-                                bool send_to_all,
-                                const std::string& channel,
-                                const base::ListValue& args,
-                                int32_t sender_id = 0);
-
-  bool SendIPCMessageToFrame(bool internal,
+                      v8::Local<v8::Value> value);
+
+  // |conversion_time| is the time it took to convert |args| from JavaScript,
+  // for the IPC stats.
+  bool SendIPCMessageWithSender(
+      bool internal,
+      bool send_to_all,
+      const std::string& channel,
+      const base::ListValue& args,
+      int32_t sender_id = 0,
+      base::TimeDelta conversion_time = base::TimeDelta());
+
+  bool SendIPCMessageToFrame(mate::Arguments* args,
+                             bool internal,
                              bool send_to_all,
                              int32_t frame_id,
                              const std::string& channel,
-                             const base::ListValue& args);
+                             v8::Local<v8::Value> value);
+
+  // Per-channel stats of the IPC messages exchanged with this WebContents.
+  base::Value GetIPCStats() const;
+  void ResetIPCStats();
 
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
@@ -241,9 +259,12 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // Dragging native items.
   void StartDrag(const mate::Dictionary& item, mate::Arguments* args);
 
-  // Captures the page with |rect|, |callback| would be called when capturing is
-  // done.
+  // Captures the page with |rect|, scaled to the size in the options, and
+  // resolves with a NativeImage.
   v8::Local<v8::Promise> CapturePage(mate::Arguments* args);
+  // Same as CapturePage but resolves with the page encoded as PNG or JPEG on
+  // the thread pool.
+  v8::Local<v8::Promise> CapturePageToBuffer(mate::Arguments* args);
 
   // Methods for creating <webview>.
   bool IsGuest() const;
@@ -260,6 +281,10 @@ class WebContents : public mate::TrackableObject<WebContents>,
   bool IsPainting() const;
   void SetFrameRate(int frame_rate);
   int GetFrameRate() const;
+  v8::Local<v8::Value> GetPaintStats() const;
+  void StartVideoEncoding(mate::Arguments* args);
+  v8::Local<v8::Promise> StopVideoEncoding();
+  bool IsVideoEncoding() const;
 #endif
   void Invalidate();
   gfx::Size GetSizeForNewRenderView(content::WebContents*) override;
@@ -298,7 +323,8 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // the specified URL.
   void GrantOriginAccess(const GURL& url);
 
-  v8::Local<v8::Promise> TakeHeapSnapshot(const base::FilePath& file_path);
+  v8::Local<v8::Promise> TakeHeapSnapshot(const base::FilePath& file_path,
+                                          mate::Arguments* args);
 
   // Properties.
   int32_t ID() const;
@@ -480,6 +506,9 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
   uint32_t GetNextRequestId() { return ++request_id_; }
 
+  // Copies the page to a bitmap, encoded when |encode| is true.
+  v8::Local<v8::Promise> CaptureSurface(mate::Arguments* args, bool encode);
+
 #if BUILDFLAG(ENABLE_OSR)
   OffScreenWebContentsView* GetOffScreenWebContentsView() const override;
   OffScreenRenderWidgetHostView* GetOffScreenRenderWidgetHostView() const;
@@ -488,26 +517,42 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // mojom::ElectronBrowser
   void Message(bool internal,
                const std::string& channel,
-               base::Value arguments) override;
+               base::Value arguments,
+               base::TimeTicks sent_at) override;
   void Invoke(bool internal,
               const std::string& channel,
               base::Value arguments,
+              base::TimeTicks sent_at,
               InvokeCallback callback) override;
   void MessageSync(bool internal,
                    const std::string& channel,
                    base::Value arguments,
+                   base::TimeTicks sent_at,
                    MessageSyncCallback callback) override;
   void MessageTo(bool internal,
                  bool send_to_all,
                  int32_t web_contents_id,
                  const std::string& channel,
-                 base::Value arguments) override;
-  void MessageHost(const std::string& channel, base::Value arguments) override;
+                 base::Value arguments,
+                 base::TimeTicks sent_at) override;
+  void MessageHost(const std::string& channel,
+                   base::Value arguments,
+                   base::TimeTicks sent_at) override;
   void UpdateDraggableRegions(
       std::vector<mojom::DraggableRegionPtr> regions) override;
   void SetTemporaryZoomLevel(double level) override;
   void DoGetZoomLevel(DoGetZoomLevelCallback callback) override;
 
+  // Emits |name| for a message received from the renderer and records it in
+  // the IPC stats.
+  void EmitIPCMessage(
+      base::StringPiece name,
+      bool internal,
+      const std::string& channel,
+      base::Value arguments,
+      base::TimeTicks sent_at,
+      base::Optional<mojom::ElectronBrowser::MessageSyncCallback> callback);
+
   // Called when we receive a CursorChange message from chromium.
   void OnCursorChange(const content::WebCursor& cursor);
 
@@ -557,6 +602,14 @@ class WebContents : public mate::TrackableObject<WebContents>,
   std::map<content::RenderFrameHost*, std::vector<mojo::BindingId>>
       frame_to_bindings_map_;
 
+  IpcStats ipc_stats_;
+
+#if BUILDFLAG(ENABLE_OSR)
+  void OnVideoPacket(OffScreenVideoEncoder::Packet packet);
+
+  std::unique_ptr<OffScreenVideoEncoder> video_encoder_;
+#endif
+
   base::WeakPtrFactory<WebContents> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(WebContents);
@@ -566,6 +619,19 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
 }  // namespace electron
 
+#if BUILDFLAG(ENABLE_PRINTING)
+namespace mate {
+
+template <>
+struct Converter<electron::PrintPreviewMessageHandler::Output> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::PrintPreviewMessageHandler::Output* out);
+};
+
+}  // namespace mate
+#endif
+
 namespace gin {
 
 // TODO(zcbenz): Remove this after converting WebContents to gin::Wrapper.
@@ -13,6 +13,7 @@
 #include "gin/converter.h"
 #include "gin/dictionary.h"
 #include "gin/object_template_builder.h"
+#include "gin/per_isolate_data.h"
 #include "shell/browser/api/atom_api_session.h"
 #include "shell/browser/api/atom_api_web_contents.h"
 #include "shell/browser/atom_browser_context.h"
@@ -21,6 +22,8 @@
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter_gin_adapter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/key_cache.h"
 
 namespace gin {
 
@@ -67,7 +70,7 @@ struct Converter<content::ResourceType> {
       default:
         result = "other";
     }
-    return StringToV8(isolate, result);
+    return gin_helper::KeyToV8(isolate, result);
   }
 };
 
@@ -122,8 +125,28 @@ v8::Local<v8::Value> HttpResponseHeadersToV8(
   return gin::ConvertToV8(v8::Isolate::GetCurrent(), response_headers);
 }
 
+// Creates the object passed to listeners. The properties every request has are
+// declared by a template, so all details objects start with the same shape
+// and setting them doesn't transition the object through new shapes.
+v8::Local<v8::Object> CreateDetails(v8::Isolate* isolate) {
+  static gin::WrapperInfo kDetailsTemplate = {gin::kEmbedderNativeGin};
+  auto* data = gin::PerIsolateData::From(isolate);
+  v8::Local<v8::ObjectTemplate> templ =
+      data->GetObjectTemplate(&kDetailsTemplate);
+  if (templ.IsEmpty()) {
+    templ = v8::ObjectTemplate::New(isolate);
+    for (const char* key :
+         {"id", "url", "method", "timestamp", "resourceType"}) {
+      templ->Set(gin_helper::KeyToV8(isolate, key), v8::Undefined(isolate));
+    }
+    data->SetObjectTemplate(&kDetailsTemplate, templ);
+  }
+  return templ->NewInstance(isolate->GetCurrentContext()).ToLocalChecked();
+}
+
 // Overloaded by multiple types to fill the |details| object.
-void ToDictionary(gin::Dictionary* details, extensions::WebRequestInfo* info) {
+void ToDictionary(gin_helper::Dictionary* details,
+                  extensions::WebRequestInfo* info) {
   details->Set("id", info->id);
   details->Set("url", info->url);
   details->Set("method", info->method);
@@ -148,34 +171,34 @@ void ToDictionary(gin::Dictionary* details, extensions::WebRequestInfo* info) {
     details->Set("webContentsId", id);
 }
 
-void ToDictionary(gin::Dictionary* details,
+void ToDictionary(gin_helper::Dictionary* details,
                   const network::ResourceRequest& request) {
   details->Set("referrer", request.referrer);
   if (request.request_body)
     details->Set("uploadData", *request.request_body);
 }
 
-void ToDictionary(gin::Dictionary* details,
+void ToDictionary(gin_helper::Dictionary* details,
                   const net::HttpRequestHeaders& headers) {
   details->Set("requestHeaders", headers);
 }
 
-void ToDictionary(gin::Dictionary* details, const GURL& location) {
+void ToDictionary(gin_helper::Dictionary* details, const GURL& location) {
   details->Set("redirectURL", location);
 }
 
-void ToDictionary(gin::Dictionary* details, int net_error) {
+void ToDictionary(gin_helper::Dictionary* details, int net_error) {
   details->Set("error", net::ErrorToString(net_error));
 }
 
 // Helper function to fill |details| with arbitrary |args|.
 template <typename Arg>
-void FillDetails(gin::Dictionary* details, Arg arg) {
+void FillDetails(gin_helper::Dictionary* details, Arg arg) {
   ToDictionary(details, arg);
 }
 
 template <typename Arg, typename... Args>
-void FillDetails(gin::Dictionary* details, Arg arg, Args... args) {
+void FillDetails(gin_helper::Dictionary* details, Arg arg, Args... args) {
   ToDictionary(details, arg);
   FillDetails(details, args...);
 }
@@ -406,7 +429,7 @@ void WebRequestNS::HandleSimpleEvent(SimpleEvent event,
 
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::HandleScope handle_scope(isolate);
-  gin::Dictionary details(isolate, v8::Object::New(isolate));
+  gin_helper::Dictionary details(isolate, CreateDetails(isolate));
   FillDetails(&details, request_info, args...);
   info.listener.Run(gin::ConvertToV8(isolate, details));
 }
@@ -429,7 +452,7 @@ int WebRequestNS::HandleResponseEvent(ResponseEvent event,
 
   v8::Isolate* isolate = v8::Isolate::GetCurrent();
   v8::HandleScope handle_scope(isolate);
-  gin::Dictionary details(isolate, v8::Object::New(isolate));
+  gin_helper::Dictionary details(isolate, CreateDetails(isolate));
   FillDetails(&details, request_info, args...);
 
   ResponseCallback response =
@@ -19,6 +19,22 @@ namespace mate {
 namespace {
 
 v8::Persistent<v8::ObjectTemplate> event_template;
+v8::Persistent<v8::Function> default_emit;
+v8::Persistent<v8::String> emit_key;
+v8::Persistent<v8::String> events_key;
+
+internal::EmitStats emit_stats;
+
+v8::Local<v8::String> GetKey(v8::Isolate* isolate,
+                             v8::Persistent<v8::String>* key,
+                             const char* name) {
+  if (key->IsEmpty()) {
+    key->Reset(isolate, v8::String::NewFromUtf8(isolate, name,
+                                                v8::NewStringType::kInternalized)
+                            .ToLocalChecked());
+  }
+  return v8::Local<v8::String>::New(isolate, *key);
+}
 
 void PreventDefault(mate::Arguments* args) {
   mate::Dictionary self(args->isolate(), args->GetThis());
@@ -98,6 +114,51 @@ v8::Local<v8::Object> CreateEventFromFlags(v8::Isolate* isolate, int flags) {
   return obj.GetHandle();
 }
 
+bool ShouldEmit(v8::Isolate* isolate,
+                v8::Local<v8::Object> object,
+                base::StringPiece name) {
+  emit_stats.emits++;
+  // EventEmitter throws when there is no listener for "error".
+  if (object.IsEmpty() || default_emit.IsEmpty() || name == "error")
+    return true;
+
+  auto context = isolate->GetCurrentContext();
+  v8::Local<v8::Value> emit;
+  if (!object->Get(context, GetKey(isolate, &emit_key, "emit"))
+           .ToLocal(&emit) ||
+      emit != v8::Local<v8::Function>::New(isolate, default_emit))
+    return true;
+
+  // EventEmitter keeps its listeners in the |_events| dictionary.
+  v8::Local<v8::Value> events;
+  if (!object->Get(context, GetKey(isolate, &events_key, "_events"))
+           .ToLocal(&events))
+    return true;
+  if (events->IsObject()) {
+    v8::Local<v8::Value> listeners;
+    v8::Local<v8::String> key =
+        v8::String::NewFromUtf8(isolate, name.data(),
+                                v8::NewStringType::kInternalized, name.size())
+            .ToLocalChecked();
+    if (!events.As<v8::Object>()->Get(context, key).ToLocal(&listeners) ||
+        !listeners->IsUndefined())
+      return true;
+  } else if (!events->IsUndefined()) {
+    return true;
+  }
+
+  emit_stats.skipped++;
+  return false;
+}
+
+void SetDefaultEmit(v8::Isolate* isolate, v8::Local<v8::Function> emit) {
+  default_emit.Reset(isolate, emit);
+}
+
+EmitStats GetEmitStats() {
+  return emit_stats;
+}
+
 }  // namespace internal
 
 }  // namespace mate
@@ -5,10 +5,12 @@
 #ifndef SHELL_BROWSER_API_EVENT_EMITTER_H_
 #define SHELL_BROWSER_API_EVENT_EMITTER_H_
 
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 #include "base/optional.h"
+#include "base/strings/string_piece.h"
 #include "content/public/browser/browser_thread.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "native_mate/wrappable.h"
@@ -34,6 +36,24 @@ v8::Local<v8::Object> CreateCustomEvent(v8::Isolate* isolate,
                                         v8::Local<v8::Object> event);
 v8::Local<v8::Object> CreateEventFromFlags(v8::Isolate* isolate, int flags);
 
+// Returns false when emitting |name| on |object| is known to do nothing, that
+// is when |object| uses the default EventEmitter.prototype.emit and has no
+// listener for |name|. This lets the callers skip creating the event and
+// converting the arguments.
+bool ShouldEmit(v8::Isolate* isolate,
+                v8::Local<v8::Object> object,
+                base::StringPiece name);
+
+// Sets the function ShouldEmit() considers to be the default emit().
+void SetDefaultEmit(v8::Isolate* isolate, v8::Local<v8::Function> emit);
+
+// Number of emits checked by ShouldEmit() and how many of them were skipped.
+struct EmitStats {
+  uint64_t emits = 0;
+  uint64_t skipped = 0;
+};
+EmitStats GetEmitStats();
+
 }  // namespace internal
 
 // Provide helperers to emit event in JavaScript.
@@ -57,6 +77,10 @@ class EventEmitter : public Wrappable<T> {
   bool EmitCustomEvent(base::StringPiece name,
                        v8::Local<v8::Object> event,
                        Args&&... args) {
+    v8::Locker locker(isolate());
+    v8::HandleScope handle_scope(isolate());
+    if (!internal::ShouldEmit(isolate(), GetWrapper(), name))
+      return false;
     return EmitWithEvent(
         name, internal::CreateCustomEvent(isolate(), GetWrapper(), event),
         std::forward<Args>(args)...);
@@ -65,9 +89,16 @@ class EventEmitter : public Wrappable<T> {
   // this.emit(name, new Event(flags), args...);
   template <typename... Args>
   bool EmitWithFlags(base::StringPiece name, int flags, Args&&... args) {
-    return EmitCustomEvent(name,
-                           internal::CreateEventFromFlags(isolate(), flags),
-                           std::forward<Args>(args)...);
+    v8::Locker locker(isolate());
+    v8::HandleScope handle_scope(isolate());
+    if (!internal::ShouldEmit(isolate(), GetWrapper(), name))
+      return false;
+    return EmitWithEvent(
+        name,
+        internal::CreateCustomEvent(
+            isolate(), GetWrapper(),
+            internal::CreateEventFromFlags(isolate(), flags)),
+        std::forward<Args>(args)...);
   }
 
   // this.emit(name, new Event(), args...);
@@ -92,6 +123,9 @@ class EventEmitter : public Wrappable<T> {
     if (wrapper.IsEmpty()) {
       return false;
     }
+    // A pending reply has to be handed to an event, even if nobody listens.
+    if (!callback && !internal::ShouldEmit(isolate(), wrapper, name))
+      return false;
     v8::Local<v8::Object> event = internal::CreateJSEvent(
         isolate(), wrapper, sender, std::move(callback));
     return EmitWithEvent(name, event, std::forward<Args>(args)...);
@@ -4,13 +4,19 @@
 
 #include "shell/browser/api/frame_subscriber.h"
 
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_widget_host.h"
 #include "content/public/browser/render_widget_host_view.h"
+#include "media/base/video_frame.h"
 #include "media/capture/mojom/video_capture_types.mojom.h"
+#include "native_mate/dictionary.h"
 #include "shell/common/native_mate_converters/gfx_converter.h"
+#include "shell/common/native_mate_converters/image_converter.h"
+#include "shell/common/node_includes.h"
 #include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image.h"
 #include "ui/gfx/skbitmap_operations.h"
@@ -19,14 +25,31 @@ namespace electron {
 
 namespace api {
 
-constexpr static int kMaxFrameRate = 30;
+namespace {
+
+// Chroma samples cover 2x2 pixels, so an I420 area has to start on an even
+// pixel and cover an even number of them, unless it ends on the edge of
+// |bounds|.
+gfx::Rect AlignToChroma(const gfx::Rect& rect, const gfx::Rect& bounds) {
+  int x = bounds.x() + ((rect.x() - bounds.x()) & ~1);
+  int y = bounds.y() + ((rect.y() - bounds.y()) & ~1);
+  int right = std::min(x + ((rect.right() - x + 1) & ~1), bounds.right());
+  int bottom = std::min(y + ((rect.bottom() - y + 1) & ~1), bounds.bottom());
+  return gfx::Rect(x, y, right - x, bottom - y);
+}
+
+}  // namespace
 
-FrameSubscriber::FrameSubscriber(content::WebContents* web_contents,
+FrameSubscriber::FrameSubscriber(v8::Isolate* isolate,
+                                 content::WebContents* web_contents,
                                  const FrameCaptureCallback& callback,
-                                 bool only_dirty)
+                                 bool only_dirty,
+                                 const FrameCaptureOptions& options)
     : content::WebContentsObserver(web_contents),
+      isolate_(isolate),
       callback_(callback),
       only_dirty_(only_dirty),
+      options_(options),
       weak_ptr_factory_(this) {
   content::RenderViewHost* rvh = web_contents->GetRenderViewHost();
   if (rvh)
@@ -46,13 +69,7 @@ void FrameSubscriber::AttachToHost(content::RenderWidgetHost* host) {
   // Create and configure the video capturer.
   gfx::Size size = GetRenderViewSize();
   video_capturer_ = host_->GetView()->CreateVideoCapturer();
-  video_capturer_->SetResolutionConstraints(size, size, true);
-  video_capturer_->SetAutoThrottlingEnabled(false);
-  video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB,
-                             gfx::ColorSpace::CreateREC709());
-  video_capturer_->SetMinCapturePeriod(base::TimeDelta::FromSeconds(1) /
-                                       kMaxFrameRate);
+  options_.Apply(video_capturer_.get(), size);
   video_capturer_->Start(this);
 }
 
@@ -88,8 +105,8 @@ void FrameSubscriber::OnFrameCaptured(
     const gfx::Rect& content_rect,
     viz::mojom::FrameSinkVideoConsumerFrameCallbacksPtr callbacks) {
   gfx::Size size = GetRenderViewSize();
-  if (size != content_rect.size()) {
-    video_capturer_->SetResolutionConstraints(size, size, true);
+  if (!options_.MatchesFrameSize(content_rect.size(), size)) {
+    options_.ApplyFrameSize(video_capturer_.get(), size);
     video_capturer_->RequestRefreshFrame();
     return;
   }
@@ -109,6 +126,13 @@ void FrameSubscriber::OnFrameCaptured(
     return;
   }
 
+  if (info->pixel_format == media::PIXEL_FORMAT_I420) {
+    DoneI420(content_rect, mapping, *info, content_rect);
+    // Lets the capturer reuse the buffer.
+    callbacks->Done();
+    return;
+  }
+
   // The SkBitmap's pixels will be marked as immutable, but the installPixels()
   // API requires a non-const pointer. So, cast away the const.
   void* const pixels = const_cast<void*>(mapping.memory());
@@ -162,7 +186,60 @@ void FrameSubscriber::Done(const gfx::Rect& damage, const SkBitmap& frame) {
   bool success = bitmap.peekPixels(&pixmap) && copy.writePixels(pixmap, 0, 0);
   CHECK(success);
 
-  callback_.Run(gfx::Image::CreateFrom1xBitmap(copy), damage);
+  v8::Locker locker(isolate_);
+  v8::HandleScope handle_scope(isolate_);
+  callback_.Run(
+      mate::ConvertToV8(isolate_, gfx::Image::CreateFrom1xBitmap(copy)),
+      damage);
+}
+
+void FrameSubscriber::DoneI420(const gfx::Rect& damage,
+                               const base::ReadOnlySharedMemoryMapping& mapping,
+                               const media::mojom::VideoFrameInfo& info,
+                               const gfx::Rect& content_rect) {
+  gfx::Rect rect = only_dirty_ ? gfx::IntersectRects(damage, content_rect)
+                               : content_rect;
+  rect = AlignToChroma(rect, content_rect);
+  if (rect.IsEmpty())
+    return;
+
+  v8::Locker locker(isolate_);
+  v8::HandleScope handle_scope(isolate_);
+
+  // Copies the planes of |rect| next to each other, without padding.
+  const size_t kPlanes[] = {media::VideoFrame::kYPlane,
+                            media::VideoFrame::kUPlane,
+                            media::VideoFrame::kVPlane};
+  const int uv_width = (rect.width() + 1) / 2;
+  const int uv_height = (rect.height() + 1) / 2;
+  const size_t size =
+      rect.width() * rect.height() + 2 * uv_width * uv_height;
+  v8::Local<v8::Object> buffer =
+      node::Buffer::New(isolate_, size).ToLocalChecked();
+  char* dest = node::Buffer::Data(buffer);
+  const char* src = static_cast<const char*>(mapping.memory());
+  for (size_t plane : kPlanes) {
+    const size_t stride = media::VideoFrame::RowBytes(
+        plane, info.pixel_format, info.coded_size.width());
+    const size_t rows = media::VideoFrame::Rows(plane, info.pixel_format,
+                                                info.coded_size.height());
+    const int shift = plane == media::VideoFrame::kYPlane ? 0 : 1;
+    const int x = rect.x() >> shift;
+    const int y = rect.y() >> shift;
+    const int width = shift ? uv_width : rect.width();
+    const int height = shift ? uv_height : rect.height();
+    for (int row = 0; row < height; ++row) {
+      memcpy(dest, src + (y + row) * stride + x, width);
+      dest += width;
+    }
+    src += stride * rows;
+  }
+
+  mate::Dictionary frame = mate::Dictionary::CreateEmpty(isolate_);
+  frame.Set("format", "i420");
+  frame.Set("size", rect.size());
+  frame.Set("data", buffer);
+  callback_.Run(frame.GetHandle(), rect);
 }
 
 gfx::Size FrameSubscriber::GetRenderViewSize() const {
@@ -12,12 +12,9 @@
 #include "components/viz/host/client_frame_sink_video_capturer.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_contents_observer.h"
+#include "shell/browser/frame_capture_options.h"
 #include "v8/include/v8.h"
 
-namespace gfx {
-class Image;
-}
-
 namespace electron {
 
 namespace api {
@@ -27,12 +24,16 @@ class WebContents;
 class FrameSubscriber : public content::WebContentsObserver,
                         public viz::mojom::FrameSinkVideoConsumer {
  public:
+  // Gets a NativeImage for ARGB frames, and an object holding the planes for
+  // I420 frames.
   using FrameCaptureCallback =
-      base::RepeatingCallback<void(const gfx::Image&, const gfx::Rect&)>;
+      base::RepeatingCallback<void(v8::Local<v8::Value>, const gfx::Rect&)>;
 
-  FrameSubscriber(content::WebContents* web_contents,
+  FrameSubscriber(v8::Isolate* isolate,
+                  content::WebContents* web_contents,
                   const FrameCaptureCallback& callback,
-                  bool only_dirty);
+                  bool only_dirty,
+                  const FrameCaptureOptions& options);
   ~FrameSubscriber() override;
 
  private:
@@ -53,12 +54,18 @@ class FrameSubscriber : public content::WebContentsObserver,
   void OnStopped() override;
 
   void Done(const gfx::Rect& damage, const SkBitmap& frame);
+  void DoneI420(const gfx::Rect& damage,
+                const base::ReadOnlySharedMemoryMapping& mapping,
+                const media::mojom::VideoFrameInfo& info,
+                const gfx::Rect& content_rect);
 
   // Get the pixel size of render view.
   gfx::Size GetRenderViewSize() const;
 
+  v8::Isolate* isolate_;
   FrameCaptureCallback callback_;
   bool only_dirty_;
+  FrameCaptureOptions options_;
 
   content::RenderWidgetHost* host_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -5,10 +5,21 @@
 #include "shell/browser/api/process_metric.h"
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/optional.h"
 
+#if defined(OS_LINUX)
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/threading/thread_restrictions.h"
+#endif
+
 #if defined(OS_WIN)
 #include <windows.h>
 
@@ -48,6 +59,44 @@ base::Optional<mach_task_basic_info_data_t> GetTaskInfo(mach_port_t task) {
 
 #endif  // defined(OS_MACOSX)
 
+#if defined(OS_LINUX)
+
+namespace {
+
+bool ReadProcFile(base::ProcessId pid,
+                  base::StringPiece name,
+                  std::string* contents) {
+  // Synchronously reading files in /proc is safe.
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::FilePath path = base::FilePath("/proc")
+                            .Append(base::NumberToString(pid))
+                            .Append(name);
+  return base::ReadFileToString(path, contents);
+}
+
+// Returns the value of the "Name:   1234 kB" line |name| in |contents|, in
+// kilobytes, or 0 when it is missing.
+size_t GetProcFieldKB(base::StringPiece contents, base::StringPiece name) {
+  for (base::StringPiece line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (!line.starts_with(name) || line.size() <= name.size() ||
+        line[name.size()] != ':')
+      continue;
+    std::vector<base::StringPiece> tokens = base::SplitStringPiece(
+        line.substr(name.size() + 1), " \t", base::TRIM_WHITESPACE,
+        base::SPLIT_WANT_NONEMPTY);
+    size_t value = 0;
+    if (!tokens.empty() && base::StringToSizeT(tokens[0], &value))
+      return value;
+    return 0;
+  }
+  return 0;
+}
+
+}  // namespace
+
+#endif  // defined(OS_LINUX)
+
 namespace electron {
 
 ProcessMetric::ProcessMetric(int type,
@@ -163,6 +212,46 @@ bool ProcessMetric::IsSandboxed() const {
 #endif
 }
 
-#endif  // defined(OS_MACOSX)
+#elif defined(OS_LINUX)
+
+ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
+  ProcessMemoryInfo result;
+
+  std::string status;
+  if (ReadProcFile(process.Pid(), "status", &status)) {
+    result.working_set_size = GetProcFieldKB(status, "VmRSS") << 10;
+    result.peak_working_set_size = GetProcFieldKB(status, "VmHWM") << 10;
+  }
+
+  return result;
+}
+
+ProcessMemoryInfo ProcessMetric::GetDetailedMemoryInfo() const {
+  ProcessMemoryInfo result;
+
+  // smaps_rollup is only available since Linux 4.14.
+  std::string contents;
+  if (ReadProcFile(process.Pid(), "smaps_rollup", &contents)) {
+    result.working_set_size = GetProcFieldKB(contents, "Rss") << 10;
+    result.proportional_set_size = GetProcFieldKB(contents, "Pss") << 10;
+  } else if (ReadProcFile(process.Pid(), "status", &contents)) {
+    result.working_set_size = GetProcFieldKB(contents, "VmRSS") << 10;
+  }
+
+  return result;
+}
+
+#endif  // defined(OS_LINUX)
+
+int ProcessMetric::GetOpenFdCount() const {
+#if defined(OS_WIN)
+  DWORD handle_count = 0;
+  if (!::GetProcessHandleCount(process.Handle(), &handle_count))
+    return -1;
+  return static_cast<int>(handle_count);
+#else
+  return metrics->GetOpenFdCount();
+#endif
+}
 
 }  // namespace electron
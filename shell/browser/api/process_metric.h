@@ -13,15 +13,15 @@
 
 namespace electron {
 
-#if !defined(OS_LINUX)
 struct ProcessMemoryInfo {
   size_t working_set_size = 0;
   size_t peak_working_set_size = 0;
 #if defined(OS_WIN)
   size_t private_bytes = 0;
+#elif defined(OS_LINUX)
+  size_t proportional_set_size = 0;
 #endif
 };
-#endif
 
 #if defined(OS_WIN)
 enum class ProcessIntegrityLevel {
@@ -43,10 +43,18 @@ struct ProcessMetric {
                 std::unique_ptr<base::ProcessMetrics> metrics);
   ~ProcessMetric();
 
-#if !defined(OS_LINUX)
   ProcessMemoryInfo GetMemoryInfo() const;
+
+#if defined(OS_LINUX)
+  // Like GetMemoryInfo() but also fills in the proportional set size from
+  // /proc/<pid>/smaps_rollup. The peak working set size is not filled in.
+  ProcessMemoryInfo GetDetailedMemoryInfo() const;
 #endif
 
+  // Returns the number of open file descriptors, or handles on Windows, or -1
+  // on error.
+  int GetOpenFdCount() const;
+
 #if defined(OS_WIN)
   ProcessIntegrityLevel GetIntegrityLevel() const;
   static bool IsSandboxed(ProcessIntegrityLevel integrity_level);
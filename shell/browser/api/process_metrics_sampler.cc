@@ -0,0 +1,193 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/process_metrics_sampler.h"
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/system/sys_info.h"
+#include "base/task/post_task.h"
+#include "base/task_runner_util.h"
+#include "base/timer/timer.h"
+#include "base/trace_event/trace_event.h"
+#include "shell/browser/api/process_metric.h"
+
+#if defined(OS_MACOSX)
+#include "content/public/browser/browser_child_process_host.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+using SampleRow = std::array<double, ProcessMetricsSampler::kFieldCount>;
+
+// Fixed-size buffer keeping the latest samples of a process.
+class SampleRing {
+ public:
+  explicit SampleRing(size_t capacity) : samples_(capacity) {}
+
+  void Push(const SampleRow& sample) {
+    samples_[written_ % samples_.size()] = sample;
+    written_++;
+  }
+
+  // Appends the samples pushed since the last call to |out|.
+  void TakeUnread(std::vector<double>* out) {
+    uint64_t begin = std::max<uint64_t>(
+        read_, written_ > samples_.size() ? written_ - samples_.size() : 0);
+    for (uint64_t i = begin; i < written_; ++i) {
+      const SampleRow& sample = samples_[i % samples_.size()];
+      out->insert(out->end(), sample.begin(), sample.end());
+    }
+    read_ = written_;
+  }
+
+ private:
+  std::vector<SampleRow> samples_;
+  uint64_t written_ = 0;
+  uint64_t read_ = 0;
+};
+
+std::unique_ptr<base::ProcessMetrics> CreateMetrics(
+    const base::Process& process) {
+  if (process.Pid() == base::GetCurrentProcId())
+    return base::ProcessMetrics::CreateCurrentProcessMetrics();
+#if defined(OS_MACOSX)
+  return base::ProcessMetrics::CreateProcessMetrics(
+      process.Handle(), content::BrowserChildProcessHost::GetPortProvider());
+#else
+  return base::ProcessMetrics::CreateProcessMetrics(process.Handle());
+#endif
+}
+
+}  // namespace
+
+class ProcessMetricsSampler::Core {
+ public:
+  Core(base::TimeDelta interval, size_t buffer_size)
+      : interval_(interval),
+        buffer_size_(buffer_size),
+        processor_count_(base::SysInfo::NumberOfProcessors()) {}
+
+  void Start() {
+    timer_.Start(FROM_HERE, interval_,
+                 base::BindRepeating(&Core::Sample, base::Unretained(this)));
+  }
+
+  void AddProcess(int type, base::Process process) {
+    base::ProcessId pid = process.Pid();
+    auto metric = std::make_unique<ProcessMetric>(type, process.Handle(),
+                                                  CreateMetrics(process));
+    // The first CPU usage reading only establishes the baseline.
+    metric->metrics->GetPlatformIndependentCPUUsage();
+    processes_.erase(pid);
+    processes_.emplace(
+        pid, Entry{std::move(metric), std::make_unique<SampleRing>(
+                                          buffer_size_)});
+  }
+
+  void RemoveProcess(base::ProcessId pid) { processes_.erase(pid); }
+
+  std::vector<double> TakeSamples() {
+    std::vector<double> result;
+    for (auto& entry : processes_)
+      entry.second.samples->TakeUnread(&result);
+    return result;
+  }
+
+ private:
+  struct Entry {
+    std::unique_ptr<ProcessMetric> metric;
+    std::unique_ptr<SampleRing> samples;
+  };
+
+  void Sample() {
+    TRACE_EVENT1("electron", "ProcessMetricsSampler::Sample", "processes",
+                 processes_.size());
+    double timestamp = base::Time::Now().ToJsTime();
+    for (auto& entry : processes_) {
+      const ProcessMetric& metric = *entry.second.metric;
+      SampleRow sample = {};
+      sample[kPid] = entry.first;
+      sample[kTimestamp] = timestamp;
+      sample[kPercentCPUUsage] =
+          metric.metrics->GetPlatformIndependentCPUUsage() / processor_count_;
+#if !defined(OS_WIN)
+      // Not implemented on Windows, see App::GetAppMetrics.
+      sample[kIdleWakeupsPerSecond] = metric.metrics->GetIdleWakeupsPerSecond();
+#endif
+#if defined(OS_LINUX)
+      ProcessMemoryInfo memory_info = metric.GetDetailedMemoryInfo();
+      sample[kProportionalSetSize] = memory_info.proportional_set_size >> 10;
+#else
+      ProcessMemoryInfo memory_info = metric.GetMemoryInfo();
+#endif
+      sample[kWorkingSetSize] = memory_info.working_set_size >> 10;
+      sample[kOpenFileDescriptors] = metric.GetOpenFdCount();
+      entry.second.samples->Push(sample);
+    }
+  }
+
+  const base::TimeDelta interval_;
+  const size_t buffer_size_;
+  const int processor_count_;
+
+  std::unordered_map<base::ProcessId, Entry> processes_;
+  base::RepeatingTimer timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+ProcessMetricsSampler::ProcessMetricsSampler(base::TimeDelta interval,
+                                             size_t buffer_size)
+    : task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      core_(new Core(interval, buffer_size),
+            base::OnTaskRunnerDeleter(task_runner_)) {
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Core::Start, base::Unretained(core_.get())));
+}
+
+ProcessMetricsSampler::~ProcessMetricsSampler() = default;
+
+// static
+std::vector<const char*> ProcessMetricsSampler::GetFieldNames() {
+  return {"pid",
+          "timestamp",
+          "percentCPUUsage",
+          "idleWakeupsPerSecond",
+          "workingSetSize",
+          "proportionalSetSize",
+          "openFileDescriptors"};
+}
+
+void ProcessMetricsSampler::AddProcess(int type, base::Process process) {
+  // |core_| is deleted on |task_runner_| after every task posted here, so it
+  // is safe to use it unretained.
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Core::AddProcess,
+                                base::Unretained(core_.get()), type,
+                                std::move(process)));
+}
+
+void ProcessMetricsSampler::RemoveProcess(base::ProcessId pid) {
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&Core::RemoveProcess,
+                                        base::Unretained(core_.get()), pid));
+}
+
+void ProcessMetricsSampler::TakeSamples(SamplesCallback callback) {
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&Core::TakeSamples, base::Unretained(core_.get())),
+      std::move(callback));
+}
+
+}  // namespace electron
@@ -0,0 +1,66 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+#define SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/process/process.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+
+namespace electron {
+
+// Periodically samples CPU, memory, idle wakeups and open file descriptors of
+// a set of processes on a background sequence, keeping the most recent
+// samples of each process in a fixed-size ring buffer.
+//
+// All methods must be called on the UI thread.
+class ProcessMetricsSampler {
+ public:
+  // Columns of the sample table returned by TakeSamples(), in order.
+  enum Field {
+    kPid,
+    kTimestamp,
+    kPercentCPUUsage,
+    kIdleWakeupsPerSecond,
+    kWorkingSetSize,
+    kProportionalSetSize,
+    kOpenFileDescriptors,
+    kFieldCount,
+  };
+
+  // Samples flattened row by row, kFieldCount values per sample.
+  using SamplesCallback = base::OnceCallback<void(std::vector<double>)>;
+
+  ProcessMetricsSampler(base::TimeDelta interval, size_t buffer_size);
+  ~ProcessMetricsSampler();
+
+  // Returns the JS names of the fields, indexed by Field.
+  static std::vector<const char*> GetFieldNames();
+
+  void AddProcess(int type, base::Process process);
+  void RemoveProcess(base::ProcessId pid);
+
+  // Replies with every sample taken since the previous call, oldest first for
+  // each process. Samples that were overwritten in the meantime are lost.
+  void TakeSamples(SamplesCallback callback);
+
+ private:
+  class Core;
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  // Lives on |task_runner_|.
+  std::unique_ptr<Core, base::OnTaskRunnerDeleter> core_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMetricsSampler);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_API_PROCESS_METRICS_SAMPLER_H_
@@ -11,7 +11,7 @@
 #include "base/memory/weak_ptr.h"
 #include "native_mate/object_template_builder.h"
 #include "shell/browser/api/event_emitter.h"
-#include "shell/common/key_weak_map.h"
+#include "shell/common/id_weak_map.h"
 
 namespace base {
 class SupportsUserData;
@@ -61,6 +61,8 @@ class TrackableObject : public TrackableObjectBase,
     if (!wrapper.IsEmpty()) {
       wrapper->SetAlignedPointerInInternalField(0, nullptr);
     }
+    if (weak_map_)
+      weak_map_->SetPointer(weak_map_id_, nullptr);
   }
 
   bool IsDestroyed() {
@@ -73,14 +75,8 @@ class TrackableObject : public TrackableObjectBase,
   static T* FromWeakMapID(v8::Isolate* isolate, int32_t id) {
     if (!weak_map_)
       return nullptr;
-
-    v8::MaybeLocal<v8::Object> object = weak_map_->Get(isolate, id);
-    if (object.IsEmpty())
-      return nullptr;
-
-    T* self = nullptr;
-    mate::ConvertFromV8(isolate, object.ToLocalChecked(), &self);
-    return self;
+    // The pointer is cleared when the object is marked as destroyed.
+    return static_cast<T*>(weak_map_->GetPointer(id));
   }
 
   // Finds out the TrackableObject from the class it wraps.
@@ -100,9 +96,22 @@ class TrackableObject : public TrackableObjectBase,
       return std::vector<v8::Local<v8::Object>>();
   }
 
+  // Calls |callback| with each object in this class's weak map that is not
+  // destroyed, without allocating. |callback| must not create or destroy
+  // objects of this class.
+  template <typename Callback>
+  static void ForEach(const Callback& callback) {
+    if (!weak_map_)
+      return;
+    weak_map_->ForEach([&](const electron::IDWeakMap::Entry& entry) {
+      if (entry.pointer)
+        callback(static_cast<T*>(entry.pointer));
+    });
+  }
+
   // Removes this instance from the weak map.
   void RemoveFromWeakMap() {
-    if (weak_map_ && weak_map_->Has(weak_map_id()))
+    if (weak_map_)
       weak_map_->Remove(weak_map_id());
   }
 
@@ -114,14 +123,14 @@ class TrackableObject : public TrackableObjectBase,
   void InitWith(v8::Isolate* isolate, v8::Local<v8::Object> wrapper) override {
     WrappableBase::InitWith(isolate, wrapper);
     if (!weak_map_) {
-      weak_map_ = new electron::KeyWeakMap<int32_t>;
+      weak_map_ = new electron::IDWeakMap;
     }
-    weak_map_->Set(isolate, weak_map_id_, wrapper);
+    weak_map_->Set(isolate, weak_map_id_, wrapper, static_cast<T*>(this));
   }
 
  private:
   static int32_t next_id_;
-  static electron::KeyWeakMap<int32_t>* weak_map_;  // leaked on purpose
+  static electron::IDWeakMap* weak_map_;  // leaked on purpose
 
   DISALLOW_COPY_AND_ASSIGN(TrackableObject);
 };
@@ -130,7 +139,7 @@ template <typename T>
 int32_t TrackableObject<T>::next_id_ = 0;
 
 template <typename T>
-electron::KeyWeakMap<int32_t>* TrackableObject<T>::weak_map_ = nullptr;
+electron::IDWeakMap* TrackableObject<T>::weak_map_ = nullptr;
 
 }  // namespace mate
 
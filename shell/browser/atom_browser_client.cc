@@ -301,14 +301,7 @@ std::string AtomBrowserClient::GetAffinityPreference(
     content::RenderFrameHost* rfh) const {
   auto* web_contents = content::WebContents::FromRenderFrameHost(rfh);
   auto* web_preferences = WebContentsPreferences::From(web_contents);
-  std::string affinity;
-  if (web_preferences &&
-      web_preferences->GetPreference("affinity", &affinity) &&
-      !affinity.empty()) {
-    affinity = base::ToLowerASCII(affinity);
-  }
-
-  return affinity;
+  return web_preferences ? web_preferences->parsed().affinity : std::string();
 }
 
 content::SiteInstance* AtomBrowserClient::GetSiteInstanceFromAffinity(
@@ -361,12 +354,11 @@ void AtomBrowserClient::RenderProcessWillLaunch(
   auto* web_preferences =
       WebContentsPreferences::From(GetWebContentsFromProcessID(process_id));
   if (web_preferences) {
-    prefs.sandbox = web_preferences->IsEnabled(options::kSandbox);
-    prefs.native_window_open =
-        web_preferences->IsEnabled(options::kNativeWindowOpen);
-    prefs.disable_popups = web_preferences->IsEnabled("disablePopups");
-    prefs.web_security = web_preferences->IsEnabled(options::kWebSecurity,
-                                                    true /* default value */);
+    const auto& parsed = web_preferences->parsed();
+    prefs.sandbox = parsed.sandbox;
+    prefs.native_window_open = parsed.native_window_open;
+    prefs.disable_popups = parsed.disable_popups;
+    prefs.web_security = parsed.web_security;
   }
 
   host->AddFilter(new ElectronRenderMessageFilter(host->GetBrowserContext()));
@@ -185,6 +185,26 @@ void AtomBrowserContext::InitPrefs() {
 #endif
 }
 
+PartitionPrefStore* AtomBrowserContext::GetPartitionPrefStore(
+    const base::FilePath& partition_path) {
+  auto& store = partition_pref_stores_[partition_path];
+  if (!store)
+    store = std::make_unique<PartitionPrefStore>(partition_path);
+  return store.get();
+}
+
+PartitionPrefStore::Stats AtomBrowserContext::GetPartitionPrefStats() const {
+  PartitionPrefStore::Stats stats;
+  for (const auto& it : partition_pref_stores_)
+    stats += it.second->stats();
+  return stats;
+}
+
+void AtomBrowserContext::CommitPartitionPrefs() {
+  for (const auto& it : partition_pref_stores_)
+    it.second->CommitPendingWrite();
+}
+
 void AtomBrowserContext::SetUserAgent(const std::string& user_agent) {
   user_agent_ = user_agent;
 }
@@ -221,7 +241,8 @@ std::unique_ptr<content::ZoomLevelDelegate>
 AtomBrowserContext::CreateZoomLevelDelegate(
     const base::FilePath& partition_path) {
   if (!IsOffTheRecord()) {
-    return std::make_unique<ZoomLevelDelegate>(prefs(), partition_path);
+    return std::make_unique<ZoomLevelDelegate>(
+        prefs(), GetPartitionPrefStore(partition_path), partition_path);
   }
   return std::unique_ptr<content::ZoomLevelDelegate>();
 }
@@ -19,6 +19,7 @@
 #include "electron/buildflags/buildflags.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
 #include "shell/browser/media/media_device_id_salt.h"
+#include "shell/browser/partition_pref_store.h"
 
 class PrefRegistrySimple;
 class PrefService;
@@ -128,6 +129,16 @@ class AtomBrowserContext
     return proxy_config_monitor_.get();
   }
   PrefService* prefs() const { return prefs_.get(); }
+
+  // Returns the store for the preferences of the storage partition at
+  // |partition_path|, creating it on first use.
+  PartitionPrefStore* GetPartitionPrefStore(
+      const base::FilePath& partition_path);
+  // Sums the write statistics of the partition stores.
+  PartitionPrefStore::Stats GetPartitionPrefStats() const;
+  // Starts writing the pending changes of the partition stores.
+  void CommitPartitionPrefs();
+
   void set_in_memory_pref_store(ValueMapPrefStore* pref_store) {
     in_memory_pref_store_ = pref_store;
   }
@@ -158,6 +169,8 @@ class AtomBrowserContext
   std::unique_ptr<content::ResourceContext> resource_context_;
   std::unique_ptr<CookieChangeNotifier> cookie_change_notifier_;
   std::unique_ptr<PrefService> prefs_;
+  std::map<base::FilePath, std::unique_ptr<PartitionPrefStore>>
+      partition_pref_stores_;
   std::unique_ptr<AtomDownloadManagerDelegate> download_manager_delegate_;
   std::unique_ptr<WebViewManager> guest_manager_;
   std::unique_ptr<AtomPermissionManager> permission_manager_;
@@ -14,7 +14,6 @@
 #include "shell/browser/native_window.h"
 #include "shell/browser/ui/message_box.h"
 #include "shell/browser/web_contents_preferences.h"
-#include "shell/common/options_switches.h"
 #include "ui/gfx/image/image_skia.h"
 
 using content::JavaScriptDialogType;
@@ -78,14 +77,14 @@ void AtomJavaScriptDialogManager::RunJavaScriptDialog(
   auto* web_preferences = WebContentsPreferences::From(web_contents);
   std::string checkbox;
   if (origin_counts_[origin] > 1 && web_preferences &&
-      web_preferences->IsEnabled("safeDialogs") &&
-      !web_preferences->GetPreference("safeDialogsMessage", &checkbox)) {
-    checkbox = "Prevent this app from creating additional dialogs";
+      web_preferences->parsed().safe_dialogs) {
+    checkbox = web_preferences->parsed().safe_dialogs_message.value_or(
+        "Prevent this app from creating additional dialogs");
   }
 
   // Don't set parent for offscreen window.
   NativeWindow* window = nullptr;
-  if (web_preferences && !web_preferences->IsEnabled(options::kOffscreen)) {
+  if (web_preferences && !web_preferences->parsed().offscreen) {
     auto* relay = NativeWindowRelay::FromWebContents(web_contents);
     if (relay)
       window = relay->GetNativeWindow();
@@ -38,7 +38,6 @@
 #include "shell/browser/web_contents_preferences.h"
 #include "shell/browser/web_dialog_helper.h"
 #include "shell/common/atom_constants.h"
-#include "shell/common/options_switches.h"
 #include "storage/browser/fileapi/isolated_context.h"
 
 #if BUILDFLAG(ENABLE_COLOR_CHOOSER)
@@ -200,8 +199,7 @@ void CommonWebContentsDelegate::InitWithWebContents(
 
   // Determien whether the WebContents is offscreen.
   auto* web_preferences = WebContentsPreferences::From(web_contents);
-  offscreen_ =
-      web_preferences && web_preferences->IsEnabled(options::kOffscreen);
+  offscreen_ = web_preferences && web_preferences->parsed().offscreen;
 
   // Create InspectableWebContents.
   web_contents_.reset(InspectableWebContents::Create(
@@ -630,9 +628,9 @@ void CommonWebContentsDelegate::SetHtmlApiFullscreen(bool enter_fullscreen) {
   // Set fullscreen on window if allowed.
   auto* web_preferences = WebContentsPreferences::From(GetWebContents());
   bool html_fullscreenable =
-      web_preferences ? !web_preferences->IsEnabled(
-                            options::kDisableHtmlFullscreenWindowResize)
-                      : true;
+      web_preferences
+          ? !web_preferences->parsed().disable_html_fullscreen_window_resize
+          : true;
 
   if (html_fullscreenable) {
     owner_window_->SetFullScreen(enter_fullscreen);
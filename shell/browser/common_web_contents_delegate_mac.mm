@@ -32,8 +32,7 @@ bool CommonWebContentsDelegate::HandleKeyboardEvent(
 
   // Check if the webContents has preferences and to ignore shortcuts
   auto* web_preferences = WebContentsPreferences::From(source);
-  if (web_preferences &&
-      web_preferences->IsEnabled("ignoreMenuShortcuts", false))
+  if (web_preferences && web_preferences->parsed().ignore_menu_shortcuts)
     return false;
 
   // Send the event to the menu before sending it to the window
@@ -0,0 +1,61 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/frame_capture_options.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "components/viz/host/client_frame_sink_video_capturer.h"
+#include "ui/gfx/color_space.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+namespace electron {
+
+gfx::Size FrameCaptureOptions::GetFrameSize(const gfx::Size& view_size) const {
+  if (view_size.IsEmpty())
+    return view_size;
+
+  float scale = scale_factor;
+  if (!max_size.IsEmpty()) {
+    scale = std::min({scale,
+                      static_cast<float>(max_size.width()) / view_size.width(),
+                      static_cast<float>(max_size.height()) /
+                          view_size.height()});
+  }
+  gfx::Size size = gfx::ScaleToRoundedSize(view_size, scale);
+  size.SetToMax(gfx::Size(1, 1));
+  return size;
+}
+
+bool FrameCaptureOptions::MatchesFrameSize(const gfx::Size& content_size,
+                                           const gfx::Size& view_size) const {
+  gfx::Size frame_size = GetFrameSize(view_size);
+  return std::abs(frame_size.width() - content_size.width()) <= 2 &&
+         std::abs(frame_size.height() - content_size.height()) <= 2;
+}
+
+void FrameCaptureOptions::Apply(viz::ClientFrameSinkVideoCapturer* capturer,
+                                const gfx::Size& view_size) const {
+  capturer->SetAutoThrottlingEnabled(false);
+  capturer->SetMinSizeChangePeriod(base::TimeDelta());
+  capturer->SetFormat(pixel_format, gfx::ColorSpace::CreateREC709());
+  ApplyFrameSize(capturer, view_size);
+  ApplyFrameRate(capturer);
+}
+
+void FrameCaptureOptions::ApplyFrameSize(
+    viz::ClientFrameSinkVideoCapturer* capturer,
+    const gfx::Size& view_size) const {
+  gfx::Size size = GetFrameSize(view_size);
+  capturer->SetResolutionConstraints(size, size, true);
+}
+
+void FrameCaptureOptions::ApplyFrameRate(
+    viz::ClientFrameSinkVideoCapturer* capturer) const {
+  capturer->SetMinCapturePeriod(base::TimeDelta::FromSeconds(1) /
+                                max_frame_rate);
+}
+
+}  // namespace electron
@@ -0,0 +1,47 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_FRAME_CAPTURE_OPTIONS_H_
+#define SHELL_BROWSER_FRAME_CAPTURE_OPTIONS_H_
+
+#include "media/base/video_types.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace viz {
+class ClientFrameSinkVideoCapturer;
+}
+
+namespace electron {
+
+// What the frames captured from a view look like: their pixel format, the
+// size they are scaled to and how often they are captured. The scaling and
+// the conversion are done by the capturer in viz, before the frames reach
+// the browser process.
+struct FrameCaptureOptions {
+  media::VideoPixelFormat pixel_format = media::PIXEL_FORMAT_ARGB;
+  // Frames are scaled by |scale_factor|, then scaled down further to fit
+  // into |max_size| unless it is empty.
+  double scale_factor = 1.0;
+  gfx::Size max_size;
+  int max_frame_rate = 30;
+
+  // The size of the frames captured from a view of |view_size| pixels.
+  gfx::Size GetFrameSize(const gfx::Size& view_size) const;
+
+  // Whether |content_size| is the size of the frames for |view_size|, give
+  // or take the pixel lost when keeping the aspect ratio.
+  bool MatchesFrameSize(const gfx::Size& content_size,
+                        const gfx::Size& view_size) const;
+
+  // Configures |capturer| for a view of |view_size| pixels.
+  void Apply(viz::ClientFrameSinkVideoCapturer* capturer,
+             const gfx::Size& view_size) const;
+  void ApplyFrameSize(viz::ClientFrameSinkVideoCapturer* capturer,
+                      const gfx::Size& view_size) const;
+  void ApplyFrameRate(viz::ClientFrameSinkVideoCapturer* capturer) const;
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_FRAME_CAPTURE_OPTIONS_H_
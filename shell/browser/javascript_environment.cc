@@ -16,6 +16,7 @@
 #include "gin/array_buffer.h"
 #include "gin/v8_initializer.h"
 #include "shell/browser/microtasks_runner.h"
+#include "shell/common/gin_helper/key_cache.h"
 #include "shell/common/node_includes.h"
 #include "tracing/trace_event.h"
 
@@ -77,6 +78,7 @@ void JavascriptEnvironment::OnMessageLoopDestroying() {
   base::MessageLoopCurrent::Get()->RemoveTaskObserver(microtasks_runner_.get());
   platform_->DrainTasks(isolate_);
   platform_->UnregisterIsolate(isolate_);
+  gin_helper::ClearKeyCache(isolate_);
 }
 
 NodeEnvironment::NodeEnvironment(node::Environment* env) : env_(env) {}
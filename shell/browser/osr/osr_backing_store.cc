@@ -0,0 +1,110 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_backing_store.h"
+
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "base/stl_util.h"
+
+namespace electron {
+
+namespace {
+
+// One bitmap being written, one kept by the consumer of the last frame and
+// one spare for a consumer that is slow to release its frame.
+const size_t kMaxBuffers = 3;
+
+}  // namespace
+
+OffScreenBackingStore::OffScreenBackingStore(bool opaque) : opaque_(opaque) {}
+
+OffScreenBackingStore::~OffScreenBackingStore() = default;
+
+gfx::Rect OffScreenBackingStore::BeginFrame(const gfx::Size& size,
+                                            const gfx::Rect& damage_rect) {
+  ++stats_.frames;
+  if (size.IsEmpty()) {
+    buffers_.clear();
+    return gfx::Rect();
+  }
+
+  gfx::Rect damage = gfx::IntersectRects(damage_rect, gfx::Rect(size));
+  for (auto& buffer : buffers_)
+    buffer.stale_rect.Union(damage);
+
+  current_ = AcquireBuffer(size);
+  gfx::Rect dirty_rect = buffers_[current_].stale_rect;
+  buffers_[current_].stale_rect = gfx::Rect();
+  return dirty_rect;
+}
+
+void OffScreenBackingStore::CopyRect(const SkBitmap& src,
+                                     const gfx::Point& origin,
+                                     const gfx::Rect& rect) {
+  if (buffers_.empty() || src.drawsNothing())
+    return;
+
+  SkBitmap& dst = buffers_[current_].bitmap;
+  gfx::Rect copy_rect = gfx::IntersectRects(
+      rect, gfx::Rect(origin, gfx::Size(src.width(), src.height())));
+  copy_rect.Intersect(gfx::Rect(dst.width(), dst.height()));
+  if (copy_rect.IsEmpty())
+    return;
+
+  SkImageInfo info = dst.info().makeWH(copy_rect.width(), copy_rect.height());
+  if (src.readPixels(info, dst.getAddr32(copy_rect.x(), copy_rect.y()),
+                     dst.rowBytes(), copy_rect.x() - origin.x(),
+                     copy_rect.y() - origin.y())) {
+    stats_.bytes_copied += info.computeMinByteSize();
+  }
+}
+
+const SkBitmap& OffScreenBackingStore::current() const {
+  static const base::NoDestructor<SkBitmap> empty;
+  return buffers_.empty() ? *empty : buffers_[current_].bitmap;
+}
+
+void OffScreenBackingStore::Reset() {
+  buffers_.clear();
+}
+
+size_t OffScreenBackingStore::AcquireBuffer(const gfx::Size& size) {
+  base::EraseIf(buffers_, [&size](const Buffer& buffer) {
+    return buffer.bitmap.width() != size.width() ||
+           buffer.bitmap.height() != size.height();
+  });
+
+  // Among the buffers nobody else references, pick the one with the least to
+  // copy.
+  size_t best = buffers_.size();
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    if (!buffers_[i].bitmap.pixelRef()->unique())
+      continue;
+    if (best == buffers_.size() ||
+        buffers_[i].stale_rect.size().GetArea() <
+            buffers_[best].stale_rect.size().GetArea())
+      best = i;
+  }
+  if (best != buffers_.size())
+    return best;
+
+  Buffer buffer;
+  buffer.bitmap.allocN32Pixels(size.width(), size.height(), opaque_);
+  buffer.stale_rect = gfx::Rect(size);
+  stats_.bytes_allocated += buffer.bitmap.computeByteSize();
+  if (buffers_.size() < kMaxBuffers) {
+    buffers_.push_back(std::move(buffer));
+    return buffers_.size() - 1;
+  }
+
+  // Every buffer is still referenced. Replace one other than the last written,
+  // its consumers keep the pixels alive for as long as they need them.
+  size_t index = (current_ + 1) % buffers_.size();
+  buffers_[index] = std::move(buffer);
+  return index;
+}
+
+}  // namespace electron
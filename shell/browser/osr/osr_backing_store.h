@@ -0,0 +1,78 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_OSR_OSR_BACKING_STORE_H_
+#define SHELL_BROWSER_OSR_OSR_BACKING_STORE_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace electron {
+
+// A small ring of bitmaps that the frames of an offscreen view are written
+// to.
+//
+// Consumers may keep the bitmap of a frame, like the video encoder does while
+// it encodes the frame or the NativeImage emitted with 'paint' does until it
+// is collected, so a bitmap is only written to again once nothing else
+// references its pixels; meanwhile another bitmap of the ring is used. Each
+// bitmap tracks the area that changed since it was last written, so that a
+// new frame only copies that area instead of the whole frame.
+class OffScreenBackingStore {
+ public:
+  struct Stats {
+    uint64_t frames = 0;
+    uint64_t bytes_copied = 0;
+    uint64_t bytes_allocated = 0;
+  };
+
+  explicit OffScreenBackingStore(bool opaque);
+  ~OffScreenBackingStore();
+
+  // Starts a frame of |size| in which |damage_rect| changed since the last
+  // frame. Returns the area of current() that must be written, the rest of it
+  // already holds the pixels of the last frame.
+  gfx::Rect BeginFrame(const gfx::Size& size, const gfx::Rect& damage_rect);
+
+  // Copies the pixels of |src| that are inside |rect| to current(), with
+  // |src| placed at |origin|.
+  void CopyRect(const SkBitmap& src,
+                const gfx::Point& origin,
+                const gfx::Rect& rect);
+
+  // The bitmap of the last frame. Null before the first frame.
+  const SkBitmap& current() const;
+
+  // Drops the bitmaps, the next frame is written in full.
+  void Reset();
+
+  const Stats& stats() const { return stats_; }
+
+ private:
+  struct Buffer {
+    SkBitmap bitmap;
+    // The area that differs from the last frame.
+    gfx::Rect stale_rect;
+  };
+
+  // Returns the index of a buffer of |size| that can be written to,
+  // allocating one if needed.
+  size_t AcquireBuffer(const gfx::Size& size);
+
+  const bool opaque_;
+  std::vector<Buffer> buffers_;
+  size_t current_ = 0;
+  Stats stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenBackingStore);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_OSR_OSR_BACKING_STORE_H_
@@ -0,0 +1,105 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_begin_frame_timer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/task/post_task.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace electron {
+
+// static
+AtomBeginFrameTimer* AtomBeginFrameTimer::Get() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  static base::NoDestructor<AtomBeginFrameTimer> instance;
+  return instance.get();
+}
+
+AtomBeginFrameTimer::AtomBeginFrameTimer()
+    : time_source_(std::make_unique<viz::DelayBasedTimeSource>(
+          base::CreateSingleThreadTaskRunnerWithTraits(
+              {content::BrowserThread::UI})
+              .get())) {
+  time_source_->SetClient(this);
+}
+
+AtomBeginFrameTimer::~AtomBeginFrameTimer() = default;
+
+void AtomBeginFrameTimer::SetInterval(Client* client,
+                                      base::TimeDelta interval) {
+  DCHECK_GT(interval, base::TimeDelta());
+  ClientState& state = clients_[client];
+  if (state.interval == interval)
+    return;
+  state.interval = interval;
+  if (state.active)
+    UpdateTimeSource();
+}
+
+void AtomBeginFrameTimer::SetActive(Client* client, bool active) {
+  ClientState& state = clients_[client];
+  if (state.active == active)
+    return;
+  DCHECK(!active || !state.interval.is_zero());
+  state.active = active;
+  // A client that becomes active gets its first frame on the next tick.
+  state.last_tick = base::TimeTicks();
+  UpdateTimeSource();
+}
+
+bool AtomBeginFrameTimer::IsActive(Client* client) const {
+  auto it = clients_.find(client);
+  return it != clients_.end() && it->second.active;
+}
+
+void AtomBeginFrameTimer::RemoveClient(Client* client) {
+  if (clients_.erase(client))
+    UpdateTimeSource();
+}
+
+void AtomBeginFrameTimer::UpdateTimeSource() {
+  base::TimeDelta interval = base::TimeDelta::Max();
+  for (const auto& it : clients_) {
+    if (it.second.active)
+      interval = std::min(interval, it.second.interval);
+  }
+
+  if (interval == base::TimeDelta::Max()) {
+    time_source_->SetActive(false);
+    return;
+  }
+  // The timebase stays the same, so the phase of the ticks does not depend
+  // on which clients happen to be active.
+  if (interval != time_source_->Interval())
+    time_source_->SetTimebaseAndInterval(base::TimeTicks(), interval);
+  time_source_->SetActive(true);
+}
+
+void AtomBeginFrameTimer::OnTimerTick() {
+  base::TimeTicks frame_time = time_source_->LastTickTime();
+  // Clients whose interval is not a multiple of the one of the time source
+  // are ticked on the closest tick instead of the one after.
+  base::TimeTicks due_time = frame_time + time_source_->Interval() / 2;
+
+  std::vector<Client*> due_clients;
+  for (auto& it : clients_) {
+    ClientState& state = it.second;
+    if (state.active && state.last_tick + state.interval <= due_time) {
+      state.last_tick = frame_time;
+      due_clients.push_back(it.first);
+    }
+  }
+
+  // Ticking a client may change its state or the state of other clients.
+  for (auto* client : due_clients) {
+    if (clients_.find(client) != clients_.end())
+      client->OnBeginFrameTimerTick(frame_time);
+  }
+}
+
+}  // namespace electron
@@ -0,0 +1,71 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_TIMER_H_
+#define SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_TIMER_H_
+
+#include <map>
+#include <memory>
+
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/time/time.h"
+#include "components/viz/common/frame_sinks/delay_based_time_source.h"
+
+namespace electron {
+
+// Drives the begin frames of all offscreen views in the process from a
+// single time source on the UI thread.
+//
+// Ticks are aligned to a common timebase, so views with the same frame rate
+// get their begin frames together and the process wakes up once per frame
+// instead of once per view. The time source only runs while a client is
+// active, and at the shortest interval any active client asked for.
+class AtomBeginFrameTimer : public viz::DelayBasedTimeSourceClient {
+ public:
+  class Client {
+   public:
+    virtual void OnBeginFrameTimerTick(base::TimeTicks frame_time) = 0;
+
+   protected:
+    virtual ~Client() {}
+  };
+
+  static AtomBeginFrameTimer* Get();
+
+  // Ticks |client| every |interval| while it is active. Clients are inactive
+  // until SetActive() is called.
+  void SetInterval(Client* client, base::TimeDelta interval);
+  void SetActive(Client* client, bool active);
+  bool IsActive(Client* client) const;
+
+  void RemoveClient(Client* client);
+
+ private:
+  friend class base::NoDestructor<AtomBeginFrameTimer>;
+
+  struct ClientState {
+    base::TimeDelta interval;
+    base::TimeTicks last_tick;
+    bool active = false;
+  };
+
+  AtomBeginFrameTimer();
+  ~AtomBeginFrameTimer() override;
+
+  // Runs the time source at the shortest interval of the active clients.
+  void UpdateTimeSource();
+
+  // viz::DelayBasedTimeSourceClient:
+  void OnTimerTick() override;
+
+  std::map<Client*, ClientState> clients_;
+  std::unique_ptr<viz::DelayBasedTimeSource> time_source_;
+
+  DISALLOW_COPY_AND_ASSIGN(AtomBeginFrameTimer);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_OSR_OSR_BEGIN_FRAME_TIMER_H_
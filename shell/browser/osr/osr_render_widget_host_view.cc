@@ -18,7 +18,6 @@
 #include "base/time/time.h"
 #include "components/viz/common/features.h"
 #include "components/viz/common/frame_sinks/copy_output_request.h"
-#include "components/viz/common/frame_sinks/delay_based_time_source.h"
 #include "components/viz/common/gl_helper.h"
 #include "components/viz/common/quads/render_pass.h"
 #include "content/browser/renderer_host/cursor_manager.h"  // nogncheck
@@ -53,6 +52,9 @@ namespace {
 
 const float kDefaultScaleFactor = 1.0;
 
+// Frames without damage stretch the begin frame interval up to 16 times.
+const int kMaxBeginFrameBackoff = 4;
+
 ui::MouseEvent UiMouseEventFromWebMouseEvent(blink::WebMouseEvent event) {
   ui::EventType type = ui::EventType::ET_UNKNOWN;
   switch (event.GetType()) {
@@ -121,40 +123,6 @@ ui::MouseWheelEvent UiMouseWheelEventFromWebMouseEvent(
 
 }  // namespace
 
-class AtomBeginFrameTimer : public viz::DelayBasedTimeSourceClient {
- public:
-  AtomBeginFrameTimer(int frame_rate_threshold_us,
-                      const base::Closure& callback)
-      : callback_(callback) {
-    time_source_ = std::make_unique<viz::DelayBasedTimeSource>(
-        base::CreateSingleThreadTaskRunnerWithTraits(
-            {content::BrowserThread::UI})
-            .get());
-    time_source_->SetTimebaseAndInterval(
-        base::TimeTicks(),
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us));
-    time_source_->SetClient(this);
-  }
-
-  void SetActive(bool active) { time_source_->SetActive(active); }
-
-  bool IsActive() const { return time_source_->Active(); }
-
-  void SetFrameRateThresholdUs(int frame_rate_threshold_us) {
-    time_source_->SetTimebaseAndInterval(
-        base::TimeTicks::Now(),
-        base::TimeDelta::FromMicroseconds(frame_rate_threshold_us));
-  }
-
- private:
-  void OnTimerTick() override { callback_.Run(); }
-
-  const base::Closure callback_;
-  std::unique_ptr<viz::DelayBasedTimeSource> time_source_;
-
-  DISALLOW_COPY_AND_ASSIGN(AtomBeginFrameTimer);
-};
-
 class AtomDelegatedFrameHostClient : public content::DelegatedFrameHostClient {
  public:
   explicit AtomDelegatedFrameHostClient(OffScreenRenderWidgetHostView* view)
@@ -218,7 +186,8 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
       is_showing_(false),
       cursor_manager_(new content::CursorManager(this)),
       mouse_wheel_phase_handler_(this),
-      backing_(new SkBitmap),
+      backing_store_(!transparent),
+      composite_store_(false),
       weak_ptr_factory_(this) {
   DCHECK(render_widget_host_);
   bool is_guest_view_hack = parent_host_view_ != nullptr;
@@ -274,6 +243,8 @@ OffScreenRenderWidgetHostView::OffScreenRenderWidgetHostView(
 }
 
 OffScreenRenderWidgetHostView::~OffScreenRenderWidgetHostView() {
+  AtomBeginFrameTimer::Get()->RemoveClient(this);
+
   // Marking the DelegatedFrameHost as removed from the window hierarchy is
   // necessary to remove all connections to its old ui::Compositor.
   if (is_showing_)
@@ -293,11 +264,20 @@ OffScreenRenderWidgetHostView::CreateBrowserAccessibilityManager(
   return nullptr;
 }
 
-void OffScreenRenderWidgetHostView::OnBeginFrameTimerTick() {
-  const base::TimeTicks frame_time = base::TimeTicks::Now();
-  const base::TimeDelta vsync_period =
-      base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_);
-  SendBeginFrame(frame_time, vsync_period);
+void OffScreenRenderWidgetHostView::OnBeginFrameTimerTick(
+    base::TimeTicks frame_time) {
+  // A renderer that keeps asking for frames without drawing anything, like a
+  // page running an idle requestAnimationFrame loop, gets them less often.
+  if (last_frame_had_damage_)
+    begin_frame_backoff_ = 0;
+  else if (begin_frame_backoff_ < kMaxBeginFrameBackoff)
+    ++begin_frame_backoff_;
+  last_frame_had_damage_ = false;
+  invalidate_pending_ = false;
+
+  SendBeginFrame(frame_time,
+                 base::TimeDelta::FromMicroseconds(frame_rate_threshold_us_));
+  UpdateBeginFrameTimer();
 }
 
 void OffScreenRenderWidgetHostView::SendBeginFrame(
@@ -323,12 +303,17 @@ void OffScreenRenderWidgetHostView::SendBeginFrame(
 }
 
 void OffScreenRenderWidgetHostView::OnDisplayDidFinishFrame(
-    const viz::BeginFrameAck& ack) {}
+    const viz::BeginFrameAck& ack) {
+  if (ack.has_damage)
+    last_frame_had_damage_ = true;
+}
 
 void OffScreenRenderWidgetHostView::OnNeedsExternalBeginFrames(
     bool needs_begin_frames) {
-  SetupFrameRate(true);
-  begin_frame_timer_->SetActive(needs_begin_frames);
+  if (needs_begin_frames && !needs_external_begin_frames_)
+    ResetBeginFrameBackoff();
+  needs_external_begin_frames_ = needs_begin_frames;
+  UpdateBeginFrameTimer();
 }
 
 void OffScreenRenderWidgetHostView::InitAsChild(gfx::NativeView) {
@@ -740,8 +725,10 @@ bool OffScreenRenderWidgetHostView::InstallTransparency() {
 
 void OffScreenRenderWidgetHostView::SetNeedsBeginFrames(
     bool needs_begin_frames) {
-  SetupFrameRate(true);
-  begin_frame_timer_->SetActive(needs_begin_frames);
+  if (needs_begin_frames && !needs_begin_frames_)
+    ResetBeginFrameBackoff();
+  needs_begin_frames_ = needs_begin_frames;
+  UpdateBeginFrameTimer();
 }
 
 void OffScreenRenderWidgetHostView::SetWantsAnimateOnlyBeginFrames() {}
@@ -760,9 +747,13 @@ bool OffScreenRenderWidgetHostView::UpdateNSViewAndDisplay() {
 
 void OffScreenRenderWidgetHostView::OnPaint(const gfx::Rect& damage_rect,
                                             const SkBitmap& bitmap) {
-  backing_ = std::make_unique<SkBitmap>();
-  backing_->allocN32Pixels(bitmap.width(), bitmap.height(), !transparent_);
-  bitmap.readPixels(backing_->pixmap());
+  last_frame_had_damage_ = true;
+
+  // Only the area that changed since the frame held by the reused bitmap is
+  // copied out of the captured frame.
+  gfx::Rect dirty_rect = backing_store_.BeginFrame(
+      gfx::Size(bitmap.width(), bitmap.height()), damage_rect);
+  backing_store_.CopyRect(bitmap, gfx::Point(), dirty_rect);
 
   if (IsPopupWidget() && parent_callback_) {
     parent_callback_.Run(this->popup_position_);
@@ -788,43 +779,79 @@ void OffScreenRenderWidgetHostView::CompositeFrame(
   gfx::Size size_in_pixels = SizeInPixels();
 
   SkBitmap frame;
+  // The area that differs from the last frame passed to |callback_|.
+  gfx::Rect frame_damage_rect = damage_rect;
 
   // Optimize for the case when there is no popup
   if (proxy_views_.size() == 0 && !popup_host_view_) {
     frame = GetBacking();
+    // The composited bitmaps no longer follow the damage.
+    composite_store_.Reset();
+    for (const auto& rect : overlay_rects_)
+      frame_damage_rect.Union(rect);
+    overlay_rects_.clear();
   } else {
-    frame.allocN32Pixels(size_in_pixels.width(), size_in_pixels.height(),
-                         false);
+    std::vector<gfx::Rect> overlay_rects;
+    if (popup_host_view_)
+      overlay_rects.push_back(gfx::ConvertRectToPixel(
+          current_device_scale_factor_, popup_host_view_->popup_position_));
+    for (auto* proxy_view : proxy_views_) {
+      overlay_rects.push_back(gfx::ConvertRectToPixel(
+          current_device_scale_factor_, proxy_view->GetBounds()));
+    }
+
+    // When a popup or proxy view moves, appears or goes away, the areas it
+    // covers before and after have to be composited again.
+    gfx::Rect composite_rect = damage_rect;
+    if (overlay_rects != overlay_rects_) {
+      for (const auto& rect : overlay_rects)
+        composite_rect.Union(rect);
+      for (const auto& rect : overlay_rects_)
+        composite_rect.Union(rect);
+      overlay_rects_ = overlay_rects;
+    }
+
+    frame_damage_rect = composite_rect;
+    gfx::Rect dirty_rect =
+        composite_store_.BeginFrame(size_in_pixels, composite_rect);
     if (!GetBacking().drawsNothing()) {
-      SkCanvas canvas(frame);
-      canvas.writePixels(GetBacking(), 0, 0);
+      composite_store_.CopyRect(GetBacking(), gfx::Point(), dirty_rect);
 
       if (popup_host_view_ && !popup_host_view_->GetBacking().drawsNothing()) {
         gfx::Rect rect = popup_host_view_->popup_position_;
         gfx::Point origin_in_pixels = gfx::ConvertPointToPixel(
             current_device_scale_factor_, rect.origin());
-        canvas.writePixels(popup_host_view_->GetBacking(), origin_in_pixels.x(),
-                           origin_in_pixels.y());
+        composite_store_.CopyRect(popup_host_view_->GetBacking(),
+                                  origin_in_pixels, dirty_rect);
       }
 
       for (auto* proxy_view : proxy_views_) {
         gfx::Rect rect = proxy_view->GetBounds();
         gfx::Point origin_in_pixels = gfx::ConvertPointToPixel(
             current_device_scale_factor_, rect.origin());
-        canvas.writePixels(*proxy_view->GetBitmap(), origin_in_pixels.x(),
-                           origin_in_pixels.y());
+        composite_store_.CopyRect(*proxy_view->GetBitmap(), origin_in_pixels,
+                                  dirty_rect);
       }
     }
+    frame = composite_store_.current();
   }
 
   paint_callback_running_ = true;
-  callback_.Run(gfx::IntersectRects(gfx::Rect(size_in_pixels), damage_rect),
-                frame);
+  callback_.Run(
+      gfx::IntersectRects(gfx::Rect(size_in_pixels), frame_damage_rect), frame);
   paint_callback_running_ = false;
 
   ReleaseResize();
 }
 
+OffScreenBackingStore::Stats OffScreenRenderWidgetHostView::GetPaintStats()
+    const {
+  OffScreenBackingStore::Stats stats = backing_store_.stats();
+  stats.bytes_copied += composite_store_.stats().bytes_copied;
+  stats.bytes_allocated += composite_store_.stats().bytes_allocated;
+  return stats;
+}
+
 void OffScreenRenderWidgetHostView::OnPopupPaint(const gfx::Rect& damage_rect) {
   InvalidateBounds(
       gfx::ConvertRectToPixel(current_device_scale_factor_, damage_rect));
@@ -868,6 +895,10 @@ void OffScreenRenderWidgetHostView::SynchronizeVisualProperties() {
 
 void OffScreenRenderWidgetHostView::SendMouseEvent(
     const blink::WebMouseEvent& event) {
+  // Don't keep the response to input waiting for a backed off begin frame.
+  ResetBeginFrameBackoff();
+  UpdateBeginFrameTimer();
+
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->GetBounds();
     if (bounds.Contains(event.PositionInWidget().x,
@@ -906,6 +937,10 @@ void OffScreenRenderWidgetHostView::SendMouseEvent(
 
 void OffScreenRenderWidgetHostView::SendMouseWheelEvent(
     const blink::WebMouseWheelEvent& event) {
+  // Don't keep the response to input waiting for a backed off begin frame.
+  ResetBeginFrameBackoff();
+  UpdateBeginFrameTimer();
+
   for (auto* proxy_view : proxy_views_) {
     gfx::Rect bounds = proxy_view->GetBounds();
     if (bounds.Contains(event.PositionInWidget().x,
@@ -1060,19 +1095,33 @@ void OffScreenRenderWidgetHostView::SetupFrameRate(bool force) {
     return;
 
   frame_rate_threshold_us_ = 1000000 / frame_rate_;
+  UpdateBeginFrameTimer();
+}
 
-  if (begin_frame_timer_.get()) {
-    begin_frame_timer_->SetFrameRateThresholdUs(frame_rate_threshold_us_);
-  } else {
-    begin_frame_timer_ = std::make_unique<AtomBeginFrameTimer>(
-        frame_rate_threshold_us_,
-        base::BindRepeating(
-            &OffScreenRenderWidgetHostView::OnBeginFrameTimerTick,
-            weak_ptr_factory_.GetWeakPtr()));
-  }
+void OffScreenRenderWidgetHostView::UpdateBeginFrameTimer() {
+  if (frame_rate_threshold_us_ == 0)
+    return;
+
+  auto* timer = AtomBeginFrameTimer::Get();
+  timer->SetInterval(this, base::TimeDelta::FromMicroseconds(
+                               frame_rate_threshold_us_ *
+                               (int64_t{1} << begin_frame_backoff_)));
+  timer->SetActive(this, needs_begin_frames_ || needs_external_begin_frames_ ||
+                             invalidate_pending_);
+}
+
+void OffScreenRenderWidgetHostView::ResetBeginFrameBackoff() {
+  begin_frame_backoff_ = 0;
+  last_frame_had_damage_ = true;
 }
 
 void OffScreenRenderWidgetHostView::Invalidate() {
+  // Issue a begin frame even if nobody asks for one, so that the renderer
+  // gets to draw again.
+  invalidate_pending_ = true;
+  ResetBeginFrameBackoff();
+  UpdateBeginFrameTimer();
+
   InvalidateBounds(gfx::Rect(GetRequestedRendererSize()));
 }
 
@@ -27,6 +27,8 @@
 #include "content/browser/renderer_host/render_widget_host_impl.h"  // nogncheck
 #include "content/browser/renderer_host/render_widget_host_view_base.h"  // nogncheck
 #include "content/browser/web_contents/web_contents_view.h"  // nogncheck
+#include "shell/browser/osr/osr_backing_store.h"
+#include "shell/browser/osr/osr_begin_frame_timer.h"
 #include "shell/browser/osr/osr_host_display_client.h"
 #include "shell/browser/osr/osr_video_consumer.h"
 #include "shell/browser/osr/osr_view_proxy.h"
@@ -52,7 +54,6 @@ class CursorManager;
 namespace electron {
 
 class AtomCopyFrameGenerator;
-class AtomBeginFrameTimer;
 
 class AtomDelegatedFrameHostClient;
 
@@ -62,7 +63,8 @@ typedef base::Callback<void(const gfx::Rect&)> OnPopupPaintCallback;
 class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
                                       public ui::ExternalBeginFrameClient,
                                       public ui::CompositorDelegate,
-                                      public OffscreenViewProxyObserver {
+                                      public OffscreenViewProxyObserver,
+                                      public AtomBeginFrameTimer::Client {
  public:
   OffScreenRenderWidgetHostView(bool transparent,
                                 bool painting,
@@ -172,7 +174,9 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   bool InstallTransparency();
 
-  void OnBeginFrameTimerTick();
+  // AtomBeginFrameTimer::Client:
+  void OnBeginFrameTimerTick(base::TimeTicks frame_time) override;
+
   void SendBeginFrame(base::TimeTicks frame_time, base::TimeDelta vsync_period);
 
   void CancelWidget();
@@ -194,7 +198,11 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
     return widget_type_ == content::WidgetType::kPopup;
   }
 
-  const SkBitmap& GetBacking() { return *backing_.get(); }
+  const SkBitmap& GetBacking() { return backing_store_.current(); }
+
+  // The frames painted by this view and the bytes copied and allocated to
+  // paint them.
+  OffScreenBackingStore::Stats GetPaintStats() const;
 
   void HoldResize();
   void ReleaseResize();
@@ -233,6 +241,10 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
  private:
   void SetupFrameRate(bool force);
+  // Ticks this view while anyone needs begin frames, backing off while the
+  // frames come back without damage.
+  void UpdateBeginFrameTimer();
+  void ResetBeginFrameBackoff();
   void ResizeRootLayer(bool force);
 
   viz::FrameSinkId AllocateFrameSinkId(bool is_guest_view_hack);
@@ -257,6 +269,17 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
   int frame_rate_ = 0;
   int frame_rate_threshold_us_ = 0;
 
+  // Whether the renderer and the compositor of this view ask for begin
+  // frames.
+  bool needs_begin_frames_ = false;
+  bool needs_external_begin_frames_ = false;
+  // A begin frame is owed to an Invalidate() call.
+  bool invalidate_pending_ = false;
+  // Begin frames are issued every |frame_rate_threshold_us_| shifted left by
+  // this, which grows while frames have no damage.
+  int begin_frame_backoff_ = 0;
+  bool last_frame_had_damage_ = true;
+
   base::Time last_time_ = base::Time::Now();
 
   gfx::Vector2dF last_scroll_offset_;
@@ -284,7 +307,6 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   std::unique_ptr<content::CursorManager> cursor_manager_;
 
-  std::unique_ptr<AtomBeginFrameTimer> begin_frame_timer_;
   OffScreenHostDisplayClient* host_display_client_;
   std::unique_ptr<OffScreenVideoConsumer> video_consumer_;
 
@@ -306,7 +328,12 @@ class OffScreenRenderWidgetHostView : public content::RenderWidgetHostViewBase,
 
   SkColor background_color_ = SkColor();
 
-  std::unique_ptr<SkBitmap> backing_;
+  // The last frame captured from the compositor.
+  OffScreenBackingStore backing_store_;
+  // The last frame with the popup and proxy views drawn over it.
+  OffScreenBackingStore composite_store_;
+  // Where the popup and proxy views were drawn in the last composited frame.
+  std::vector<gfx::Rect> overlay_rects_;
 
   base::WeakPtrFactory<OffScreenRenderWidgetHostView> weak_ptr_factory_;
 
@@ -20,13 +20,10 @@ OffScreenVideoConsumer::OffScreenVideoConsumer(
       view_(view),
       video_capturer_(view->CreateVideoCapturer()),
       weak_ptr_factory_(this) {
-  video_capturer_->SetResolutionConstraints(view_->SizeInPixels(),
-                                            view_->SizeInPixels(), true);
-  video_capturer_->SetAutoThrottlingEnabled(false);
-  video_capturer_->SetMinSizeChangePeriod(base::TimeDelta());
-  video_capturer_->SetFormat(media::PIXEL_FORMAT_ARGB,
-                             gfx::ColorSpace::CreateREC709());
-  SetFrameRate(view_->GetFrameRate());
+  // The frames are painted into the backing store of the view, so they are
+  // always captured in ARGB at the size of the view.
+  capture_options_.max_frame_rate = view_->GetFrameRate();
+  capture_options_.Apply(video_capturer_.get(), view_->SizeInPixels());
 }
 
 OffScreenVideoConsumer::~OffScreenVideoConsumer() = default;
@@ -40,13 +37,12 @@ void OffScreenVideoConsumer::SetActive(bool active) {
 }
 
 void OffScreenVideoConsumer::SetFrameRate(int frame_rate) {
-  video_capturer_->SetMinCapturePeriod(base::TimeDelta::FromSeconds(1) /
-                                       frame_rate);
+  capture_options_.max_frame_rate = frame_rate;
+  capture_options_.ApplyFrameRate(video_capturer_.get());
 }
 
 void OffScreenVideoConsumer::SizeChanged() {
-  video_capturer_->SetResolutionConstraints(view_->SizeInPixels(),
-                                            view_->SizeInPixels(), true);
+  capture_options_.ApplyFrameSize(video_capturer_.get(), view_->SizeInPixels());
   video_capturer_->RequestRefreshFrame();
 }
 
@@ -55,10 +51,9 @@ void OffScreenVideoConsumer::OnFrameCaptured(
     ::media::mojom::VideoFrameInfoPtr info,
     const gfx::Rect& content_rect,
     viz::mojom::FrameSinkVideoConsumerFrameCallbacksPtr callbacks) {
-  if (!CheckContentRect(content_rect)) {
-    gfx::Size view_size = view_->SizeInPixels();
-    video_capturer_->SetResolutionConstraints(view_size, view_size, true);
-    video_capturer_->RequestRefreshFrame();
+  if (!capture_options_.MatchesFrameSize(content_rect.size(),
+                                         view_->SizeInPixels())) {
+    SizeChanged();
     return;
   }
 
@@ -119,19 +114,4 @@ void OffScreenVideoConsumer::OnFrameCaptured(
 
 void OffScreenVideoConsumer::OnStopped() {}
 
-bool OffScreenVideoConsumer::CheckContentRect(const gfx::Rect& content_rect) {
-  gfx::Size view_size = view_->SizeInPixels();
-  gfx::Size content_size = content_rect.size();
-
-  if (std::abs(view_size.width() - content_size.width()) > 2) {
-    return false;
-  }
-
-  if (std::abs(view_size.height() - content_size.height()) > 2) {
-    return false;
-  }
-
-  return true;
-}
-
 }  // namespace electron
@@ -10,6 +10,7 @@
 #include "base/callback.h"
 #include "base/memory/weak_ptr.h"
 #include "components/viz/host/client_frame_sink_video_capturer.h"
+#include "shell/browser/frame_capture_options.h"
 
 namespace electron {
 
@@ -37,9 +38,8 @@ class OffScreenVideoConsumer : public viz::mojom::FrameSinkVideoConsumer {
       viz::mojom::FrameSinkVideoConsumerFrameCallbacksPtr callbacks) override;
   void OnStopped() override;
 
-  bool CheckContentRect(const gfx::Rect& content_rect);
-
   OnPaintCallback callback_;
+  FrameCaptureOptions capture_options_;
 
   OffScreenRenderWidgetHostView* view_;
   std::unique_ptr<viz::ClientFrameSinkVideoCapturer> video_capturer_;
@@ -0,0 +1,427 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/osr/osr_video_encoder.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/system/sys_info.h"
+#include "base/task/post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "third_party/libvpx/source/libvpx/vpx/vp8cx.h"
+#include "third_party/libvpx/source/libvpx/vpx/vpx_encoder.h"
+#include "third_party/libwebm/source/mkvmuxer/mkvmuxer.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace electron {
+
+namespace {
+
+// One frame being encoded and one waiting for it.
+const int kMaxFramesInFlight = 2;
+
+// Key frames are forced at this interval so that a stream can be joined or a
+// file seeked without decoding from the start.
+constexpr base::TimeDelta kKeyFrameInterval = base::TimeDelta::FromSeconds(10);
+
+// Trades quality for speed, as frames have to keep up with the page.
+const int kCpuUsed = 8;
+
+// The size of the blocks the active map of the encoder covers.
+const int kMacroblockSize = 16;
+
+struct VpxCodecDeleter {
+  void operator()(vpx_codec_ctx_t* codec) {
+    vpx_codec_destroy(codec);
+    delete codec;
+  }
+};
+
+struct VpxImageDeleter {
+  void operator()(vpx_image_t* image) { vpx_img_free(image); }
+};
+
+// Chroma samples cover 2x2 pixels, so the converted area has to start on an
+// even pixel and cover an even number of them, unless it ends on the edge.
+gfx::Rect AlignToChroma(const gfx::Rect& rect, const gfx::Size& size) {
+  int x = rect.x() & ~1;
+  int y = rect.y() & ~1;
+  int right = std::min((rect.right() + 1) & ~1, size.width());
+  int bottom = std::min((rect.bottom() + 1) & ~1, size.height());
+  return gfx::Rect(x, y, right - x, bottom - y);
+}
+
+// Writes the WebM file on the encoder sequence.
+class WebMFileWriter : public mkvmuxer::IMkvWriter {
+ public:
+  explicit WebMFileWriter(base::File file) : file_(std::move(file)) {}
+  ~WebMFileWriter() override = default;
+
+  // mkvmuxer::IMkvWriter:
+  mkvmuxer::int32 Write(const void* buf, mkvmuxer::uint32 len) override {
+    int written = file_.WriteAtCurrentPos(static_cast<const char*>(buf), len);
+    if (written != static_cast<int>(len))
+      return -1;
+    position_ += len;
+    return 0;
+  }
+  mkvmuxer::int64 Position() const override { return position_; }
+  mkvmuxer::int32 Position(mkvmuxer::int64 position) override {
+    if (file_.Seek(base::File::FROM_BEGIN, position) != position)
+      return -1;
+    position_ = position;
+    return 0;
+  }
+  bool Seekable() const override { return true; }
+  void ElementStartNotify(mkvmuxer::uint64 element_id,
+                          mkvmuxer::int64 position) override {}
+
+ private:
+  base::File file_;
+  int64_t position_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(WebMFileWriter);
+};
+
+}  // namespace
+
+// Converts and encodes frames on the encoder sequence.
+class OffScreenVideoEncoder::Core {
+ public:
+  Core(const Options& options,
+       base::File file,
+       scoped_refptr<base::SequencedTaskRunner> reply_runner,
+       base::WeakPtr<OffScreenVideoEncoder> owner)
+      : options_(options),
+        reply_runner_(std::move(reply_runner)),
+        owner_(owner) {
+    if (file.IsValid()) {
+      writer_ = std::make_unique<WebMFileWriter>(std::move(file));
+      segment_ = std::make_unique<mkvmuxer::Segment>();
+      if (!segment_->Init(writer_.get())) {
+        error_ = "Failed to write the video file";
+        return;
+      }
+      segment_->set_mode(mkvmuxer::Segment::kFile);
+      segment_->OutputCues(true);
+      segment_->GetSegmentInfo()->set_writing_app("Electron");
+    }
+  }
+
+  ~Core() = default;
+
+  void Encode(const SkBitmap& frame,
+              const gfx::Rect& damage_rect,
+              base::TimeTicks timestamp) {
+    if (error_.empty() && !frame.drawsNothing()) {
+      base::TimeTicks started = base::TimeTicks::Now();
+      EncodeFrame(frame, damage_rect, timestamp);
+      stats_.encode_time += base::TimeTicks::Now() - started;
+    }
+    reply_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&OffScreenVideoEncoder::OnFrameEncoded, owner_));
+  }
+
+  void Finish(StopCallback callback) {
+    if (segment_ && error_.empty() && !segment_->Finalize())
+      error_ = "Failed to write the video file";
+    // Closes the file.
+    segment_.reset();
+    writer_.reset();
+    codec_.reset();
+    reply_runner_->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), error_, stats_));
+  }
+
+ private:
+  void EncodeFrame(const SkBitmap& frame,
+                   const gfx::Rect& damage_rect,
+                   base::TimeTicks timestamp) {
+    gfx::Size size(frame.width(), frame.height());
+    bool key_frame = false;
+    gfx::Rect rect;
+    if (size != size_) {
+      if (!Configure(size))
+        return;
+      key_frame = true;
+      rect = gfx::Rect(size);
+    } else {
+      rect = AlignToChroma(gfx::IntersectRects(damage_rect, gfx::Rect(size)),
+                           size);
+      // Nothing to encode.
+      if (rect.IsEmpty())
+        return;
+    }
+
+    if (first_timestamp_.is_null())
+      first_timestamp_ = timestamp;
+    base::TimeDelta pts = timestamp - first_timestamp_;
+    if (stats_.frames > 0 && pts <= last_pts_)
+      pts = last_pts_ + base::TimeDelta::FromMicroseconds(1);
+    base::TimeDelta duration =
+        stats_.frames > 0 ? pts - last_pts_ : base::TimeDelta();
+    last_pts_ = pts;
+    if (pts - last_key_frame_pts_ >= kKeyFrameInterval)
+      key_frame = true;
+    if (key_frame)
+      last_key_frame_pts_ = pts;
+
+    ConvertToI420(frame, rect);
+    SetActiveMap(key_frame ? gfx::Rect(size) : rect);
+
+    vpx_codec_err_t result = vpx_codec_encode(
+        codec_.get(), image_.get(), pts.InMicroseconds(),
+        std::max<int64_t>(duration.InMicroseconds(), 1),
+        key_frame ? VPX_EFLAG_FORCE_KF : 0, VPX_DL_REALTIME);
+    if (result != VPX_CODEC_OK) {
+      error_ = vpx_codec_err_to_string(result);
+      return;
+    }
+    ++stats_.frames;
+
+    vpx_codec_iter_t iter = nullptr;
+    const vpx_codec_cx_pkt_t* packet;
+    while ((packet = vpx_codec_get_cx_data(codec_.get(), &iter))) {
+      if (packet->kind != VPX_CODEC_CX_FRAME_PKT)
+        continue;
+      Packet out;
+      out.data.assign(static_cast<const char*>(packet->data.frame.buf),
+                      packet->data.frame.sz);
+      out.timestamp =
+          base::TimeDelta::FromMicroseconds(packet->data.frame.pts);
+      out.key_frame = (packet->data.frame.flags & VPX_FRAME_IS_KEY) != 0;
+      out.size = size_;
+      stats_.bytes += out.data.size();
+      WritePacket(std::move(out));
+    }
+  }
+
+  bool Configure(const gfx::Size& size) {
+    vpx_codec_iface_t* iface = options_.codec == Codec::kVP9
+                                   ? vpx_codec_vp9_cx()
+                                   : vpx_codec_vp8_cx();
+    vpx_codec_enc_cfg_t config;
+    if (vpx_codec_enc_config_default(iface, &config, 0) != VPX_CODEC_OK) {
+      error_ = "Failed to configure the video encoder";
+      return false;
+    }
+    config.g_w = size.width();
+    config.g_h = size.height();
+    config.g_timebase.num = 1;
+    config.g_timebase.den = base::Time::kMicrosecondsPerSecond;
+    config.g_pass = VPX_RC_ONE_PASS;
+    config.g_lag_in_frames = 0;
+    config.g_threads =
+        std::min(std::max(base::SysInfo::NumberOfProcessors() - 1, 1), 4);
+    config.rc_end_usage = VPX_VBR;
+    config.rc_target_bitrate = std::max(options_.bitrate / 1000, 1);
+    // Key frames are forced, so that they are encoded with all macroblocks
+    // active.
+    config.kf_mode = VPX_KF_DISABLED;
+
+    codec_.reset(new vpx_codec_ctx_t());
+    vpx_codec_err_t result =
+        vpx_codec_enc_init(codec_.get(), iface, &config, 0);
+    if (result != VPX_CODEC_OK) {
+      error_ = vpx_codec_err_to_string(result);
+      return false;
+    }
+    vpx_codec_control(codec_.get(), VP8E_SET_CPUUSED, kCpuUsed);
+
+    image_.reset(vpx_img_alloc(nullptr, VPX_IMG_FMT_I420, size.width(),
+                               size.height(), kMacroblockSize));
+    if (!image_) {
+      error_ = "Failed to allocate a video frame";
+      return false;
+    }
+
+    active_map_cols_ = (size.width() + kMacroblockSize - 1) / kMacroblockSize;
+    active_map_rows_ = (size.height() + kMacroblockSize - 1) / kMacroblockSize;
+    active_map_.assign(active_map_cols_ * active_map_rows_, 0);
+
+    if (segment_ && !track_) {
+      track_ = segment_->AddVideoTrack(size.width(), size.height(), 0);
+      auto* track = static_cast<mkvmuxer::VideoTrack*>(
+          segment_->GetTrackByNumber(track_));
+      if (!track) {
+        error_ = "Failed to write the video file";
+        return false;
+      }
+      track->set_codec_id(options_.codec == Codec::kVP9
+                              ? mkvmuxer::Tracks::kVp9CodecId
+                              : mkvmuxer::Tracks::kVp8CodecId);
+    }
+
+    size_ = size;
+    return true;
+  }
+
+  // Converts the pixels of |frame| inside |rect| into |image_|, which keeps
+  // the rest of the previous frame.
+  void ConvertToI420(const SkBitmap& frame, const gfx::Rect& rect) {
+    auto* convert = frame.colorType() == kRGBA_8888_SkColorType
+                        ? libyuv::ABGRToI420
+                        : libyuv::ARGBToI420;
+    const int y_stride = image_->stride[VPX_PLANE_Y];
+    const int u_stride = image_->stride[VPX_PLANE_U];
+    const int v_stride = image_->stride[VPX_PLANE_V];
+    convert(static_cast<const uint8_t*>(frame.getAddr(rect.x(), rect.y())),
+            frame.rowBytes(),
+            image_->planes[VPX_PLANE_Y] + rect.y() * y_stride + rect.x(),
+            y_stride,
+            image_->planes[VPX_PLANE_U] + rect.y() / 2 * u_stride +
+                rect.x() / 2,
+            u_stride,
+            image_->planes[VPX_PLANE_V] + rect.y() / 2 * v_stride +
+                rect.x() / 2,
+            v_stride, rect.width(), rect.height());
+  }
+
+  // Lets the encoder skip the macroblocks outside of |rect|.
+  void SetActiveMap(const gfx::Rect& rect) {
+    std::fill(active_map_.begin(), active_map_.end(), 0);
+    int left = rect.x() / kMacroblockSize;
+    int top = rect.y() / kMacroblockSize;
+    int right = (rect.right() + kMacroblockSize - 1) / kMacroblockSize;
+    int bottom = (rect.bottom() + kMacroblockSize - 1) / kMacroblockSize;
+    for (int row = top; row < bottom; ++row) {
+      std::fill(active_map_.begin() + row * active_map_cols_ + left,
+                active_map_.begin() + row * active_map_cols_ + right, 1);
+    }
+
+    vpx_active_map_t map;
+    map.active_map = active_map_.data();
+    map.rows = active_map_rows_;
+    map.cols = active_map_cols_;
+    vpx_codec_control(codec_.get(), VP8E_SET_ACTIVEMAP, &map);
+  }
+
+  void WritePacket(Packet packet) {
+    if (!segment_) {
+      reply_runner_->PostTask(FROM_HERE,
+                              base::BindOnce(&OffScreenVideoEncoder::OnPacket,
+                                             owner_, std::move(packet)));
+      return;
+    }
+    if (!segment_->AddFrame(
+            reinterpret_cast<const uint8_t*>(packet.data.data()),
+            packet.data.size(), track_,
+            packet.timestamp.InMicroseconds() *
+                base::Time::kNanosecondsPerMicrosecond,
+            packet.key_frame)) {
+      error_ = "Failed to write the video file";
+    }
+  }
+
+  const Options options_;
+  scoped_refptr<base::SequencedTaskRunner> reply_runner_;
+  base::WeakPtr<OffScreenVideoEncoder> owner_;
+
+  std::unique_ptr<vpx_codec_ctx_t, VpxCodecDeleter> codec_;
+  std::unique_ptr<vpx_image_t, VpxImageDeleter> image_;
+  gfx::Size size_;
+  std::vector<uint8_t> active_map_;
+  int active_map_cols_ = 0;
+  int active_map_rows_ = 0;
+
+  base::TimeTicks first_timestamp_;
+  base::TimeDelta last_pts_;
+  base::TimeDelta last_key_frame_pts_;
+
+  std::unique_ptr<WebMFileWriter> writer_;
+  std::unique_ptr<mkvmuxer::Segment> segment_;
+  uint64_t track_ = 0;
+
+  std::string error_;
+  Stats stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(Core);
+};
+
+OffScreenVideoEncoder::Packet::Packet() = default;
+OffScreenVideoEncoder::Packet::Packet(Packet&&) = default;
+OffScreenVideoEncoder::Packet::~Packet() = default;
+OffScreenVideoEncoder::Packet& OffScreenVideoEncoder::Packet::operator=(
+    Packet&&) = default;
+
+OffScreenVideoEncoder::OffScreenVideoEncoder(
+    const Options& options,
+    base::File file,
+    const PacketCallback& packet_callback)
+    : task_runner_(base::CreateSequencedTaskRunnerWithTraits(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      core_(nullptr, base::OnTaskRunnerDeleter(task_runner_)),
+      packet_callback_(packet_callback),
+      weak_factory_(this) {
+  core_.reset(new Core(options, std::move(file),
+                       base::SequencedTaskRunnerHandle::Get(),
+                       weak_factory_.GetWeakPtr()));
+}
+
+OffScreenVideoEncoder::~OffScreenVideoEncoder() {
+  // Still finish the file when the encoder goes away without being stopped.
+  if (!stopped_) {
+    task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&Core::Finish, base::Unretained(core_.get()),
+                       base::DoNothing::Once<const std::string&,
+                                             const Stats&>()));
+  }
+}
+
+void OffScreenVideoEncoder::EncodeFrame(const SkBitmap& frame,
+                                        const gfx::Rect& damage_rect,
+                                        base::TimeTicks timestamp) {
+  if (stopped_)
+    return;
+
+  if (frames_in_flight_ >= kMaxFramesInFlight) {
+    dropped_damage_.Union(damage_rect);
+    ++dropped_frames_;
+    return;
+  }
+
+  gfx::Rect damage = damage_rect;
+  damage.Union(dropped_damage_);
+  dropped_damage_ = gfx::Rect();
+  ++frames_in_flight_;
+  // Copying the bitmap only adds a reference to its pixels.
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Core::Encode, base::Unretained(core_.get()),
+                                frame, damage, timestamp));
+}
+
+void OffScreenVideoEncoder::Stop(StopCallback callback) {
+  stopped_ = true;
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Core::Finish, base::Unretained(core_.get()),
+                     base::BindOnce(&OffScreenVideoEncoder::OnStopped,
+                                    weak_factory_.GetWeakPtr(),
+                                    std::move(callback))));
+}
+
+void OffScreenVideoEncoder::OnPacket(Packet packet) {
+  packet_callback_.Run(std::move(packet));
+}
+
+void OffScreenVideoEncoder::OnFrameEncoded() {
+  --frames_in_flight_;
+}
+
+void OffScreenVideoEncoder::OnStopped(StopCallback callback,
+                                      const std::string& error,
+                                      const Stats& stats) {
+  Stats result = stats;
+  result.dropped_frames = dropped_frames_;
+  std::move(callback).Run(error, result);
+}
+
+}  // namespace electron
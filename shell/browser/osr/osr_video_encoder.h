@@ -0,0 +1,115 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_OSR_OSR_VIDEO_ENCODER_H_
+#define SHELL_BROWSER_OSR_OSR_VIDEO_ENCODER_H_
+
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace electron {
+
+// Encodes the frames of an offscreen view with VP8 or VP9.
+//
+// Frames are handed over without copying their pixels: the backing stores
+// of the view never write to a bitmap that is still referenced. Conversion
+// to I420 and encoding run on a background sequence, and only the area that
+// changed since the previous frame is converted and marked active for the
+// encoder. The encoded frames are either written to a WebM file or passed to
+// the packet callback on the thread that created the encoder.
+class OffScreenVideoEncoder {
+ public:
+  enum class Codec {
+    kVP8,
+    kVP9,
+  };
+
+  struct Options {
+    Codec codec = Codec::kVP8;
+    // Target bitrate in bits per second.
+    int bitrate = 2500000;
+  };
+
+  struct Packet {
+    Packet();
+    Packet(Packet&&);
+    ~Packet();
+    Packet& operator=(Packet&&);
+
+    std::string data;
+    // Time since the first frame.
+    base::TimeDelta timestamp;
+    bool key_frame = false;
+    gfx::Size size;
+
+    DISALLOW_COPY_AND_ASSIGN(Packet);
+  };
+
+  struct Stats {
+    uint64_t frames = 0;
+    // Frames skipped because the encoder was still busy with earlier ones.
+    uint64_t dropped_frames = 0;
+    uint64_t bytes = 0;
+    // Time spent converting and encoding frames on the encoder sequence.
+    base::TimeDelta encode_time;
+  };
+
+  using PacketCallback = base::RepeatingCallback<void(Packet)>;
+  using StopCallback =
+      base::OnceCallback<void(const std::string& error, const Stats& stats)>;
+
+  // The encoded frames are written to |file| as WebM when it is valid, and
+  // passed to |packet_callback| otherwise.
+  OffScreenVideoEncoder(const Options& options,
+                        base::File file,
+                        const PacketCallback& packet_callback);
+  ~OffScreenVideoEncoder();
+
+  // Queues |frame| in which |damage_rect| changed since the previous frame.
+  // The frame is dropped if the encoder is still busy.
+  void EncodeFrame(const SkBitmap& frame,
+                   const gfx::Rect& damage_rect,
+                   base::TimeTicks timestamp);
+
+  // Encodes the queued frames and finishes the output file. |callback| gets
+  // an empty |error| on success.
+  void Stop(StopCallback callback);
+
+ private:
+  class Core;
+
+  void OnPacket(Packet packet);
+  void OnFrameEncoded();
+  void OnStopped(StopCallback callback,
+                 const std::string& error,
+                 const Stats& stats);
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  std::unique_ptr<Core, base::OnTaskRunnerDeleter> core_;
+  PacketCallback packet_callback_;
+
+  int frames_in_flight_ = 0;
+  // The damage of dropped frames, added to the next queued frame.
+  gfx::Rect dropped_damage_;
+  uint64_t dropped_frames_ = 0;
+  bool stopped_ = false;
+
+  base::WeakPtrFactory<OffScreenVideoEncoder> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(OffScreenVideoEncoder);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_OSR_OSR_VIDEO_ENCODER_H_
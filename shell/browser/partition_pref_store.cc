@@ -0,0 +1,120 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/partition_pref_store.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/json/json_file_value_serializer.h"
+#include "base/json/json_writer.h"
+#include "base/task/post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/threading/thread_restrictions.h"
+
+namespace electron {
+
+namespace {
+
+// Long enough to fold a burst of changes, like zooming with the mouse wheel,
+// into one write, short enough to lose little on a crash.
+constexpr base::TimeDelta kCommitInterval = base::TimeDelta::FromSeconds(1);
+
+base::Value ReadValues(const base::FilePath& path, bool* is_new) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  JSONFileValueDeserializer deserializer(path);
+  int error_code = JSONFileValueDeserializer::JSON_NO_ERROR;
+  std::unique_ptr<base::Value> value =
+      deserializer.Deserialize(&error_code, nullptr);
+  *is_new = error_code == JSONFileValueDeserializer::JSON_NO_SUCH_FILE;
+  if (!value || !value->is_dict())
+    return base::Value(base::Value::Type::DICTIONARY);
+  return std::move(*value);
+}
+
+// Runs on the file task runner once the file has been written.
+void ReportCommit(scoped_refptr<base::SequencedTaskRunner> reply_runner,
+                  base::OnceCallback<void(base::TimeDelta, bool)> reply,
+                  base::TimeTicks started,
+                  bool success) {
+  reply_runner->PostTask(FROM_HERE,
+                         base::BindOnce(std::move(reply),
+                                        base::TimeTicks::Now() - started,
+                                        success));
+}
+
+}  // namespace
+
+const base::FilePath::CharType PartitionPrefStore::kFileName[] =
+    FILE_PATH_LITERAL("Partition Preferences");
+
+PartitionPrefStore::Stats& PartitionPrefStore::Stats::operator+=(
+    const Stats& other) {
+  changes += other.changes;
+  commits += other.commits;
+  failed_commits += other.failed_commits;
+  bytes_written += other.bytes_written;
+  total_commit_latency += other.total_commit_latency;
+  max_commit_latency = std::max(max_commit_latency, other.max_commit_latency);
+  return *this;
+}
+
+PartitionPrefStore::PartitionPrefStore(const base::FilePath& partition_path)
+    : values_(base::Value::Type::DICTIONARY),
+      writer_(partition_path.Append(kFileName),
+              base::CreateSequencedTaskRunnerWithTraits(
+                  {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+                   base::TaskShutdownBehavior::BLOCK_SHUTDOWN}),
+              kCommitInterval),
+      weak_factory_(this) {
+  values_ = ReadValues(writer_.path(), &is_new_);
+}
+
+PartitionPrefStore::~PartitionPrefStore() {
+  CommitPendingWrite();
+}
+
+void PartitionPrefStore::ScheduleWrite() {
+  ++stats_.changes;
+  writer_.ScheduleWrite(this);
+}
+
+void PartitionPrefStore::CommitPendingWrite() {
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+}
+
+bool PartitionPrefStore::SerializeData(std::string* output) {
+  if (!base::JSONWriter::Write(values_, output))
+    return false;
+  // The partition directory is usually there already, but nothing else has
+  // to be written to it for a partition to be used.
+  writer_.RegisterOnNextWriteCallbacks(
+      base::BindOnce(base::IgnoreResult(&base::CreateDirectory),
+                     writer_.path().DirName()),
+      base::BindOnce(&ReportCommit, base::SequencedTaskRunnerHandle::Get(),
+                     base::BindOnce(&PartitionPrefStore::OnCommitted,
+                                    weak_factory_.GetWeakPtr(),
+                                    output->size()),
+                     base::TimeTicks::Now()));
+  return true;
+}
+
+void PartitionPrefStore::OnCommitted(size_t bytes,
+                                     base::TimeDelta latency,
+                                     bool success) {
+  if (!success) {
+    ++stats_.failed_commits;
+    return;
+  }
+  ++stats_.commits;
+  stats_.bytes_written += bytes;
+  stats_.total_commit_latency += latency;
+  stats_.max_commit_latency = std::max(stats_.max_commit_latency, latency);
+}
+
+}  // namespace electron
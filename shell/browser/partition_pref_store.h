@@ -0,0 +1,81 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_PARTITION_PREF_STORE_H_
+#define SHELL_BROWSER_PARTITION_PREF_STORE_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace electron {
+
+// Keeps the preferences of one storage partition, like its zoom levels, in a
+// small JSON file of its own rather than in the Preferences file of the
+// browser context.
+//
+// Changes are made to the values in memory and followed by ScheduleWrite().
+// Writes are coalesced over a short interval and done on a background
+// sequence, so a burst of changes costs a single write of this file.
+class PartitionPrefStore : public base::ImportantFileWriter::DataSerializer {
+ public:
+  struct Stats {
+    Stats& operator+=(const Stats& other);
+
+    // Number of ScheduleWrite() calls.
+    uint64_t changes = 0;
+    uint64_t commits = 0;
+    uint64_t failed_commits = 0;
+    uint64_t bytes_written = 0;
+    // Time from serializing the values to the file being replaced.
+    base::TimeDelta total_commit_latency;
+    base::TimeDelta max_commit_latency;
+  };
+
+  // The name of the file in the partition directory.
+  static const base::FilePath::CharType kFileName[];
+
+  // Reads the file in |partition_path| synchronously. A missing or invalid
+  // file results in empty values.
+  explicit PartitionPrefStore(const base::FilePath& partition_path);
+  ~PartitionPrefStore() override;
+
+  // A dictionary holding the preferences.
+  base::Value* values() { return &values_; }
+  const base::Value& values() const { return values_; }
+
+  // Whether the file did not exist when the store was created.
+  bool is_new() const { return is_new_; }
+
+  void ScheduleWrite();
+
+  // Starts writing pending changes right away.
+  void CommitPendingWrite();
+
+  const Stats& stats() const { return stats_; }
+
+  // base::ImportantFileWriter::DataSerializer:
+  bool SerializeData(std::string* output) override;
+
+ private:
+  void OnCommitted(size_t bytes, base::TimeDelta latency, bool success);
+
+  base::Value values_;
+  bool is_new_ = true;
+  base::ImportantFileWriter writer_;
+  Stats stats_;
+
+  base::WeakPtrFactory<PartitionPrefStore> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(PartitionPrefStore);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_PARTITION_PREF_STORE_H_
@@ -4,14 +4,18 @@
 
 #include "shell/browser/printing/print_preview_message_handler.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/files/file.h"
 #include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/task/post_task.h"
+#include "base/threading/scoped_blocking_call.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/printing/print_job_manager.h"
 #include "chrome/browser/printing/printer_query.h"
@@ -47,6 +51,72 @@ void StopWorker(int document_cookie) {
   }
 }
 
+// Writes in pieces, base::File takes the size as an int.
+constexpr size_t kMaxWriteSize = 64 * 1024 * 1024;
+
+bool WritePdfToFile(const base::FilePath& path,
+                    scoped_refptr<base::RefCountedMemory> data_bytes) {
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  base::File file(path, base::File::FLAG_CREATE_ALWAYS |
+                            base::File::FLAG_WRITE);
+  if (!file.IsValid())
+    return false;
+  const char* data = reinterpret_cast<const char*>(data_bytes->front());
+  size_t remaining = data_bytes->size();
+  while (remaining > 0) {
+    int size = static_cast<int>(std::min(remaining, kMaxWriteSize));
+    int written = file.WriteAtCurrentPos(data, size);
+    if (written <= 0)
+      return false;
+    data += written;
+    remaining -= written;
+  }
+  return true;
+}
+
+void OnPdfWritten(util::Promise<v8::Local<v8::Value>> promise,
+                  const base::FilePath& path,
+                  bool success) {
+  if (!success) {
+    promise.RejectWithErrorMessage("Failed to write PDF to " +
+                                   path.AsUTF8Unsafe());
+    return;
+  }
+  v8::Isolate* isolate = promise.isolate();
+  mate::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  promise.Resolve(v8::Undefined(isolate));
+}
+
+void ResolvePdfPromise(PrintPreviewMessageHandler::Output output,
+                       const base::FilePath& path,
+                       util::Promise<v8::Local<v8::Value>> promise,
+                       const std::string& error,
+                       scoped_refptr<base::RefCountedMemory> data) {
+  if (!error.empty()) {
+    promise.RejectWithErrorMessage(error);
+    return;
+  }
+
+  // The mapping of the PDF is kept alive until it has been written, instead
+  // of being copied to the main thread first.
+  if (output == PrintPreviewMessageHandler::Output::kFile) {
+    PrintPreviewMessageHandler::WritePdf(
+        path, std::move(data),
+        base::BindOnce(&OnPdfWritten, std::move(promise), path));
+    return;
+  }
+
+  v8::Isolate* isolate = promise.isolate();
+  mate::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(
+      v8::Local<v8::Context>::New(isolate, promise.GetContext()));
+  promise.Resolve(
+      PrintPreviewMessageHandler::PdfToV8(isolate, output, std::move(data)));
+}
+
 }  // namespace
 
 PrintPreviewMessageHandler::PrintPreviewMessageHandler(
@@ -90,7 +160,7 @@ void PrintPreviewMessageHandler::OnMetafileReadyForPrinting(
   const PrintHostMsg_DidPrintContent_Params& content = params.content;
   if (!content.metafile_data_region.IsValid() ||
       params.expected_pages_count <= 0) {
-    RejectPromise(ids.request_id);
+    RejectRequest(ids.request_id);
     return;
   }
 
@@ -103,7 +173,7 @@ void PrintPreviewMessageHandler::OnMetafileReadyForPrinting(
         base::BindOnce(&PrintPreviewMessageHandler::OnCompositePdfDocumentDone,
                        weak_ptr_factory_.GetWeakPtr(), ids));
   } else {
-    ResolvePromise(ids.request_id,
+    ResolveRequest(ids.request_id,
                    base::RefCountedSharedMemoryMapping::CreateFromWholeRegion(
                        content.metafile_data_region));
   }
@@ -117,11 +187,11 @@ void PrintPreviewMessageHandler::OnCompositePdfDocumentDone(
 
   if (status != printing::mojom::PdfCompositor::Status::kSuccess) {
     DLOG(ERROR) << "Compositing pdf failed with error " << status;
-    RejectPromise(ids.request_id);
+    RejectRequest(ids.request_id);
     return;
   }
 
-  ResolvePromise(
+  ResolveRequest(
       ids.request_id,
       base::RefCountedSharedMemoryMapping::CreateFromWholeRegion(region));
 }
@@ -131,7 +201,7 @@ void PrintPreviewMessageHandler::OnPrintPreviewFailed(
     const PrintHostMsg_PreviewIds& ids) {
   StopWorker(document_cookie);
 
-  RejectPromise(ids.request_id);
+  RejectRequest(ids.request_id);
 }
 
 void PrintPreviewMessageHandler::OnPrintPreviewCancelled(
@@ -139,15 +209,15 @@ void PrintPreviewMessageHandler::OnPrintPreviewCancelled(
     const PrintHostMsg_PreviewIds& ids) {
   StopWorker(document_cookie);
 
-  RejectPromise(ids.request_id);
+  RejectRequest(ids.request_id);
 }
 
 void PrintPreviewMessageHandler::PrintToPDF(
     const base::DictionaryValue& options,
-    electron::util::Promise<v8::Local<v8::Value>> promise) {
+    PrintToPDFCallback callback) {
   int request_id;
   options.GetInteger(printing::kPreviewRequestID, &request_id);
-  promise_map_.emplace(request_id, std::move(promise));
+  callback_map_.emplace(request_id, std::move(callback));
 
   auto* focused_frame = web_contents()->GetFocusedFrame();
   auto* rfh = focused_frame && focused_frame->HasSelection()
@@ -156,44 +226,68 @@ void PrintPreviewMessageHandler::PrintToPDF(
   rfh->Send(new PrintMsg_PrintPreview(rfh->GetRoutingID(), options));
 }
 
-util::Promise<v8::Local<v8::Value>> PrintPreviewMessageHandler::GetPromise(
-    int request_id) {
-  auto it = promise_map_.find(request_id);
-  DCHECK(it != promise_map_.end());
+void PrintPreviewMessageHandler::PrintToPDF(
+    const base::DictionaryValue& options,
+    Output output,
+    const base::FilePath& path,
+    util::Promise<v8::Local<v8::Value>> promise) {
+  PrintToPDF(options, base::BindOnce(&ResolvePdfPromise, output, path,
+                                     std::move(promise)));
+}
 
-  util::Promise<v8::Local<v8::Value>> promise = std::move(it->second);
-  promise_map_.erase(it);
+// static
+v8::Local<v8::Value> PrintPreviewMessageHandler::PdfToV8(
+    v8::Isolate* isolate,
+    Output output,
+    scoped_refptr<base::RefCountedMemory> data) {
+  DCHECK(output != Output::kFile);
+  const char* bytes = reinterpret_cast<const char*>(data->front());
+  size_t size = data->size();
+  if (output == Output::kBuffer)
+    return node::Buffer::Copy(isolate, bytes, size).ToLocalChecked();
+  // The mapping is read-only, JavaScript always gets a copy it can write to.
+  v8::Local<v8::ArrayBuffer> array_buffer = v8::ArrayBuffer::New(isolate, size);
+  if (size > 0)
+    memcpy(array_buffer->GetContents().Data(), bytes, size);
+  return array_buffer;
+}
 
-  return promise;
+// static
+void PrintPreviewMessageHandler::WritePdf(
+    const base::FilePath& path,
+    scoped_refptr<base::RefCountedMemory> data,
+    base::OnceCallback<void(bool)> callback) {
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&WritePdfToFile, path, std::move(data)),
+      std::move(callback));
 }
 
-void PrintPreviewMessageHandler::ResolvePromise(
-    int request_id,
-    scoped_refptr<base::RefCountedMemory> data_bytes) {
-  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+PrintPreviewMessageHandler::PrintToPDFCallback
+PrintPreviewMessageHandler::TakeCallback(int request_id) {
+  auto it = callback_map_.find(request_id);
+  DCHECK(it != callback_map_.end());
 
-  util::Promise<v8::Local<v8::Value>> promise = GetPromise(request_id);
+  PrintToPDFCallback callback = std::move(it->second);
+  callback_map_.erase(it);
 
-  v8::Isolate* isolate = promise.isolate();
-  mate::Locker locker(isolate);
-  v8::HandleScope handle_scope(isolate);
-  v8::Context::Scope context_scope(
-      v8::Local<v8::Context>::New(isolate, promise.GetContext()));
+  return callback;
+}
 
-  v8::Local<v8::Value> buffer =
-      node::Buffer::Copy(isolate,
-                         reinterpret_cast<const char*>(data_bytes->front()),
-                         data_bytes->size())
-          .ToLocalChecked();
+void PrintPreviewMessageHandler::ResolveRequest(
+    int request_id,
+    scoped_refptr<base::RefCountedMemory> data_bytes) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
-  promise.Resolve(buffer);
+  TakeCallback(request_id).Run(std::string(), std::move(data_bytes));
 }
 
-void PrintPreviewMessageHandler::RejectPromise(int request_id) {
+void PrintPreviewMessageHandler::RejectRequest(int request_id) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
-  util::Promise<v8::Local<v8::Value>> promise = GetPromise(request_id);
-  promise.RejectWithErrorMessage("Failed to generate PDF");
+  TakeCallback(request_id).Run("Failed to generate PDF", nullptr);
 }
 
 WEB_CONTENTS_USER_DATA_KEY_IMPL(PrintPreviewMessageHandler)
@@ -6,7 +6,10 @@
 #define SHELL_BROWSER_PRINTING_PRINT_PREVIEW_MESSAGE_HANDLER_H_
 
 #include <map>
+#include <string>
 
+#include "base/callback.h"
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "components/services/pdf_compositor/public/mojom/pdf_compositor.mojom.h"
@@ -29,11 +32,43 @@ class PrintPreviewMessageHandler
     : public content::WebContentsObserver,
       public content::WebContentsUserData<PrintPreviewMessageHandler> {
  public:
+  // How the generated PDF is handed to JavaScript.
+  enum class Output {
+    // A Buffer holding a copy of the PDF.
+    kBuffer,
+    // An ArrayBuffer holding a copy of the PDF.
+    kArrayBuffer,
+    // The PDF is written to a file on a background sequence, the promise is
+    // resolved once it has been written.
+    kFile,
+  };
+
+  // Gets the PDF, or an |error| when it could not be generated.
+  using PrintToPDFCallback =
+      base::OnceCallback<void(const std::string& error,
+                              scoped_refptr<base::RefCountedMemory> data)>;
+
   ~PrintPreviewMessageHandler() override;
 
   void PrintToPDF(const base::DictionaryValue& options,
+                  PrintToPDFCallback callback);
+  void PrintToPDF(const base::DictionaryValue& options,
+                  Output output,
+                  const base::FilePath& path,
                   util::Promise<v8::Local<v8::Value>> promise);
 
+  // Converts |data| to a Buffer or an ArrayBuffer, depending on |output|.
+  static v8::Local<v8::Value> PdfToV8(
+      v8::Isolate* isolate,
+      Output output,
+      scoped_refptr<base::RefCountedMemory> data);
+
+  // Writes |data| to |path| on a background sequence, then runs |callback|
+  // with whether it succeeded.
+  static void WritePdf(const base::FilePath& path,
+                       scoped_refptr<base::RefCountedMemory> data,
+                       base::OnceCallback<void(bool)> callback);
+
  protected:
   // content::WebContentsObserver implementation.
   bool OnMessageReceived(const IPC::Message& message,
@@ -56,15 +91,14 @@ class PrintPreviewMessageHandler
   void OnPrintPreviewCancelled(int document_cookie,
                                const PrintHostMsg_PreviewIds& ids);
 
-  util::Promise<v8::Local<v8::Value>> GetPromise(int request_id);
+  PrintToPDFCallback TakeCallback(int request_id);
 
-  void ResolvePromise(int request_id,
+  void ResolveRequest(int request_id,
                       scoped_refptr<base::RefCountedMemory> data_bytes);
-  void RejectPromise(int request_id);
+  void RejectRequest(int request_id);
 
-  using PromiseMap =
-      std::map<int, electron::util::Promise<v8::Local<v8::Value>>>;
-  PromiseMap promise_map_;
+  using CallbackMap = std::map<int, PrintToPDFCallback>;
+  CallbackMap callback_map_;
 
   base::WeakPtrFactory<PrintPreviewMessageHandler> weak_ptr_factory_;
 
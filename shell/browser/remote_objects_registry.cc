@@ -0,0 +1,149 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/remote_objects_registry.h"
+
+#include <limits>
+#include <utility>
+
+#include "base/logging.h"
+#include "shell/common/gin_helper/key_cache.h"
+
+namespace electron {
+
+namespace {
+
+// The hidden value that maps objects back to their handle.
+v8::Local<v8::Private> GetIdKey(v8::Isolate* isolate) {
+  return v8::Private::ForApi(isolate, gin_helper::KeyToV8(isolate, "atomId"));
+}
+
+}  // namespace
+
+RemoteObjectsRegistry::Entry::Entry() = default;
+
+RemoteObjectsRegistry::Entry::Entry(Entry&&) = default;
+
+RemoteObjectsRegistry::Entry::~Entry() = default;
+
+// static
+RemoteObjectsRegistry* RemoteObjectsRegistry::GetInstance() {
+  static base::NoDestructor<RemoteObjectsRegistry> instance;
+  return instance.get();
+}
+
+RemoteObjectsRegistry::RemoteObjectsRegistry() = default;
+
+RemoteObjectsRegistry::~RemoteObjectsRegistry() = default;
+
+int32_t RemoteObjectsRegistry::Add(v8::Isolate* isolate,
+                                   const std::string& owner,
+                                   v8::Local<v8::Object> object) {
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  int32_t id = 0;
+  v8::Local<v8::Value> value;
+  if (object->GetPrivate(context, GetIdKey(isolate)).ToLocal(&value) &&
+      value->IsInt32())
+    id = value.As<v8::Int32>()->Value();
+  auto entry = entries_.find(id);
+  if (entry == entries_.end()) {
+    id = Store(isolate, object);
+    entry = entries_.find(id);
+  }
+
+  // The object is referenced once by every owner it was sent to.
+  auto& refs = owners_[owner];
+  auto iter = refs.find(id);
+  if (iter == refs.end()) {
+    refs.emplace(id, 1);
+    entry->second.owners++;
+  } else {
+    iter->second++;
+  }
+  return id;
+}
+
+v8::Local<v8::Object> RemoteObjectsRegistry::Get(v8::Isolate* isolate,
+                                                 int32_t id) const {
+  auto entry = entries_.find(id);
+  if (entry == entries_.end())
+    return v8::Local<v8::Object>();
+  return v8::Local<v8::Object>::New(isolate, entry->second.object);
+}
+
+void RemoteObjectsRegistry::Remove(v8::Isolate* isolate,
+                                   const std::string& owner,
+                                   int32_t id,
+                                   int ref_count) {
+  auto owner_iter = owners_.find(owner);
+  if (owner_iter == owners_.end())
+    return;
+  auto& refs = owner_iter->second;
+  auto iter = refs.find(id);
+  if (iter == refs.end())
+    return;
+
+  // Only release the object once the renderer collected as many references
+  // as were sent to it.
+  iter->second -= ref_count;
+  if (iter->second > 0)
+    return;
+  refs.erase(iter);
+  Dereference(isolate, id);
+}
+
+void RemoteObjectsRegistry::Clear(v8::Isolate* isolate,
+                                  const std::string& owner) {
+  auto owner_iter = owners_.find(owner);
+  if (owner_iter == owners_.end())
+    return;
+  std::unordered_map<int32_t, int> refs = std::move(owner_iter->second);
+  owners_.erase(owner_iter);
+  for (const auto& ref : refs)
+    Dereference(isolate, ref.first);
+}
+
+bool RemoteObjectsRegistry::HasOwner(const std::string& owner) const {
+  return owners_.find(owner) != owners_.end();
+}
+
+int32_t RemoteObjectsRegistry::Store(v8::Isolate* isolate,
+                                     v8::Local<v8::Object> object) {
+  // Every positive int32_t is a handle.
+  CHECK_LT(entries_.size(),
+           static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+      << "Too many remote objects";
+  // Wraps around after 2^31 - 1 handles, skipping the ones still in use.
+  do {
+    last_id_ = last_id_ == std::numeric_limits<int32_t>::max() ? 1
+                                                                : last_id_ + 1;
+  } while (entries_.find(last_id_) != entries_.end());
+
+  int32_t id = last_id_;
+  entries_[id].object.Reset(isolate, object);
+  object
+      ->SetPrivate(isolate->GetCurrentContext(), GetIdKey(isolate),
+                   v8::Integer::New(isolate, id))
+      .Check();
+  return id;
+}
+
+void RemoteObjectsRegistry::Dereference(v8::Isolate* isolate, int32_t id) {
+  auto entry = entries_.find(id);
+  if (entry == entries_.end() || --entry->second.owners > 0)
+    return;
+
+  v8::HandleScope handle_scope(isolate);
+  // Replace the hidden value instead of deleting it, which would turn the
+  // object into dictionary mode.
+  v8::Local<v8::Object> object =
+      v8::Local<v8::Object>::New(isolate, entry->second.object);
+  object
+      ->SetPrivate(isolate->GetCurrentContext(), GetIdKey(isolate),
+                   v8::Undefined(isolate))
+      .Check();
+  entries_.erase(entry);
+}
+
+}  // namespace electron
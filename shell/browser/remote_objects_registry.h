@@ -0,0 +1,85 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_BROWSER_REMOTE_OBJECTS_REGISTRY_H_
+#define SHELL_BROWSER_REMOTE_OBJECTS_REGISTRY_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Keeps alive the objects of the browser process that renderer processes
+// reference through the remote module.
+//
+// Objects are identified by integer handles that are handed out in increasing
+// order, which keeps the caches of the renderers dense, and that are only
+// handed out again after the other 2^31 - 1 have been, so a handle that
+// outlived its object does not reach a newer one. Every owner, a JavaScript
+// context of a renderer, counts the references it was sent to each object,
+// and an object is released once no owner references it anymore.
+class RemoteObjectsRegistry {
+ public:
+  static RemoteObjectsRegistry* GetInstance();
+
+  // Adds a reference of |owner| to |object| and returns the handle of the
+  // object. An object keeps its handle for as long as it is registered.
+  int32_t Add(v8::Isolate* isolate,
+              const std::string& owner,
+              v8::Local<v8::Object> object);
+
+  // Returns the object of |id|, or an empty handle if it has been released.
+  v8::Local<v8::Object> Get(v8::Isolate* isolate, int32_t id) const;
+
+  // Drops the |ref_count| references of |owner| to |id| that were collected
+  // in the renderer. References sent after the renderer counted its own are
+  // kept.
+  void Remove(v8::Isolate* isolate,
+              const std::string& owner,
+              int32_t id,
+              int ref_count);
+
+  // Drops all references of |owner|.
+  void Clear(v8::Isolate* isolate, const std::string& owner);
+
+  bool HasOwner(const std::string& owner) const;
+
+  // The number of registered objects.
+  size_t size() const { return entries_.size(); }
+
+ private:
+  friend class base::NoDestructor<RemoteObjectsRegistry>;
+
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    ~Entry();
+
+    v8::Global<v8::Object> object;
+    // The number of owners referencing the object.
+    int owners = 0;
+  };
+
+  RemoteObjectsRegistry();
+  ~RemoteObjectsRegistry();
+
+  int32_t Store(v8::Isolate* isolate, v8::Local<v8::Object> object);
+  void Dereference(v8::Isolate* isolate, int32_t id);
+
+  std::unordered_map<int32_t, Entry> entries_;
+  // The last handle handed out, no handle is 0.
+  int32_t last_id_ = 0;
+  // { owner => { id => ref_count } }
+  std::unordered_map<std::string, std::unordered_map<int32_t, int>> owners_;
+
+  DISALLOW_COPY_AND_ASSIGN(RemoteObjectsRegistry);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_BROWSER_REMOTE_OBJECTS_REGISTRY_H_
@@ -12,6 +12,7 @@
 #include "base/command_line.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "cc/base/switches.h"
 #include "content/public/browser/render_frame_host.h"
@@ -95,13 +96,25 @@ bool GetAsAutoplayPolicy(const base::Value* val,
 
 namespace electron {
 
+WebContentsPreferences::Parsed::Parsed() = default;
+WebContentsPreferences::Parsed::Parsed(const Parsed&) = default;
+WebContentsPreferences::Parsed& WebContentsPreferences::Parsed::operator=(
+    const Parsed&) = default;
+WebContentsPreferences::Parsed::~Parsed() = default;
+
+// static
+std::unordered_map<int, std::vector<WebContentsPreferences*>>
+    WebContentsPreferences::process_index_;
+
 // static
-std::vector<WebContentsPreferences*> WebContentsPreferences::instances_;
+uint64_t WebContentsPreferences::next_sequence_number_ = 0;
 
 WebContentsPreferences::WebContentsPreferences(
     content::WebContents* web_contents,
     const mate::Dictionary& web_preferences)
-    : web_contents_(web_contents) {
+    : content::WebContentsObserver(web_contents),
+      web_contents_(web_contents),
+      sequence_number_(next_sequence_number_++) {
   v8::Isolate* isolate = web_preferences.isolate();
   mate::Dictionary copied(isolate, web_preferences.GetHandle()->Clone());
   // Following fields should not be stored.
@@ -112,7 +125,7 @@ WebContentsPreferences::WebContentsPreferences(
   mate::ConvertFromV8(isolate, copied.GetHandle(), &preference_);
   web_contents->SetUserData(UserDataKey(), base::WrapUnique(this));
 
-  instances_.push_back(this);
+  UpdateProcessID();
 
   // Set WebPreferences defaults onto the JS object
   SetDefaultBoolIfUndefined(options::kPlugins, false);
@@ -153,8 +166,7 @@ WebContentsPreferences::WebContentsPreferences(
       auto* embedder = manager->GetEmbedder(guest_instance_id);
       if (embedder) {
         auto* embedder_preferences = WebContentsPreferences::From(embedder);
-        if (embedder_preferences &&
-            embedder_preferences->IsEnabled(options::kOffscreen)) {
+        if (embedder_preferences && embedder_preferences->parsed().offscreen) {
           preference_.SetKey(options::kOffscreen, base::Value(true));
         }
       }
@@ -165,8 +177,7 @@ WebContentsPreferences::WebContentsPreferences(
 }
 
 WebContentsPreferences::~WebContentsPreferences() {
-  instances_.erase(std::remove(instances_.begin(), instances_.end(), this),
-                   instances_.end());
+  RemoveFromProcessIndex();
 }
 
 void WebContentsPreferences::SetDefaults() {
@@ -177,6 +188,67 @@ void WebContentsPreferences::SetDefaults() {
   }
 
   last_preference_ = preference_.Clone();
+  ParsePreferences();
+}
+
+void WebContentsPreferences::ParsePreferences() {
+  Parsed parsed;
+  parsed.plugins = IsEnabled(options::kPlugins);
+  parsed.experimental_features = IsEnabled(options::kExperimentalFeatures);
+  parsed.node_integration = IsEnabled(options::kNodeIntegration);
+  parsed.node_integration_in_sub_frames =
+      IsEnabled(options::kNodeIntegrationInSubFrames);
+  parsed.node_integration_in_worker =
+      IsEnabled(options::kNodeIntegrationInWorker);
+  parsed.disable_html_fullscreen_window_resize =
+      IsEnabled(options::kDisableHtmlFullscreenWindowResize);
+  parsed.webview_tag = IsEnabled(options::kWebviewTag);
+  parsed.sandbox = IsEnabled(options::kSandbox);
+  parsed.native_window_open = IsEnabled(options::kNativeWindowOpen);
+  parsed.context_isolation = IsEnabled(options::kContextIsolation);
+  parsed.javascript = IsEnabled(options::kJavaScript, true);
+  parsed.images = IsEnabled(options::kImages, true);
+  parsed.text_areas_are_resizable =
+      IsEnabled(options::kTextAreasAreResizable, true);
+  parsed.webgl = IsEnabled(options::kWebGL, true);
+  parsed.web_security = IsEnabled(options::kWebSecurity, true);
+  parsed.allow_running_insecure_content = IsEnabled(
+      options::kAllowRunningInsecureContent, !parsed.web_security);
+  parsed.navigate_on_drag_drop = IsEnabled(options::kNavigateOnDragDrop);
+  parsed.scroll_bounce = IsEnabled(options::kScrollBounce);
+  parsed.offscreen = IsEnabled(options::kOffscreen);
+  parsed.enable_remote_module = IsEnabled(options::kEnableRemoteModule, true);
+  parsed.disable_popups = IsEnabled("disablePopups");
+  parsed.safe_dialogs = IsEnabled("safeDialogs");
+  parsed.ignore_menu_shortcuts = IsEnabled("ignoreMenuShortcuts");
+
+  std::string s;
+  if (GetAsString(&preference_, options::kBackgroundColor, &s))
+    parsed.background_color = s;
+  if (GetAsString(&preference_, "safeDialogsMessage", &s))
+    parsed.safe_dialogs_message = s;
+  if (GetAsString(&preference_, "affinity", &s))
+    parsed.affinity = base::ToLowerASCII(s);
+  if (GetAsString(&preference_, "defaultEncoding", &s))
+    parsed.default_encoding = s;
+
+  int i;
+  if (GetAsInteger(&preference_, options::kGuestInstanceID, &i))
+    parsed.guest_instance_id = i;
+  if (GetAsInteger(&preference_, options::kOpenerID, &i))
+    parsed.opener_id = i;
+  if (GetAsInteger(&preference_, "defaultFontSize", &i))
+    parsed.default_font_size = i;
+  if (GetAsInteger(&preference_, "defaultMonospaceFontSize", &i))
+    parsed.default_monospace_font_size = i;
+  if (GetAsInteger(&preference_, "minimumFontSize", &i))
+    parsed.minimum_font_size = i;
+
+  content::AutoplayPolicy policy;
+  if (GetAsAutoplayPolicy(&preference_, "autoplayPolicy", &policy))
+    parsed.autoplay_policy = policy;
+
+  parsed_ = parsed;
 }
 
 bool WebContentsPreferences::SetDefaultBoolIfUndefined(base::StringPiece key,
@@ -214,6 +286,13 @@ void WebContentsPreferences::Merge(const base::DictionaryValue& extend) {
 void WebContentsPreferences::Clear() {
   if (preference_.is_dict())
     static_cast<base::DictionaryValue*>(&preference_)->Clear();
+  ParsePreferences();
+}
+
+void WebContentsPreferences::SetPreference(base::StringPiece name,
+                                           base::Value value) {
+  preference_.SetKey(name, std::move(value));
+  ParsePreferences();
 }
 
 bool WebContentsPreferences::GetPreference(base::StringPiece name,
@@ -248,12 +327,50 @@ bool WebContentsPreferences::GetPreloadPath(
 // static
 content::WebContents* WebContentsPreferences::GetWebContentsFromProcessID(
     int process_id) {
-  for (WebContentsPreferences* preferences : instances_) {
-    content::WebContents* web_contents = preferences->web_contents_;
-    if (web_contents->GetMainFrame()->GetProcess()->GetID() == process_id)
-      return web_contents;
-  }
-  return nullptr;
+  auto it = process_index_.find(process_id);
+  if (it == process_index_.end() || it->second.empty())
+    return nullptr;
+  content::WebContents* web_contents = it->second.front()->web_contents_;
+  DCHECK_EQ(web_contents->GetMainFrame()->GetProcess()->GetID(), process_id);
+  return web_contents;
+}
+
+void WebContentsPreferences::RenderFrameHostChanged(
+    content::RenderFrameHost* old_host,
+    content::RenderFrameHost* new_host) {
+  // Only a swap of the main frame can move the WebContents to another
+  // process.
+  if (new_host && !new_host->GetParent())
+    UpdateProcessID();
+}
+
+void WebContentsPreferences::UpdateProcessID() {
+  int process_id = web_contents_->GetMainFrame()->GetProcess()->GetID();
+  if (process_id == process_id_)
+    return;
+  RemoveFromProcessIndex();
+  process_id_ = process_id;
+  AddToProcessIndex();
+}
+
+void WebContentsPreferences::AddToProcessIndex() {
+  auto& entry = process_index_[process_id_];
+  auto it = std::find_if(entry.begin(), entry.end(),
+                         [this](WebContentsPreferences* other) {
+                           return other->sequence_number_ > sequence_number_;
+                         });
+  entry.insert(it, this);
+}
+
+void WebContentsPreferences::RemoveFromProcessIndex() {
+  auto it = process_index_.find(process_id_);
+  if (it == process_index_.end())
+    return;
+  auto& entry = it->second;
+  entry.erase(std::remove(entry.begin(), entry.end(), this), entry.end());
+  if (entry.empty())
+    process_index_.erase(it);
+  process_id_ = -1;
 }
 
 // static
@@ -268,36 +385,36 @@ void WebContentsPreferences::AppendCommandLineSwitches(
     base::CommandLine* command_line,
     bool is_subframe) {
   // Check if plugins are enabled.
-  if (IsEnabled(options::kPlugins))
+  if (parsed_.plugins)
     command_line->AppendSwitch(switches::kEnablePlugins);
 
   // Experimental flags.
-  if (IsEnabled(options::kExperimentalFeatures))
+  if (parsed_.experimental_features)
     command_line->AppendSwitch(
         ::switches::kEnableExperimentalWebPlatformFeatures);
 
   // Check if we have node integration specified.
-  if (IsEnabled(options::kNodeIntegration))
+  if (parsed_.node_integration)
     command_line->AppendSwitch(switches::kNodeIntegration);
 
   // Whether to enable node integration in Worker.
-  if (IsEnabled(options::kNodeIntegrationInWorker))
+  if (parsed_.node_integration_in_worker)
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
   // Check if webview tag creation is enabled, default to nodeIntegration value.
-  if (IsEnabled(options::kWebviewTag))
+  if (parsed_.webview_tag)
     command_line->AppendSwitch(switches::kWebviewTag);
 
   // Sandbox can be enabled for renderer processes hosting cross-origin frames
   // unless nodeIntegrationInSubFrames is enabled
   bool can_sandbox_frame =
-      is_subframe && !IsEnabled(options::kNodeIntegrationInSubFrames);
+      is_subframe && !parsed_.node_integration_in_sub_frames;
 
   // If the `sandbox` option was passed to the BrowserWindow's webPreferences,
   // pass `--enable-sandbox` to the renderer so it won't have any node.js
   // integration. Otherwise disable Chromium sandbox, unless app.enableSandbox()
   // was called.
-  if (IsEnabled(options::kSandbox) || can_sandbox_frame) {
+  if (parsed_.sandbox || can_sandbox_frame) {
     command_line->AppendSwitch(switches::kEnableSandbox);
   } else if (!command_line->HasSwitch(switches::kEnableSandbox)) {
     command_line->AppendSwitch(service_manager::switches::kNoSandbox);
@@ -305,7 +422,7 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   }
 
   // Check if nativeWindowOpen is enabled.
-  if (IsEnabled(options::kNativeWindowOpen))
+  if (parsed_.native_window_open)
     command_line->AppendSwitch(switches::kNativeWindowOpen);
 
   // The preload script.
@@ -324,43 +441,42 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   }
 
   // Whether to enable the remote module
-  if (IsEnabled(options::kEnableRemoteModule))
+  if (parsed_.enable_remote_module)
     command_line->AppendSwitch(switches::kEnableRemoteModule);
 
   // Run Electron APIs and preload script in isolated world
-  if (IsEnabled(options::kContextIsolation))
+  if (parsed_.context_isolation)
     command_line->AppendSwitch(switches::kContextIsolation);
 
   // --background-color.
-  std::string s;
-  if (GetAsString(&preference_, options::kBackgroundColor, &s)) {
-    command_line->AppendSwitchASCII(switches::kBackgroundColor, s);
-  } else if (!IsEnabled(options::kOffscreen)) {
+  if (parsed_.background_color) {
+    command_line->AppendSwitchASCII(switches::kBackgroundColor,
+                                    *parsed_.background_color);
+  } else if (!parsed_.offscreen) {
     // For non-OSR WebContents, we expect to have white background, see
     // https://github.com/electron/electron/issues/13764 for more.
     command_line->AppendSwitchASCII(switches::kBackgroundColor, "#fff");
   }
 
   // --offscreen
-  if (IsEnabled(options::kOffscreen)) {
+  if (parsed_.offscreen) {
     command_line->AppendSwitch(options::kOffscreen);
   }
 
   // --guest-instance-id, which is used to identify guest WebContents.
-  int guest_instance_id = 0;
-  if (GetAsInteger(&preference_, options::kGuestInstanceID, &guest_instance_id))
+  int guest_instance_id = parsed_.guest_instance_id.value_or(0);
+  if (parsed_.guest_instance_id)
     command_line->AppendSwitchASCII(switches::kGuestInstanceID,
                                     base::NumberToString(guest_instance_id));
 
   // Pass the opener's window id.
-  int opener_id;
-  if (GetAsInteger(&preference_, options::kOpenerID, &opener_id))
+  if (parsed_.opener_id)
     command_line->AppendSwitchASCII(switches::kOpenerID,
-                                    base::NumberToString(opener_id));
+                                    base::NumberToString(*parsed_.opener_id));
 
 #if defined(OS_MACOSX)
   // Enable scroll bounce.
-  if (IsEnabled(options::kScrollBounce))
+  if (parsed_.scroll_bounce)
     command_line->AppendSwitch(switches::kScrollBounce);
 #endif
 
@@ -378,6 +494,7 @@ void WebContentsPreferences::AppendCommandLineSwitches(
   }
 
   // Enable blink features.
+  std::string s;
   if (GetAsString(&preference_, options::kEnableBlinkFeatures, &s))
     command_line->AppendSwitchASCII(::switches::kEnableBlinkFeatures, s);
 
@@ -406,7 +523,7 @@ void WebContentsPreferences::AppendCommandLineSwitches(
     }
   }
 
-  if (IsEnabled(options::kNodeIntegrationInSubFrames))
+  if (parsed_.node_integration_in_sub_frames)
     command_line->AppendSwitch(switches::kNodeIntegrationInSubFrames);
 
   // We are appending args to a webContents so let's save the current state
@@ -417,30 +534,21 @@ void WebContentsPreferences::AppendCommandLineSwitches(
 
 void WebContentsPreferences::OverrideWebkitPrefs(
     content::WebPreferences* prefs) {
-  prefs->javascript_enabled =
-      IsEnabled(options::kJavaScript, true /* default_value */);
-  prefs->images_enabled = IsEnabled(options::kImages, true /* default_value */);
-  prefs->text_areas_are_resizable =
-      IsEnabled(options::kTextAreasAreResizable, true /* default_value */);
-  prefs->navigate_on_drag_drop =
-      IsEnabled(options::kNavigateOnDragDrop, false /* default_value */);
-  if (!GetAsAutoplayPolicy(&preference_, "autoplayPolicy",
-                           &prefs->autoplay_policy)) {
-    prefs->autoplay_policy = content::AutoplayPolicy::kNoUserGestureRequired;
-  }
+  prefs->javascript_enabled = parsed_.javascript;
+  prefs->images_enabled = parsed_.images;
+  prefs->text_areas_are_resizable = parsed_.text_areas_are_resizable;
+  prefs->navigate_on_drag_drop = parsed_.navigate_on_drag_drop;
+  prefs->autoplay_policy = parsed_.autoplay_policy.value_or(
+      content::AutoplayPolicy::kNoUserGestureRequired);
 
   // Check if webgl should be enabled.
-  bool is_webgl_enabled = IsEnabled(options::kWebGL, true /* default_value */);
-  prefs->webgl1_enabled = is_webgl_enabled;
-  prefs->webgl2_enabled = is_webgl_enabled;
+  prefs->webgl1_enabled = parsed_.webgl;
+  prefs->webgl2_enabled = parsed_.webgl;
 
   // Check if web security should be enabled.
-  bool is_web_security_enabled =
-      IsEnabled(options::kWebSecurity, true /* default_value */);
-  prefs->web_security_enabled = is_web_security_enabled;
+  prefs->web_security_enabled = parsed_.web_security;
   prefs->allow_running_insecure_content =
-      IsEnabled(options::kAllowRunningInsecureContent,
-                !is_web_security_enabled /* default_value */);
+      parsed_.allow_running_insecure_content;
 
   auto* fonts_dict = preference_.FindKeyOfType("defaultFontFamily",
                                                base::Value::Type::DICTIONARY);
@@ -460,16 +568,14 @@ void WebContentsPreferences::OverrideWebkitPrefs(
       prefs->fantasy_font_family_map[content::kCommonScript] = font;
   }
 
-  int size;
-  if (GetAsInteger(&preference_, "defaultFontSize", &size))
-    prefs->default_font_size = size;
-  if (GetAsInteger(&preference_, "defaultMonospaceFontSize", &size))
-    prefs->default_fixed_font_size = size;
-  if (GetAsInteger(&preference_, "minimumFontSize", &size))
-    prefs->minimum_font_size = size;
-  std::string encoding;
-  if (GetAsString(&preference_, "defaultEncoding", &encoding))
-    prefs->default_encoding = encoding;
+  if (parsed_.default_font_size)
+    prefs->default_font_size = *parsed_.default_font_size;
+  if (parsed_.default_monospace_font_size)
+    prefs->default_fixed_font_size = *parsed_.default_monospace_font_size;
+  if (parsed_.minimum_font_size)
+    prefs->minimum_font_size = *parsed_.minimum_font_size;
+  if (parsed_.default_encoding)
+    prefs->default_encoding = *parsed_.default_encoding;
 }
 
 WEB_CONTENTS_USER_DATA_KEY_IMPL(WebContentsPreferences)
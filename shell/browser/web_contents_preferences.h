@@ -6,19 +6,19 @@
 #define SHELL_BROWSER_WEB_CONTENTS_PREFERENCES_H_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "base/optional.h"
 #include "base/values.h"
+#include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "content/public/common/web_preferences.h"
 
 namespace base {
 class CommandLine;
 }
 
-namespace content {
-struct WebPreferences;
-}
-
 namespace mate {
 class Dictionary;
 }
@@ -27,8 +27,56 @@ namespace electron {
 
 // Stores and applies the preferences of WebContents.
 class WebContentsPreferences
-    : public content::WebContentsUserData<WebContentsPreferences> {
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<WebContentsPreferences> {
  public:
+  // The preferences that are checked repeatedly during the lifetime of a
+  // WebContents, parsed from the dictionary every time it changes so that
+  // checking them is a plain field read.
+  struct Parsed {
+    Parsed();
+    Parsed(const Parsed&);
+    Parsed& operator=(const Parsed&);
+    ~Parsed();
+
+    bool plugins = false;
+    bool experimental_features = false;
+    bool node_integration = false;
+    bool node_integration_in_sub_frames = false;
+    bool node_integration_in_worker = false;
+    bool disable_html_fullscreen_window_resize = false;
+    bool webview_tag = false;
+    bool sandbox = false;
+    bool native_window_open = false;
+    bool context_isolation = false;
+    bool javascript = true;
+    bool images = true;
+    bool text_areas_are_resizable = true;
+    bool webgl = true;
+    bool web_security = true;
+    bool allow_running_insecure_content = false;
+    bool navigate_on_drag_drop = false;
+    bool scroll_bounce = false;
+    bool offscreen = false;
+    bool enable_remote_module = true;
+    bool disable_popups = false;
+    bool safe_dialogs = false;
+    bool ignore_menu_shortcuts = false;
+
+    base::Optional<std::string> background_color;
+    base::Optional<std::string> safe_dialogs_message;
+    // Lower-cased, empty when not set.
+    std::string affinity;
+    base::Optional<int> guest_instance_id;
+    base::Optional<int> opener_id;
+
+    base::Optional<content::AutoplayPolicy> autoplay_policy;
+    base::Optional<int> default_font_size;
+    base::Optional<int> default_monospace_font_size;
+    base::Optional<int> minimum_font_size;
+    base::Optional<std::string> default_encoding;
+  };
+
   // Get self from WebContents.
   static WebContentsPreferences* From(content::WebContents* web_contents);
 
@@ -42,6 +90,12 @@ class WebContentsPreferences
   // A simple way to know whether a Boolean property is enabled.
   bool IsEnabled(base::StringPiece name, bool default_value = false) const;
 
+  // Returns the parsed form of the commonly checked preferences.
+  const Parsed& parsed() const { return parsed_; }
+
+  // Set a single preference, keeping the parsed preferences in sync.
+  void SetPreference(base::StringPiece name, base::Value value);
+
   // $.extend(|web_preferences|, |new_web_preferences|).
   void Merge(const base::DictionaryValue& new_web_preferences);
 
@@ -62,8 +116,13 @@ class WebContentsPreferences
   bool GetPreloadPath(base::FilePath::StringType* path) const;
 
   // Returns the web preferences.
-  base::Value* preference() { return &preference_; }
-  base::Value* last_preference() { return &last_preference_; }
+  const base::Value* preference() const { return &preference_; }
+  const base::Value* last_preference() const { return &last_preference_; }
+
+ protected:
+  // content::WebContentsObserver:
+  void RenderFrameHostChanged(content::RenderFrameHost* old_host,
+                              content::RenderFrameHost* new_host) override;
 
  private:
   friend class content::WebContentsUserData<WebContentsPreferences>;
@@ -78,13 +137,33 @@ class WebContentsPreferences
   // Set preference value to given bool
   void SetBool(base::StringPiece key, bool value);
 
-  static std::vector<WebContentsPreferences*> instances_;
+  // Refresh |parsed_| from |preference_|.
+  void ParsePreferences();
+
+  // Move this instance to the index entry of the main frame's process.
+  void UpdateProcessID();
+  void AddToProcessIndex();
+  void RemoveFromProcessIndex();
+
+  // Instances indexed by the ID of their main frame's process. Several
+  // WebContents can share a process, the instances of one process are kept
+  // in the order they were created.
+  static std::unordered_map<int, std::vector<WebContentsPreferences*>>
+      process_index_;
+  static uint64_t next_sequence_number_;
 
   content::WebContents* web_contents_;
 
+  // Order of creation, used to keep |process_index_| entries ordered.
+  const uint64_t sequence_number_;
+  // ID of the main frame's process, -1 when not indexed.
+  int process_id_ = -1;
+
   base::Value preference_ = base::Value(base::Value::Type::DICTIONARY);
   base::Value last_preference_ = base::Value(base::Value::Type::DICTIONARY);
 
+  Parsed parsed_;
+
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 
   DISALLOW_COPY_AND_ASSIGN(WebContentsPreferences);
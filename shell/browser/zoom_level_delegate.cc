@@ -11,13 +11,11 @@
 #include "base/bind.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/values.h"
-#include "components/prefs/json_pref_store.h"
-#include "components/prefs/pref_filter.h"
 #include "components/prefs/pref_registry_simple.h"
-#include "components/prefs/pref_service_factory.h"
 #include "components/prefs/scoped_user_pref_update.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/common/page_zoom.h"
+#include "shell/browser/partition_pref_store.h"
 
 namespace electron {
 
@@ -30,24 +28,40 @@ const char kPartitionDefaultZoomLevel[] = "partition.default_zoom_level";
 // be displayed at the default zoom level.
 const char kPartitionPerHostZoomLevels[] = "partition.per_host_zoom_levels";
 
+// The same values in the PartitionPrefStore, which only holds the values of
+// one partition.
+const char kDefaultZoomLevel[] = "default_zoom_level";
+const char kPerHostZoomLevels[] = "per_host_zoom_levels";
+
 std::string GetHash(const base::FilePath& partition_path) {
   size_t int_key = std::hash<base::FilePath>()(partition_path);
   return base::NumberToString(int_key);
 }
 
+bool IsZoomLevel(const base::Value& value) {
+  return value.is_double() || value.is_int();
+}
+
 }  // namespace
 
 // static
 void ZoomLevelDelegate::RegisterPrefs(PrefRegistrySimple* registry) {
+  // Only read to migrate the levels saved by older versions.
   registry->RegisterDictionaryPref(kPartitionDefaultZoomLevel);
   registry->RegisterDictionaryPref(kPartitionPerHostZoomLevels);
 }
 
 ZoomLevelDelegate::ZoomLevelDelegate(PrefService* pref_service,
+                                     PartitionPrefStore* pref_store,
                                      const base::FilePath& partition_path)
-    : pref_service_(pref_service), host_zoom_map_(nullptr) {
+    : pref_service_(pref_service),
+      pref_store_(pref_store),
+      host_zoom_map_(nullptr) {
   DCHECK(pref_service_);
+  DCHECK(pref_store_);
   partition_key_ = GetHash(partition_path);
+  if (pref_store_->is_new())
+    MigrateFromPrefService();
 }
 
 ZoomLevelDelegate::~ZoomLevelDelegate() = default;
@@ -56,20 +70,57 @@ void ZoomLevelDelegate::SetDefaultZoomLevelPref(double level) {
   if (content::ZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel()))
     return;
 
-  DictionaryPrefUpdate update(pref_service_, kPartitionDefaultZoomLevel);
-  update->SetDouble(partition_key_, level);
+  pref_store_->values()->SetKey(kDefaultZoomLevel, base::Value(level));
+  pref_store_->ScheduleWrite();
   host_zoom_map_->SetDefaultZoomLevel(level);
 }
 
 double ZoomLevelDelegate::GetDefaultZoomLevelPref() const {
-  double default_zoom_level = 0.0;
-
-  const base::DictionaryValue* default_zoom_level_dictionary =
-      pref_service_->GetDictionary(kPartitionDefaultZoomLevel);
-  // If no default has been previously set, the default returned is the
-  // value used to initialize default_zoom_level in this function.
-  default_zoom_level_dictionary->GetDouble(partition_key_, &default_zoom_level);
-  return default_zoom_level;
+  // If no default has been previously set, the default is 0.
+  const base::Value* level = pref_store_->values()->FindKey(kDefaultZoomLevel);
+  return level && IsZoomLevel(*level) ? level->GetDouble() : 0.0;
+}
+
+void ZoomLevelDelegate::MigrateFromPrefService() {
+  bool migrated = false;
+
+  const base::Value* default_level =
+      pref_service_->GetDictionary(kPartitionDefaultZoomLevel)
+          ->FindKey(partition_key_);
+  if (default_level) {
+    if (IsZoomLevel(*default_level)) {
+      pref_store_->values()->SetKey(kDefaultZoomLevel,
+                                    base::Value(default_level->GetDouble()));
+    }
+    DictionaryPrefUpdate update(pref_service_, kPartitionDefaultZoomLevel);
+    update->RemoveKey(partition_key_);
+    migrated = true;
+  }
+
+  const base::Value* host_levels =
+      pref_service_->GetDictionary(kPartitionPerHostZoomLevels)
+          ->FindKey(partition_key_);
+  if (host_levels) {
+    if (host_levels->is_dict())
+      pref_store_->values()->SetKey(kPerHostZoomLevels, host_levels->Clone());
+    DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
+    update->RemoveKey(partition_key_);
+    migrated = true;
+  }
+
+  if (migrated)
+    pref_store_->ScheduleWrite();
+}
+
+base::Value* ZoomLevelDelegate::GetPerHostZoomLevels() {
+  base::Value* values = pref_store_->values();
+  base::Value* host_levels =
+      values->FindKeyOfType(kPerHostZoomLevels, base::Value::Type::DICTIONARY);
+  if (!host_levels) {
+    host_levels = values->SetKey(
+        kPerHostZoomLevels, base::Value(base::Value::Type::DICTIONARY));
+  }
+  return host_levels;
 }
 
 void ZoomLevelDelegate::OnZoomLevelChanged(
@@ -78,37 +129,29 @@ void ZoomLevelDelegate::OnZoomLevelChanged(
     return;
 
   double level = change.zoom_level;
-  DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
-  base::DictionaryValue* host_zoom_dictionaries = update.Get();
-  DCHECK(host_zoom_dictionaries);
+  base::Value* host_levels = GetPerHostZoomLevels();
+  const base::Value* current = host_levels->FindKey(change.host);
 
   bool modification_is_removal =
       content::ZoomValuesEqual(level, host_zoom_map_->GetDefaultZoomLevel());
 
-  base::DictionaryValue* host_zoom_dictionary = nullptr;
-  if (!host_zoom_dictionaries->GetDictionary(partition_key_,
-                                             &host_zoom_dictionary)) {
-    host_zoom_dictionary = host_zoom_dictionaries->SetDictionary(
-        partition_key_, std::make_unique<base::DictionaryValue>());
+  if (modification_is_removal) {
+    if (!current)
+      return;
+    host_levels->RemoveKey(change.host);
+  } else {
+    if (current && IsZoomLevel(*current) && current->GetDouble() == level)
+      return;
+    host_levels->SetKey(change.host, base::Value(level));
   }
-
-  if (modification_is_removal)
-    host_zoom_dictionary->RemoveWithoutPathExpansion(change.host, nullptr);
-  else
-    host_zoom_dictionary->SetKey(change.host, base::Value(level));
+  pref_store_->ScheduleWrite();
 }
 
-void ZoomLevelDelegate::ExtractPerHostZoomLevels(
-    const base::DictionaryValue* host_zoom_dictionary) {
+void ZoomLevelDelegate::ExtractPerHostZoomLevels() {
+  base::Value* host_levels = GetPerHostZoomLevels();
   std::vector<std::string> keys_to_remove;
-  std::unique_ptr<base::DictionaryValue> host_zoom_dictionary_copy =
-      host_zoom_dictionary->DeepCopyWithoutEmptyChildren();
-  for (base::DictionaryValue::Iterator i(*host_zoom_dictionary_copy);
-       !i.IsAtEnd(); i.Advance()) {
-    const std::string& host(i.key());
-    double zoom_level = 0;
-
-    bool has_valid_zoom_level = i.value().GetAsDouble(&zoom_level);
+  for (const auto& item : host_levels->DictItems()) {
+    const std::string& host = item.first;
 
     // Filter out A) the empty host, B) zoom levels equal to the default; and
     // remember them, so that we can later erase them from Prefs.
@@ -116,27 +159,22 @@ void ZoomLevelDelegate::ExtractPerHostZoomLevels(
     // level was set to its current value. In either case, SetZoomLevelForHost
     // will ignore type B values, thus, to have consistency with HostZoomMap's
     // internal state, these values must also be removed from Prefs.
-    if (host.empty() || !has_valid_zoom_level ||
-        content::ZoomValuesEqual(zoom_level,
+    if (host.empty() || !IsZoomLevel(item.second) ||
+        content::ZoomValuesEqual(item.second.GetDouble(),
                                  host_zoom_map_->GetDefaultZoomLevel())) {
       keys_to_remove.push_back(host);
       continue;
     }
 
-    host_zoom_map_->SetZoomLevelForHost(host, zoom_level);
+    host_zoom_map_->SetZoomLevelForHost(host, item.second.GetDouble());
   }
 
   // Sanitize prefs to remove entries that match the default zoom level and/or
   // have an empty host.
-  {
-    DictionaryPrefUpdate update(pref_service_, kPartitionPerHostZoomLevels);
-    base::DictionaryValue* host_zoom_dictionaries = update.Get();
-    base::DictionaryValue* sanitized_host_zoom_dictionary = nullptr;
-    host_zoom_dictionaries->GetDictionary(partition_key_,
-                                          &sanitized_host_zoom_dictionary);
-    for (const std::string& s : keys_to_remove)
-      sanitized_host_zoom_dictionary->RemoveWithoutPathExpansion(s, nullptr);
-  }
+  for (const std::string& s : keys_to_remove)
+    host_levels->RemoveKey(s);
+  if (!keys_to_remove.empty())
+    pref_store_->ScheduleWrite();
 }
 
 void ZoomLevelDelegate::InitHostZoomMap(content::HostZoomMap* host_zoom_map) {
@@ -149,17 +187,10 @@ void ZoomLevelDelegate::InitHostZoomMap(content::HostZoomMap* host_zoom_map) {
   host_zoom_map_->SetDefaultZoomLevel(GetDefaultZoomLevelPref());
 
   // Initialize the HostZoomMap with per-host zoom levels from the persisted
-  // zoom-level preference values.
-  const base::DictionaryValue* host_zoom_dictionaries =
-      pref_service_->GetDictionary(kPartitionPerHostZoomLevels);
-  const base::DictionaryValue* host_zoom_dictionary = nullptr;
-  if (host_zoom_dictionaries->GetDictionary(partition_key_,
-                                            &host_zoom_dictionary)) {
-    // Since we're calling this before setting up zoom_subscription_ below we
-    // don't need to worry that host_zoom_dictionary is indirectly affected
-    // by calls to HostZoomMap::SetZoomLevelForHost().
-    ExtractPerHostZoomLevels(host_zoom_dictionary);
-  }
+  // zoom-level preference values. Since we're calling this before setting up
+  // zoom_subscription_ below we don't need to worry that the levels are
+  // indirectly affected by calls to HostZoomMap::SetZoomLevelForHost().
+  ExtractPerHostZoomLevels();
   zoom_subscription_ =
       host_zoom_map_->AddZoomLevelChangedCallback(base::BindRepeating(
           &ZoomLevelDelegate::OnZoomLevelChanged, base::Unretained(this)));
@@ -15,24 +15,31 @@
 #include "content/public/browser/zoom_level_delegate.h"
 
 namespace base {
-class DictionaryValue;
+class Value;
 }
 
 class PrefRegistrySimple;
 
 namespace electron {
 
+class PartitionPrefStore;
+
 // A class to manage per-partition default and per-host zoom levels.
 // It implements an interface between the content/ zoom
 // levels in HostZoomMap and preference system. All changes
 // to the per-partition default zoom levels flow through this
 // class. Any changes to per-host levels are updated when HostZoomMap calls
 // OnZoomLevelChanged.
+//
+// The levels are kept in the PartitionPrefStore of the partition. Levels
+// stored in the Preferences file by older versions are moved there the
+// first time the partition is used.
 class ZoomLevelDelegate : public content::ZoomLevelDelegate {
  public:
   static void RegisterPrefs(PrefRegistrySimple* pref_registry);
 
   ZoomLevelDelegate(PrefService* pref_service,
+                    PartitionPrefStore* pref_store,
                     const base::FilePath& partition_path);
   ~ZoomLevelDelegate() override;
 
@@ -43,8 +50,13 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   void InitHostZoomMap(content::HostZoomMap* host_zoom_map) override;
 
  private:
-  void ExtractPerHostZoomLevels(
-      const base::DictionaryValue* host_zoom_dictionary);
+  // Moves the levels of this partition out of the Preferences file.
+  void MigrateFromPrefService();
+
+  // Returns the dictionary that maps hosts to zoom levels.
+  base::Value* GetPerHostZoomLevels();
+
+  void ExtractPerHostZoomLevels();
 
   // This is a callback function that receives notifications from HostZoomMap
   // when per-host zoom levels change. It is used to update the per-host
@@ -52,6 +64,7 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   void OnZoomLevelChanged(const content::HostZoomMap::ZoomLevelChange& change);
 
   PrefService* pref_service_;
+  PartitionPrefStore* pref_store_;
   content::HostZoomMap* host_zoom_map_;
   std::unique_ptr<content::HostZoomMap::Subscription> zoom_subscription_;
   std::string partition_key_;
@@ -4,20 +4,167 @@
 
 #include "shell/common/api/atom_api_clipboard.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "shell/common/native_mate_converters/image_converter.h"
 #include "shell/common/native_mate_converters/string16_converter.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/promise_util.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
+#include "ui/base/clipboard/clipboard_constants.h"
 #include "ui/base/clipboard/clipboard_format_type.h"
 #include "ui/base/clipboard/scoped_clipboard_writer.h"
+#include "ui/gfx/codec/png_codec.h"
 
 namespace electron {
 
 namespace api {
 
+namespace {
+
+constexpr base::TaskTraits kClipboardTaskTraits = {
+    base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+// The format other applications use to share PNG encoded images.
+ui::ClipboardFormatType GetPNGFormatType() {
+#if defined(OS_MACOSX)
+  return ui::ClipboardFormatType::GetType("public.png");
+#elif defined(OS_WIN)
+  return ui::ClipboardFormatType::GetType("PNG");
+#else
+  return ui::ClipboardFormatType::GetType(ui::kMimeTypePNG);
+#endif
+}
+
+// Hands |data| to a Buffer instead of copying it.
+v8::Local<v8::Value> BufferFromString(v8::Isolate* isolate,
+                                      std::string data) {
+  if (data.empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  auto* owned = new std::string(std::move(data));
+  return node::Buffer::New(isolate, &owned->front(), owned->size(),
+                           [](char*, void* hint) {
+                             delete static_cast<std::string*>(hint);
+                           },
+                           owned)
+      .ToLocalChecked();
+}
+
+std::string ReadData(const std::string& format_string) {
+  std::string data;
+  ui::Clipboard::GetForCurrentThread()->ReadData(
+      ui::ClipboardFormatType::GetType(format_string), &data);
+  return data;
+}
+
+base::string16 ReadHTMLFromBuffer(ui::ClipboardBuffer buffer) {
+  base::string16 html;
+  std::string url;
+  uint32_t start;
+  uint32_t end;
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  clipboard->ReadHTML(buffer, &html, &url, &start, &end);
+  return html.substr(start, end - start);
+}
+
+// Runs |task| in a later task on the current thread.
+void PostClipboardTask(base::OnceClosure task) {
+  base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE, std::move(task));
+}
+
+SkBitmap DecodePNGOnWorker(const std::string& data) {
+  SkBitmap bitmap;
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  if (!gfx::PNGCodec::Decode(bytes, data.size(), &bitmap))
+    return SkBitmap();
+  return bitmap;
+}
+
+void ResolveWithBitmap(util::Promise<gfx::Image> promise,
+                       ui::ClipboardBuffer buffer,
+                       SkBitmap bitmap) {
+  // Let the platform convert the image when the PNG data can't be decoded.
+  if (bitmap.isNull())
+    bitmap = ui::Clipboard::GetForCurrentThread()->ReadImage(buffer);
+  promise.Resolve(gfx::Image::CreateFrom1xBitmap(bitmap));
+}
+
+void ReadImageOnUI(util::Promise<gfx::Image> promise,
+                   ui::ClipboardBuffer buffer) {
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  ui::ClipboardFormatType png = GetPNGFormatType();
+  // Only copy the encoded image here, ReadImage would decode it on this
+  // thread.
+  if (buffer == ui::ClipboardBuffer::kCopyPaste &&
+      clipboard->IsFormatAvailable(png, buffer)) {
+    std::string data;
+    clipboard->ReadData(png, &data);
+    if (!data.empty()) {
+      base::PostTaskWithTraitsAndReplyWithResult(
+          FROM_HERE, kClipboardTaskTraits,
+          base::BindOnce(&DecodePNGOnWorker, std::move(data)),
+          base::BindOnce(&ResolveWithBitmap, std::move(promise), buffer));
+      return;
+    }
+  }
+  promise.Resolve(gfx::Image::CreateFrom1xBitmap(clipboard->ReadImage(buffer)));
+}
+
+// Copies the pixels of |bitmap| so that the clipboard owns them, which is
+// what Clipboard::WriteImage does on the calling thread.
+SkBitmap CopyBitmap(const SkBitmap& orig) {
+  SkBitmap bmp;
+  if (bmp.tryAllocPixels(orig.info()) &&
+      orig.readPixels(bmp.info(), bmp.getPixels(), bmp.rowBytes(), 0, 0)) {
+    return bmp;
+  }
+  return SkBitmap();
+}
+
+#if defined(USE_X11)
+// X11 keeps images on the clipboard as PNG, encode them off the UI thread.
+std::string EncodeImageOnWorker(const SkBitmap& bitmap) {
+  std::vector<unsigned char> encoded;
+  if (!gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded))
+    return std::string();
+  return std::string(encoded.begin(), encoded.end());
+}
+
+void WriteImageOnUI(util::Promise<void*> promise,
+                    ui::ClipboardBuffer buffer,
+                    std::string png) {
+  if (!png.empty()) {
+    ui::ScopedClipboardWriter writer(buffer);
+    writer.WriteData(GetPNGFormatType().Serialize(), png);
+  }
+  promise.Resolve();
+}
+#else
+SkBitmap EncodeImageOnWorker(const SkBitmap& bitmap) {
+  return CopyBitmap(bitmap);
+}
+
+void WriteImageOnUI(util::Promise<void*> promise,
+                    ui::ClipboardBuffer buffer,
+                    SkBitmap bitmap) {
+  if (!bitmap.isNull()) {
+    ui::ScopedClipboardWriter writer(buffer);
+    writer.WriteImage(bitmap);
+  }
+  promise.Resolve();
+}
+#endif
+
+}  // namespace
+
 ui::ClipboardBuffer Clipboard::GetClipboardBuffer(mate::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -43,20 +190,30 @@ bool Clipboard::Has(const std::string& format_string, mate::Arguments* args) {
 }
 
 std::string Clipboard::Read(const std::string& format_string) {
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  ui::ClipboardFormatType format(
-      ui::ClipboardFormatType::GetType(format_string));
-
-  std::string data;
-  clipboard->ReadData(format, &data);
-  return data;
+  return ReadData(format_string);
 }
 
 v8::Local<v8::Value> Clipboard::ReadBuffer(const std::string& format_string,
                                            mate::Arguments* args) {
-  std::string data = Read(format_string);
-  return node::Buffer::Copy(args->isolate(), data.data(), data.length())
-      .ToLocalChecked();
+  return BufferFromString(args->isolate(), ReadData(format_string));
+}
+
+v8::Local<v8::Promise> Clipboard::ReadBufferAsync(
+    const std::string& format_string,
+    mate::Arguments* args) {
+  util::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  PostClipboardTask(base::BindOnce(
+      [](util::Promise<v8::Local<v8::Value>> promise,
+         const std::string& format_string) {
+        std::string data = ReadData(format_string);
+        v8::Isolate* isolate = promise.isolate();
+        v8::HandleScope handle_scope(isolate);
+        v8::Context::Scope context_scope(promise.GetContext());
+        promise.Resolve(BufferFromString(isolate, std::move(data)));
+      },
+      std::move(promise), format_string));
+  return handle;
 }
 
 void Clipboard::WriteBuffer(const std::string& format,
@@ -73,6 +230,33 @@ void Clipboard::WriteBuffer(const std::string& format,
       std::string(node::Buffer::Data(buffer), node::Buffer::Length(buffer)));
 }
 
+v8::Local<v8::Promise> Clipboard::WriteBufferAsync(
+    const std::string& format,
+    const v8::Local<v8::Value> buffer,
+    mate::Arguments* args) {
+  util::Promise<void*> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!node::Buffer::HasInstance(buffer)) {
+    promise.RejectWithErrorMessage("buffer must be a node Buffer");
+    return handle;
+  }
+
+  // The buffer is copied since JavaScript may modify it before it is written.
+  std::string data(node::Buffer::Data(buffer), node::Buffer::Length(buffer));
+  PostClipboardTask(base::BindOnce(
+      [](util::Promise<void*> promise, ui::ClipboardBuffer type,
+         const std::string& format, const std::string& data) {
+        {
+          ui::ScopedClipboardWriter writer(type);
+          writer.WriteData(
+              ui::ClipboardFormatType::GetType(format).Serialize(), data);
+        }
+        promise.Resolve();
+      },
+      std::move(promise), GetClipboardBuffer(args), format, std::move(data)));
+  return handle;
+}
+
 void Clipboard::Write(const mate::Dictionary& data, mate::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardBuffer(args));
   base::string16 text, html, bookmark;
@@ -131,15 +315,18 @@ void Clipboard::WriteRTF(const std::string& text, mate::Arguments* args) {
 }
 
 base::string16 Clipboard::ReadHTML(mate::Arguments* args) {
-  base::string16 data;
-  base::string16 html;
-  std::string url;
-  uint32_t start;
-  uint32_t end;
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  clipboard->ReadHTML(GetClipboardBuffer(args), &html, &url, &start, &end);
-  data = html.substr(start, end - start);
-  return data;
+  return ReadHTMLFromBuffer(GetClipboardBuffer(args));
+}
+
+v8::Local<v8::Promise> Clipboard::ReadHTMLAsync(mate::Arguments* args) {
+  util::Promise<base::string16> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  PostClipboardTask(base::BindOnce(
+      [](util::Promise<base::string16> promise, ui::ClipboardBuffer buffer) {
+        promise.Resolve(ReadHTMLFromBuffer(buffer));
+      },
+      std::move(promise), GetClipboardBuffer(args)));
+  return handle;
 }
 
 void Clipboard::WriteHTML(const base::string16& html, mate::Arguments* args) {
@@ -171,15 +358,31 @@ gfx::Image Clipboard::ReadImage(mate::Arguments* args) {
   return gfx::Image::CreateFrom1xBitmap(bitmap);
 }
 
+v8::Local<v8::Promise> Clipboard::ReadImageAsync(mate::Arguments* args) {
+  util::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  PostClipboardTask(base::BindOnce(&ReadImageOnUI, std::move(promise),
+                                   GetClipboardBuffer(args)));
+  return handle;
+}
+
 void Clipboard::WriteImage(const gfx::Image& image, mate::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardBuffer(args));
-  SkBitmap orig = image.AsBitmap();
-  SkBitmap bmp;
-
-  if (bmp.tryAllocPixels(orig.info()) &&
-      orig.readPixels(bmp.info(), bmp.getPixels(), bmp.rowBytes(), 0, 0)) {
+  SkBitmap bmp = CopyBitmap(image.AsBitmap());
+  if (!bmp.isNull())
     writer.WriteImage(bmp);
-  }
+}
+
+v8::Local<v8::Promise> Clipboard::WriteImageAsync(const gfx::Image& image,
+                                                  mate::Arguments* args) {
+  util::Promise<void*> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kClipboardTaskTraits,
+      base::BindOnce(&EncodeImageOnWorker, image.AsBitmap()),
+      base::BindOnce(&WriteImageOnUI, std::move(promise),
+                     GetClipboardBuffer(args)));
+  return handle;
 }
 
 #if !defined(OS_MACOSX)
@@ -223,6 +426,14 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("writeFindText", &electron::api::Clipboard::WriteFindText);
   dict.SetMethod("readBuffer", &electron::api::Clipboard::ReadBuffer);
   dict.SetMethod("writeBuffer", &electron::api::Clipboard::WriteBuffer);
+  dict.SetMethod("readHTMLAsync", &electron::api::Clipboard::ReadHTMLAsync);
+  dict.SetMethod("readImageAsync", &electron::api::Clipboard::ReadImageAsync);
+  dict.SetMethod("writeImageAsync",
+                 &electron::api::Clipboard::WriteImageAsync);
+  dict.SetMethod("readBufferAsync",
+                 &electron::api::Clipboard::ReadBufferAsync);
+  dict.SetMethod("writeBufferAsync",
+                 &electron::api::Clipboard::WriteBufferAsync);
   dict.SetMethod("clear", &electron::api::Clipboard::Clear);
 }
 
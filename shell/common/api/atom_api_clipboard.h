@@ -53,6 +53,22 @@ class Clipboard {
                           const v8::Local<v8::Value> buffer,
                           mate::Arguments* args);
 
+  // Variants of the above which return before the clipboard is accessed.
+  // ui::Clipboard only works on the UI thread, so the transfer happens in a
+  // later task there, while decoding and encoding images and copying pixels
+  // run on the thread pool.
+  static v8::Local<v8::Promise> ReadHTMLAsync(mate::Arguments* args);
+  static v8::Local<v8::Promise> ReadImageAsync(mate::Arguments* args);
+  static v8::Local<v8::Promise> WriteImageAsync(const gfx::Image& image,
+                                                mate::Arguments* args);
+  static v8::Local<v8::Promise> ReadBufferAsync(
+      const std::string& format_string,
+      mate::Arguments* args);
+  static v8::Local<v8::Promise> WriteBufferAsync(
+      const std::string& format_string,
+      const v8::Local<v8::Value> buffer,
+      mate::Arguments* args);
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Clipboard);
 };
@@ -8,32 +8,35 @@
 #include "native_mate/handle.h"
 #include "native_mate/object_template_builder.h"
 #include "native_mate/wrappable.h"
+#include "shell/common/id_weak_map.h"
 #include "shell/common/key_weak_map.h"
 
 namespace electron {
 
 namespace api {
 
-template <typename K>
-class KeyWeakMap : public mate::Wrappable<KeyWeakMap<K>> {
+// |Map| is the native map storing the objects, integer IDs can use the
+// faster electron::IDWeakMap.
+template <typename K, typename Map = electron::KeyWeakMap<K>>
+class KeyWeakMap : public mate::Wrappable<KeyWeakMap<K, Map>> {
  public:
-  static mate::Handle<KeyWeakMap<K>> Create(v8::Isolate* isolate) {
-    return mate::CreateHandle(isolate, new KeyWeakMap<K>(isolate));
+  static mate::Handle<KeyWeakMap<K, Map>> Create(v8::Isolate* isolate) {
+    return mate::CreateHandle(isolate, new KeyWeakMap<K, Map>(isolate));
   }
 
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype) {
     prototype->SetClassName(mate::StringToV8(isolate, "KeyWeakMap"));
     mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
-        .SetMethod("set", &KeyWeakMap<K>::Set)
-        .SetMethod("get", &KeyWeakMap<K>::Get)
-        .SetMethod("has", &KeyWeakMap<K>::Has)
-        .SetMethod("remove", &KeyWeakMap<K>::Remove);
+        .SetMethod("set", &KeyWeakMap<K, Map>::Set)
+        .SetMethod("get", &KeyWeakMap<K, Map>::Get)
+        .SetMethod("has", &KeyWeakMap<K, Map>::Has)
+        .SetMethod("remove", &KeyWeakMap<K, Map>::Remove);
   }
 
  protected:
   explicit KeyWeakMap(v8::Isolate* isolate) {
-    mate::Wrappable<KeyWeakMap<K>>::Init(isolate);
+    mate::Wrappable<KeyWeakMap<K, Map>>::Init(isolate);
   }
   ~KeyWeakMap() override {}
 
@@ -51,7 +54,7 @@ class KeyWeakMap : public mate::Wrappable<KeyWeakMap<K>> {
 
   void Remove(const K& key) { key_weak_map_.Remove(key); }
 
-  electron::KeyWeakMap<K> key_weak_map_;
+  Map key_weak_map_;
 
   DISALLOW_COPY_AND_ASSIGN(KeyWeakMap);
 };
@@ -4,24 +4,34 @@
 
 #include "shell/common/api/atom_api_native_image.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/command_line.h"
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
 #include "native_mate/object_template_builder.h"
 #include "net/base/data_url.h"
 #include "shell/common/asar/asar_util.h"
+#include "shell/common/image_ops.h"
+#include "shell/common/native_image_cache.h"
 #include "shell/common/native_mate_converters/file_path_converter.h"
 #include "shell/common/native_mate_converters/gfx_converter.h"
 #include "shell/common/native_mate_converters/gurl_converter.h"
+#include "shell/common/native_mate_converters/image_converter.h"
 #include "shell/common/native_mate_converters/value_converter.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/options_switches.h"
+#include "shell/common/promise_util.h"
 #include "shell/common/skia_util.h"
+#include "skia/ext/image_operations.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
@@ -30,9 +40,11 @@
 #include "ui/gfx/codec/jpeg_codec.h"
 #include "ui/gfx/codec/png_codec.h"
 #include "ui/gfx/geometry/size.h"
+#include "ui/gfx/geometry/size_conversions.h"
 #include "ui/gfx/image/image_skia.h"
 #include "ui/gfx/image/image_skia_operations.h"
 #include "ui/gfx/image/image_util.h"
+#include "ui/gfx/skia_util.h"
 
 #if defined(OS_WIN)
 #include "base/win/scoped_gdi_object.h"
@@ -96,17 +108,292 @@ base::win::ScopedHICON ReadICOFromPath(int size, const base::FilePath& path) {
 }
 #endif
 
-void Noop(char*, void*) {}
+void UnrefPixels(char*, void* pixel_ref) {
+  static_cast<SkPixelRef*>(pixel_ref)->unref();
+}
+
+// Keeps the JavaScript buffer whose memory a wrapped bitmap uses alive until
+// Skia releases the pixels. That can happen on any thread holding the bitmap,
+// while the buffer handle has to be released on the thread that owns it.
+class WrappedPixels {
+ public:
+  WrappedPixels(v8::Isolate* isolate, v8::Local<v8::Value> buffer)
+      : buffer_(isolate, buffer),
+        task_runner_(base::SequencedTaskRunnerHandle::Get()) {}
+
+  static void Release(void* pixels, void* context) {
+    auto* self = static_cast<WrappedPixels*>(context);
+    if (self->task_runner_->RunsTasksInCurrentSequence())
+      delete self;
+    else
+      self->task_runner_->DeleteSoon(FROM_HERE, self);
+  }
+
+ private:
+  v8::Global<v8::Value> buffer_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(WrappedPixels);
+};
+
+// Compute the target size and the resize method from the options of resize().
+skia::ImageOperations::ResizeMethod GetResizeParameters(
+    const base::DictionaryValue& options,
+    float aspect_ratio,
+    gfx::Size* size) {
+  int width = size->width();
+  int height = size->height();
+  bool width_set = options.GetInteger("width", &width);
+  bool height_set = options.GetInteger("height", &height);
+  size->SetSize(width, height);
+
+  if (width_set && !height_set) {
+    // Scale height to preserve original aspect ratio
+    size->set_height(width);
+    *size = gfx::ScaleToRoundedSize(*size, 1.f, 1.f / aspect_ratio);
+  } else if (height_set && !width_set) {
+    // Scale width to preserve original aspect ratio
+    size->set_width(height);
+    *size = gfx::ScaleToRoundedSize(*size, aspect_ratio, 1.f);
+  }
+
+  std::string quality;
+  options.GetString("quality", &quality);
+  if (quality == "good")
+    return skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+  else if (quality == "better")
+    return skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  return skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+}
+
+// The async variants hand plain bitmaps to the thread pool, because
+// gfx::ImageSkia is bound to the sequence it is used on. SkBitmap pixels are
+// reference counted thread-safely, and the bitmaps produced by the workers
+// are marked immutable before being shared with the calling thread.
+using ImageReps = std::vector<gfx::ImageSkiaRep>;
+
+constexpr base::TaskTraits kImageTaskTraits = {
+    base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+ImageReps GetImageReps(const gfx::Image& image) {
+  gfx::ImageSkia image_skia = image.AsImageSkia();
+  image_skia.EnsureRepsForSupportedScales();
+  return image_skia.image_reps();
+}
+
+ImageReps MakeImmutable(const gfx::ImageSkia& image_skia) {
+  ImageReps reps;
+  for (const auto& rep : image_skia.image_reps()) {
+    SkBitmap bitmap = rep.GetBitmap();
+    bitmap.setImmutable();
+    reps.emplace_back(bitmap, rep.scale());
+  }
+  return reps;
+}
+
+gfx::Image ImageFromReps(const ImageReps& reps) {
+  gfx::ImageSkia image_skia;
+  for (const auto& rep : reps)
+    image_skia.AddRepresentation(rep);
+  return gfx::Image(image_skia);
+}
+
+scoped_refptr<NativeImageCache::Entry> DecodeFromPathOnWorker(
+    const base::FilePath& path) {
+  return NativeImageCache::GetInstance()->Load(NormalizePath(path));
+}
+
+ImageReps DecodeFromBufferOnWorker(const std::string& data,
+                                   int width,
+                                   int height,
+                                   double scale_factor) {
+  gfx::ImageSkia image_skia;
+  electron::util::AddImageSkiaRepFromBuffer(
+      &image_skia, reinterpret_cast<const unsigned char*>(data.data()),
+      data.size(), width, height, scale_factor);
+  return MakeImmutable(image_skia);
+}
+
+std::vector<unsigned char> EncodePNGOnWorker(const SkBitmap& bitmap) {
+  std::vector<unsigned char> encoded;
+  gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &encoded);
+  return encoded;
+}
+
+std::vector<unsigned char> EncodeJPEGOnWorker(const SkBitmap& bitmap,
+                                              int quality) {
+  std::vector<unsigned char> encoded;
+  if (!bitmap.isNull())
+    gfx::JPEGCodec::Encode(bitmap, quality, &encoded);
+  return encoded;
+}
+
+ImageReps ResizeOnWorker(const ImageReps& reps,
+                         const gfx::Size& size,
+                         skia::ImageOperations::ResizeMethod method) {
+  ImageReps resized;
+  if (size.IsEmpty())
+    return resized;
+  for (const auto& rep : reps) {
+    // Same as the image source used by ImageSkiaOperations::CreateResizedImage.
+    gfx::Size pixel_size = gfx::ScaleToFlooredSize(size, rep.scale());
+    SkBitmap bitmap = skia::ImageOperations::Resize(
+        rep.GetBitmap(), method, pixel_size.width(), pixel_size.height());
+    bitmap.setImmutable();
+    resized.emplace_back(bitmap, rep.scale());
+  }
+  return resized;
+}
+
+ImageReps CropOnWorker(const ImageReps& reps, const gfx::Rect& rect) {
+  ImageReps cropped;
+  for (const auto& rep : reps) {
+    // Same as the image source used by ImageSkiaOperations::ExtractSubset, but
+    // the pixels are copied so the result does not keep the source alive.
+    const SkBitmap& source = rep.GetBitmap();
+    SkIRect subset = gfx::RectToSkIRect(gfx::ScaleToEnclosingRect(
+        gfx::IntersectRects(rect, gfx::Rect(rep.GetWidth(), rep.GetHeight())),
+        rep.scale()));
+    SkBitmap extracted, bitmap;
+    if (!source.extractSubset(&extracted, subset) ||
+        !bitmap.tryAllocPixels(extracted.info()) ||
+        !extracted.readPixels(bitmap.pixmap()))
+      continue;
+    bitmap.setImmutable();
+    cropped.emplace_back(bitmap, rep.scale());
+  }
+  return cropped;
+}
+
+void ResolveWithImage(util::Promise<gfx::Image> promise, ImageReps reps) {
+  promise.Resolve(ImageFromReps(reps));
+}
+
+// Hands |data| to a Buffer instead of copying it.
+v8::Local<v8::Value> BufferFromVector(v8::Isolate* isolate,
+                                      std::vector<unsigned char> data) {
+  if (data.empty())
+    return node::Buffer::New(isolate, 0).ToLocalChecked();
+  auto* owned = new std::vector<unsigned char>(std::move(data));
+  return node::Buffer::New(
+             isolate, reinterpret_cast<char*>(owned->data()), owned->size(),
+             [](char*, void* hint) {
+               delete static_cast<std::vector<unsigned char>*>(hint);
+             },
+             owned)
+      .ToLocalChecked();
+}
+
+void ResolveWithBuffer(util::Promise<v8::Local<v8::Value>> promise,
+                       std::vector<unsigned char> data) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(promise.GetContext());
+  promise.Resolve(BufferFromVector(isolate, std::move(data)));
+}
+
+bool GetPixelFormat(const std::string& name, image_ops::PixelFormat* format) {
+  if (name == "bgra") {
+    *format = image_ops::PixelFormat::kBGRA;
+    return true;
+  } else if (name == "rgba") {
+    *format = image_ops::PixelFormat::kRGBA;
+    return true;
+  }
+  return false;
+}
+
+// Converts the operations passed to transform(). Sizes that are not given
+// keep the aspect ratio of the image at that step, like resize().
+bool GetOperations(const std::vector<mate::Dictionary>& list,
+                   gfx::Size size,
+                   std::vector<image_ops::Operation>* operations,
+                   std::string* error) {
+  for (const auto& dict : list) {
+    image_ops::Operation operation;
+    std::string type;
+    dict.Get("type", &type);
+    if (type == "resize") {
+      operation.type = image_ops::Operation::Type::kResize;
+      int width = 0, height = 0;
+      bool width_set = dict.Get("width", &width);
+      bool height_set = dict.Get("height", &height);
+      if (!width_set && !height_set) {
+        *error = "resize requires a width or a height";
+        return false;
+      }
+      if (!height_set) {
+        height = size.width() > 0 ? width * size.height() / size.width() : 0;
+      } else if (!width_set) {
+        width = size.height() > 0 ? height * size.width() / size.height() : 0;
+      }
+      size.SetSize(width, height);
+      operation.size = size;
+
+      std::string filter = "box";
+      dict.Get("filter", &filter);
+      if (filter == "box") {
+        operation.filter = image_ops::ScaleFilter::kBox;
+      } else if (filter == "bilinear") {
+        operation.filter = image_ops::ScaleFilter::kBilinear;
+      } else if (filter == "lanczos") {
+        operation.filter = image_ops::ScaleFilter::kLanczos;
+      } else {
+        *error = "invalid resize filter: " + filter;
+        return false;
+      }
+    } else if (type == "blur") {
+      operation.type = image_ops::Operation::Type::kBlur;
+      if (!dict.Get("radius", &operation.radius)) {
+        *error = "blur requires a radius";
+        return false;
+      }
+    } else if (type == "grayscale") {
+      operation.type = image_ops::Operation::Type::kGrayscale;
+    } else if (type == "composite") {
+      operation.type = image_ops::Operation::Type::kComposite;
+      mate::Handle<NativeImage> overlay;
+      if (!dict.Get("image", &overlay) || overlay.IsEmpty()) {
+        *error = "composite requires an image";
+        return false;
+      }
+      operation.overlay = GetImageReps(overlay->image());
+      int x = 0, y = 0;
+      dict.Get("x", &x);
+      dict.Get("y", &y);
+      operation.origin.SetPoint(x, y);
+    } else {
+      *error = "invalid operation type: " + type;
+      return false;
+    }
+    operations->push_back(std::move(operation));
+  }
+  return true;
+}
+
+ImageReps TransformReps(const ImageReps& reps,
+                        const std::vector<image_ops::Operation>& operations) {
+  ImageReps transformed;
+  for (const auto& rep : reps) {
+    SkBitmap bitmap =
+        image_ops::ApplyOperations(rep.GetBitmap(), rep.scale(), operations);
+    if (bitmap.drawsNothing())
+      continue;
+    // Steps that did not write leave the source pixels, which stay mutable.
+    if (bitmap.getPixels() != rep.GetBitmap().getPixels())
+      bitmap.setImmutable();
+    transformed.emplace_back(bitmap, rep.scale());
+  }
+  return transformed;
+}
 
 }  // namespace
 
 NativeImage::NativeImage(v8::Isolate* isolate, const gfx::Image& image)
     : image_(image) {
   Init(isolate);
-  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate->AdjustAmountOfExternalAllocatedMemory(
-        image_.ToImageSkia()->bitmap()->computeByteSize());
-  }
+  UpdateMemoryUsage();
 }
 
 #if defined(OS_WIN)
@@ -117,18 +404,58 @@ NativeImage::NativeImage(v8::Isolate* isolate, const base::FilePath& hicon_path)
   electron::util::ReadImageSkiaFromICO(&image_skia, GetHICON(256));
   image_ = gfx::Image(image_skia);
   Init(isolate);
-  if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate->AdjustAmountOfExternalAllocatedMemory(
-        image_.ToImageSkia()->bitmap()->computeByteSize());
-  }
+  UpdateMemoryUsage();
 }
 #endif
 
 NativeImage::~NativeImage() {
+  isolate()->AdjustAmountOfExternalAllocatedMemory(-memory_usage_);
+}
+
+void NativeImage::UpdateMemoryUsage() {
+  int64_t usage = 0;
   if (image_.HasRepresentation(gfx::Image::kImageRepSkia)) {
-    isolate()->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(
-        image_.ToImageSkia()->bitmap()->computeByteSize()));
+    for (const auto& rep : image_.ToImageSkia()->image_reps())
+      usage += rep.GetBitmap().computeByteSize();
   }
+  usage = std::max<int64_t>(usage - shared_bytes_, 0);
+  isolate()->AdjustAmountOfExternalAllocatedMemory(usage - memory_usage_);
+  memory_usage_ = usage;
+}
+
+void NativeImage::DropDetachedBuffer() {
+  if (wrapped_buffer_.IsEmpty() ||
+      wrapped_buffer_.Get(isolate())->ByteLength() != 0)
+    return;
+  // The memory went away with the contents of the ArrayBuffer, e.g. when it
+  // was transferred with postMessage(), so the pixels must not be read.
+  wrapped_buffer_.Reset();
+  image_ = gfx::Image();
+  shared_bytes_ = 0;
+  UpdateMemoryUsage();
+}
+
+void NativeImage::DetachFromBuffer() {
+  DropDetachedBuffer();
+  if (wrapped_buffer_.IsEmpty())
+    return;
+  wrapped_buffer_.Reset();
+
+  bool template_image = IsTemplateImage();
+  ImageReps reps;
+  for (const auto& rep : GetImageReps(image_)) {
+    const SkBitmap& source = rep.GetBitmap();
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(source.info()) ||
+        !source.readPixels(bitmap.pixmap()))
+      continue;
+    reps.emplace_back(bitmap, rep.scale());
+  }
+  image_ = ImageFromReps(reps);
+  if (template_image)
+    SetTemplateImage(true);
+  shared_bytes_ = 0;
+  UpdateMemoryUsage();
 }
 
 #if defined(OS_WIN)
@@ -144,6 +471,7 @@ HICON NativeImage::GetHICON(int size) {
   }
 
   // Then convert the image to ICO.
+  DropDetachedBuffer();
   if (image_.IsEmpty())
     return NULL;
   hicons_[size] = IconUtil::CreateHICONFromSkBitmap(image_.AsBitmap());
@@ -152,6 +480,7 @@ HICON NativeImage::GetHICON(int size) {
 #endif
 
 v8::Local<v8::Value> NativeImage::ToPNG(mate::Arguments* args) {
+  DropDetachedBuffer();
   float scale_factor = GetScaleFactorFromOptions(args);
 
   if (scale_factor == 1.0f) {
@@ -174,10 +503,32 @@ v8::Local<v8::Value> NativeImage::ToPNG(mate::Arguments* args) {
 }
 
 v8::Local<v8::Value> NativeImage::ToBitmap(mate::Arguments* args) {
-  float scale_factor = GetScaleFactorFromOptions(args);
+  DropDetachedBuffer();
+  float scale_factor = 1.0f;
+  std::string format;
+  bool premultiplied = true;
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("scaleFactor", &scale_factor);
+    options.Get("format", &format);
+    options.Get("premultiplied", &premultiplied);
+  }
 
   const SkBitmap bitmap =
       image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  if (format == "i420")
+    return BufferFromVector(args->isolate(), image_ops::ExportI420(bitmap));
+  if (!format.empty() || !premultiplied) {
+    image_ops::PixelFormat pixel_format = image_ops::PixelFormat::kBGRA;
+    if (!format.empty() && !GetPixelFormat(format, &pixel_format)) {
+      args->ThrowError("invalid format: " + format);
+      return v8::Undefined(args->isolate());
+    }
+    return BufferFromVector(
+        args->isolate(),
+        image_ops::ExportPixels(bitmap, pixel_format, premultiplied));
+  }
+
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
@@ -188,6 +539,7 @@ v8::Local<v8::Value> NativeImage::ToBitmap(mate::Arguments* args) {
 }
 
 v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
+  DropDetachedBuffer();
   std::vector<unsigned char> output;
   gfx::JPEG1xEncodedDataFromImage(image_, quality, &output);
   if (output.empty())
@@ -199,6 +551,7 @@ v8::Local<v8::Value> NativeImage::ToJPEG(v8::Isolate* isolate, int quality) {
 }
 
 std::string NativeImage::ToDataURL(mate::Arguments* args) {
+  DropDetachedBuffer();
   float scale_factor = GetScaleFactorFromOptions(args);
 
   if (scale_factor == 1.0f) {
@@ -213,22 +566,37 @@ std::string NativeImage::ToDataURL(mate::Arguments* args) {
 }
 
 v8::Local<v8::Value> NativeImage::GetBitmap(mate::Arguments* args) {
+  DropDetachedBuffer();
   float scale_factor = GetScaleFactorFromOptions(args);
 
-  const SkBitmap bitmap =
-      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  // Hold the representation by reference so that the only references to the
+  // pixels are the ones of their actual owners.
+  const gfx::ImageSkia image_skia = image_.AsImageSkia();
+  const SkBitmap& bitmap =
+      image_skia.GetRepresentation(scale_factor).GetBitmap();
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
+  // Pixels owned by the image cache, shared with other images or wrapped
+  // from a buffer that can be detached must not be handed out, copy them.
+  if (bitmap.isImmutable() || !ref->unique() || !wrapped_buffer_.IsEmpty()) {
+    return node::Buffer::Copy(args->isolate(),
+                              reinterpret_cast<const char*>(ref->pixels()),
+                              bitmap.computeByteSize())
+        .ToLocalChecked();
+  }
+  // The buffer shares the pixels and keeps them alive until it is collected.
+  ref->ref();
   return node::Buffer::New(args->isolate(),
                            reinterpret_cast<char*>(ref->pixels()),
-                           bitmap.computeByteSize(), &Noop, nullptr)
+                           bitmap.computeByteSize(), &UnrefPixels, ref)
       .ToLocalChecked();
 }
 
 v8::Local<v8::Value> NativeImage::GetNativeHandle(v8::Isolate* isolate,
                                                   mate::Arguments* args) {
 #if defined(OS_MACOSX)
+  DropDetachedBuffer();
   if (IsEmpty())
     return node::Buffer::New(isolate, 0).ToLocalChecked();
 
@@ -243,10 +611,12 @@ v8::Local<v8::Value> NativeImage::GetNativeHandle(v8::Isolate* isolate,
 }
 
 bool NativeImage::IsEmpty() {
+  DropDetachedBuffer();
   return image_.IsEmpty();
 }
 
 gfx::Size NativeImage::GetSize() {
+  DropDetachedBuffer();
   return image_.Size();
 }
 
@@ -261,31 +631,10 @@ float NativeImage::GetAspectRatio() {
 mate::Handle<NativeImage> NativeImage::Resize(
     v8::Isolate* isolate,
     const base::DictionaryValue& options) {
+  DropDetachedBuffer();
   gfx::Size size = GetSize();
-  int width = size.width();
-  int height = size.height();
-  bool width_set = options.GetInteger("width", &width);
-  bool height_set = options.GetInteger("height", &height);
-  size.SetSize(width, height);
-
-  if (width_set && !height_set) {
-    // Scale height to preserve original aspect ratio
-    size.set_height(width);
-    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / GetAspectRatio());
-  } else if (height_set && !width_set) {
-    // Scale width to preserve original aspect ratio
-    size.set_width(height);
-    size = gfx::ScaleToRoundedSize(size, GetAspectRatio(), 1.f);
-  }
-
   skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string quality;
-  options.GetString("quality", &quality);
-  if (quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+      GetResizeParameters(options, GetAspectRatio(), &size);
 
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
       image_.AsImageSkia(), method, size);
@@ -295,12 +644,116 @@ mate::Handle<NativeImage> NativeImage::Resize(
 
 mate::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                             const gfx::Rect& rect) {
+  // The cropped image shares the pixels.
+  DetachFromBuffer();
   gfx::ImageSkia cropped =
       gfx::ImageSkiaOperations::ExtractSubset(image_.AsImageSkia(), rect);
   return mate::CreateHandle(isolate,
                             new NativeImage(isolate, gfx::Image(cropped)));
 }
 
+v8::Local<v8::Promise> NativeImage::ToPNGAsync(mate::Arguments* args) {
+  DetachFromBuffer();
+  util::Promise<v8::Local<v8::Value>> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  float scale_factor = GetScaleFactorFromOptions(args);
+
+  if (scale_factor == 1.0f) {
+    // Raw 1x PNG bytes need no encoding.
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    if (png->size() > 0) {
+      ResolveWithBuffer(std::move(promise),
+                        std::vector<unsigned char>(
+                            png->front(), png->front() + png->size()));
+      return handle;
+    }
+  }
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).GetBitmap();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits, base::BindOnce(&EncodePNGOnWorker, bitmap),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                                int quality) {
+  DetachFromBuffer();
+  util::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(1.0f).GetBitmap();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&EncodeJPEGOnWorker, bitmap, quality),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::ResizeAsync(
+    v8::Isolate* isolate,
+    const base::DictionaryValue& options) {
+  DetachFromBuffer();
+  util::Promise<gfx::Image> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  gfx::Size size = GetSize();
+  skia::ImageOperations::ResizeMethod method =
+      GetResizeParameters(options, GetAspectRatio(), &size);
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&ResizeOnWorker, GetImageReps(image_), size, method),
+      base::BindOnce(&ResolveWithImage, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> NativeImage::CropAsync(v8::Isolate* isolate,
+                                              const gfx::Rect& rect) {
+  DetachFromBuffer();
+  util::Promise<gfx::Image> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&CropOnWorker, GetImageReps(image_), rect),
+      base::BindOnce(&ResolveWithImage, std::move(promise)));
+  return handle;
+}
+
+mate::Handle<NativeImage> NativeImage::Transform(
+    mate::Arguments* args,
+    const std::vector<mate::Dictionary>& list) {
+  // Operations that leave the pixels as they are pass them through.
+  DetachFromBuffer();
+  std::vector<image_ops::Operation> operations;
+  std::string error;
+  if (!GetOperations(list, GetSize(), &operations, &error)) {
+    args->ThrowError(error);
+    return mate::Handle<NativeImage>();
+  }
+  return Create(args->isolate(),
+                ImageFromReps(TransformReps(GetImageReps(image_), operations)));
+}
+
+v8::Local<v8::Promise> NativeImage::TransformAsync(
+    v8::Isolate* isolate,
+    const std::vector<mate::Dictionary>& list) {
+  DetachFromBuffer();
+  util::Promise<gfx::Image> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  std::vector<image_ops::Operation> operations;
+  std::string error;
+  if (!GetOperations(list, GetSize(), &operations, &error)) {
+    promise.RejectWithErrorMessage(error);
+    return handle;
+  }
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&TransformReps, GetImageReps(image_),
+                     std::move(operations)),
+      base::BindOnce(&ResolveWithImage, std::move(promise)));
+  return handle;
+}
+
 void NativeImage::AddRepresentation(const mate::Dictionary& options) {
   int width = 0;
   int height = 0;
@@ -309,6 +762,7 @@ void NativeImage::AddRepresentation(const mate::Dictionary& options) {
   options.Get("height", &height);
   options.Get("scaleFactor", &scale_factor);
 
+  DropDetachedBuffer();
   bool skia_rep_added = false;
   gfx::ImageSkia image_skia = image_.AsImageSkia();
 
@@ -338,6 +792,9 @@ void NativeImage::AddRepresentation(const mate::Dictionary& options) {
     gfx::Image image(image_skia);
     image_ = std::move(image);
   }
+
+  if (skia_rep_added)
+    UpdateMemoryUsage();
 }
 
 #if !defined(OS_MACOSX)
@@ -387,10 +844,8 @@ mate::Handle<NativeImage> NativeImage::CreateFromPath(
     return mate::CreateHandle(isolate, new NativeImage(isolate, image_path));
   }
 #endif
-  gfx::ImageSkia image_skia;
-  electron::util::PopulateImageSkiaRepsFromPath(&image_skia, image_path);
-  gfx::Image image(image_skia);
-  mate::Handle<NativeImage> handle = Create(isolate, image);
+  mate::Handle<NativeImage> handle = CreateFromCachedImage(
+      isolate, NativeImageCache::GetInstance()->GetImage(image_path));
 #if defined(OS_MACOSX)
   if (IsTemplateFilename(image_path))
     handle->SetTemplateImage(true);
@@ -436,14 +891,56 @@ mate::Handle<NativeImage> NativeImage::CreateFromBitmap(
     return CreateEmpty(args->isolate());
   }
 
+  bool copy = true;
+  options.Get("copy", &copy);
+
+  std::string format;
+  image_ops::PixelFormat pixel_format = image_ops::PixelFormat::kBGRA;
+  if (options.Get("format", &format) &&
+      !GetPixelFormat(format, &pixel_format)) {
+    args->ThrowError("invalid format: " + format);
+    return mate::Handle<NativeImage>();
+  }
+  bool premultiplied = true;
+  options.Get("premultiplied", &premultiplied);
+  bool convert =
+      pixel_format != image_ops::PixelFormat::kBGRA || !premultiplied;
+
+  // Skia requires the pixels to be aligned to the size of a pixel.
+  char* data = node::Buffer::Data(buffer);
+  if (convert ||
+      reinterpret_cast<uintptr_t>(data) % info.bytesPerPixel() != 0)
+    copy = true;
+
   SkBitmap bitmap;
-  bitmap.allocN32Pixels(width, height, false);
-  bitmap.writePixels({info, node::Buffer::Data(buffer), bitmap.rowBytes()});
+  if (convert) {
+    bitmap = image_ops::ImportPixels(reinterpret_cast<const uint8_t*>(data),
+                                     width, height, pixel_format,
+                                     premultiplied);
+  } else if (copy) {
+    bitmap.allocN32Pixels(width, height, false);
+    bitmap.writePixels({info, data, bitmap.rowBytes()});
+  } else {
+    auto* wrapped = new WrappedPixels(args->isolate(), buffer);
+    if (!bitmap.installPixels(info, data, info.minRowBytes(),
+                              &WrappedPixels::Release, wrapped)) {
+      args->ThrowError("failed to wrap buffer");
+      return mate::Handle<NativeImage>();
+    }
+  }
 
   gfx::ImageSkia image_skia;
   image_skia.AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
 
-  return Create(args->isolate(), gfx::Image(image_skia));
+  mate::Handle<NativeImage> handle =
+      Create(args->isolate(), gfx::Image(image_skia));
+  if (!copy) {
+    handle->wrapped_buffer_.Reset(
+        args->isolate(), buffer.As<v8::ArrayBufferView>()->Buffer());
+    handle->shared_bytes_ = size_bytes;
+    handle->UpdateMemoryUsage();
+  }
+  return handle;
 }
 
 // static
@@ -487,6 +984,85 @@ mate::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
   return CreateEmpty(isolate);
 }
 
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromPathAsync(
+    v8::Isolate* isolate,
+    const base::FilePath& path) {
+  util::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+#if defined(OS_WIN)
+  // Icons are loaded lazily per size through the HICON path.
+  if (path.MatchesExtension(FILE_PATH_LITERAL(".ico"))) {
+    promise.Resolve(CreateFromPath(isolate, path).ToV8());
+    return handle;
+  }
+#endif
+#if defined(OS_MACOSX)
+  bool is_template = IsTemplateFilename(path);
+#else
+  bool is_template = false;
+#endif
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&DecodeFromPathOnWorker, path),
+      base::BindOnce(
+          [](util::Promise<v8::Local<v8::Value>> promise, bool is_template,
+             scoped_refptr<NativeImageCache::Entry> entry) {
+            v8::Isolate* isolate = promise.isolate();
+            v8::HandleScope handle_scope(isolate);
+            v8::Context::Scope context_scope(promise.GetContext());
+            mate::Handle<NativeImage> image = CreateFromCachedImage(
+                isolate, NativeImageCache::CreateImage(std::move(entry)));
+            if (is_template)
+              image->SetTemplateImage(true);
+            promise.Resolve(image.ToV8());
+          },
+          std::move(promise), is_template));
+  return handle;
+}
+
+// static
+v8::Local<v8::Promise> NativeImage::CreateFromBufferAsync(
+    mate::Arguments* args,
+    v8::Local<v8::Value> buffer) {
+  util::Promise<gfx::Image> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  if (!node::Buffer::HasInstance(buffer)) {
+    promise.RejectWithErrorMessage("buffer must be a node Buffer");
+    return handle;
+  }
+
+  int width = 0;
+  int height = 0;
+  double scale_factor = 1.;
+
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("scaleFactor", &scale_factor);
+  }
+
+  // The buffer is copied since JavaScript may modify it while decoding.
+  std::string data(node::Buffer::Data(buffer), node::Buffer::Length(buffer));
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kImageTaskTraits,
+      base::BindOnce(&DecodeFromBufferOnWorker, std::move(data), width, height,
+                     scale_factor),
+      base::BindOnce(&ResolveWithImage, std::move(promise)));
+  return handle;
+}
+
+// static
+mate::Handle<NativeImage> NativeImage::CreateFromCachedImage(
+    v8::Isolate* isolate,
+    const gfx::ImageSkia& image_skia) {
+  mate::Handle<NativeImage> handle = Create(isolate, gfx::Image(image_skia));
+  handle->shared_bytes_ = handle->memory_usage_;
+  handle->UpdateMemoryUsage();
+  return handle;
+}
+
 #if !defined(OS_MACOSX)
 mate::Handle<NativeImage> NativeImage::CreateFromNamedImage(
     mate::Arguments* args,
@@ -514,6 +1090,12 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
                    &NativeImage::SetTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
       .SetMethod("crop", &NativeImage::Crop)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
+      .SetMethod("cropAsync", &NativeImage::CropAsync)
+      .SetMethod("transform", &NativeImage::Transform)
+      .SetMethod("transformAsync", &NativeImage::TransformAsync)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
 }
@@ -556,8 +1138,29 @@ bool Converter<mate::Handle<electron::api::NativeImage>>::FromV8(
 
 namespace {
 
+using electron::NativeImageCache;
 using electron::api::NativeImage;
 
+v8::Local<v8::Value> GetCacheStats(v8::Isolate* isolate) {
+  NativeImageCache::Stats stats = NativeImageCache::GetInstance()->GetStats();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("hits", static_cast<double>(stats.hits));
+  dict.Set("misses", static_cast<double>(stats.misses));
+  dict.Set("evictions", static_cast<double>(stats.evictions));
+  dict.Set("entries", static_cast<double>(stats.entries));
+  dict.Set("size", static_cast<double>(stats.bytes));
+  dict.Set("budget", static_cast<double>(stats.budget));
+  return dict.GetHandle();
+}
+
+void SetCacheBudget(mate::Arguments* args, double bytes) {
+  if (bytes < 0) {
+    args->ThrowError("budget must not be negative");
+    return;
+  }
+  NativeImageCache::GetInstance()->SetBudget(static_cast<size_t>(bytes));
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -567,6 +1170,11 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.Set("NativeImage", NativeImage::GetConstructor(isolate)
                               ->GetFunction(context)
                               .ToLocalChecked());
+  // Masking the CPU features affects the whole process, so it is only
+  // reachable when the process was started for benchmarking.
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          electron::switches::kImageOpsSIMDToggle))
+    dict.SetMethod("_setSIMDEnabled", &electron::image_ops::SetSIMDEnabled);
   mate::Dictionary native_image = mate::Dictionary::CreateEmpty(isolate);
   dict.Set("nativeImage", native_image);
 
@@ -577,6 +1185,12 @@ void Initialize(v8::Local<v8::Object> exports,
   native_image.SetMethod("createFromDataURL", &NativeImage::CreateFromDataURL);
   native_image.SetMethod("createFromNamedImage",
                          &NativeImage::CreateFromNamedImage);
+  native_image.SetMethod("createFromPathAsync",
+                         &NativeImage::CreateFromPathAsync);
+  native_image.SetMethod("createFromBufferAsync",
+                         &NativeImage::CreateFromBufferAsync);
+  native_image.SetMethod("getCacheStats", &GetCacheStats);
+  native_image.SetMethod("setCacheBudget", &SetCacheBudget);
 }
 
 }  // namespace
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/values.h"
 #include "native_mate/dictionary.h"
@@ -64,6 +65,19 @@ class NativeImage : public mate::Wrappable<NativeImage> {
       mate::Arguments* args,
       const std::string& name);
 
+  // Variants of the above which read and decode on the thread pool.
+  static v8::Local<v8::Promise> CreateFromPathAsync(
+      v8::Isolate* isolate,
+      const base::FilePath& path);
+  static v8::Local<v8::Promise> CreateFromBufferAsync(
+      mate::Arguments* args,
+      v8::Local<v8::Value> buffer);
+
+  // Creates an image whose pixels are owned by the NativeImageCache.
+  static mate::Handle<NativeImage> CreateFromCachedImage(
+      v8::Isolate* isolate,
+      const gfx::ImageSkia& image_skia);
+
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
@@ -71,7 +85,12 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   HICON GetHICON(int size);
 #endif
 
-  const gfx::Image& image() const { return image_; }
+  // The image for use by other APIs, which may keep it or hand it to other
+  // threads. Pixels wrapped from a JavaScript buffer are copied first.
+  const gfx::Image& image() {
+    DetachFromBuffer();
+    return image_;
+  }
 
  protected:
   NativeImage(v8::Isolate* isolate, const gfx::Image& image);
@@ -90,6 +109,18 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   mate::Handle<NativeImage> Resize(v8::Isolate* isolate,
                                    const base::DictionaryValue& options);
   mate::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
+  v8::Local<v8::Promise> ToPNGAsync(mate::Arguments* args);
+  v8::Local<v8::Promise> ToJPEGAsync(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Promise> ResizeAsync(v8::Isolate* isolate,
+                                     const base::DictionaryValue& options);
+  v8::Local<v8::Promise> CropAsync(v8::Isolate* isolate,
+                                   const gfx::Rect& rect);
+  mate::Handle<NativeImage> Transform(
+      mate::Arguments* args,
+      const std::vector<mate::Dictionary>& operations);
+  v8::Local<v8::Promise> TransformAsync(
+      v8::Isolate* isolate,
+      const std::vector<mate::Dictionary>& operations);
   std::string ToDataURL(mate::Arguments* args);
   bool IsEmpty();
   gfx::Size GetSize();
@@ -101,6 +132,16 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   // Determine if the image is a template image.
   bool IsTemplateImage();
 
+  // Report the memory held by the image's bitmaps to V8.
+  void UpdateMemoryUsage();
+
+  // Replaces pixels wrapped from a JavaScript buffer with a copy, which
+  // JavaScript can no longer write to while another thread reads them.
+  void DetachFromBuffer();
+  // Empties the image when the ArrayBuffer of the wrapped pixels was
+  // detached, which has to be checked before the pixels are read.
+  void DropDetachedBuffer();
+
 #if defined(OS_WIN)
   base::FilePath hicon_path_;
   std::map<int, base::win::ScopedHICON> hicons_;
@@ -108,6 +149,15 @@ class NativeImage : public mate::Wrappable<NativeImage> {
 
   gfx::Image image_;
 
+  // Bytes reported through AdjustAmountOfExternalAllocatedMemory.
+  int64_t memory_usage_ = 0;
+  // Bytes of pixels the image does not own: pixels wrapped from a JavaScript
+  // buffer, which V8 already knows about, or shared with the image cache.
+  int64_t shared_bytes_ = 0;
+  // The ArrayBuffer whose memory the pixels are, when the image was created
+  // with createFromBitmap(buffer, {copy: false}).
+  v8::Global<v8::ArrayBuffer> wrapped_buffer_;
+
   DISALLOW_COPY_AND_ASSIGN(NativeImage);
 };
 
@@ -64,10 +64,12 @@ mate::Handle<NativeImage> NativeImage::CreateFromNamedImage(
 }
 
 void NativeImage::SetTemplateImage(bool setAsTemplate) {
+  DropDetachedBuffer();
   [image_.AsNSImage() setTemplate:setAsTemplate];
 }
 
 bool NativeImage::IsTemplateImage() {
+  DropDetachedBuffer();
   return [image_.AsNSImage() isTemplate];
 }
 
@@ -27,6 +27,7 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/native_mate_converters/file_path_converter.h"
+#include "shell/common/native_mate_converters/heap_snapshot_converter.h"
 #include "shell/common/native_mate_converters/string16_converter.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/promise_util.h"
@@ -347,13 +348,20 @@ v8::Local<v8::Value> ElectronBindings::GetIOCounters(v8::Isolate* isolate) {
 
 // static
 bool ElectronBindings::TakeHeapSnapshot(v8::Isolate* isolate,
-                                        const base::FilePath& file_path) {
+                                        const base::FilePath& file_path,
+                                        mate::Arguments* args) {
+  HeapSnapshotOptions options;
+  if (args->Length() > 1 && !args->GetNext(&options)) {
+    args->ThrowError("Invalid heap snapshot options");
+    return false;
+  }
+
   base::ThreadRestrictions::ScopedAllowIO allow_io;
 
   base::File file(file_path,
                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
 
-  return electron::TakeHeapSnapshot(isolate, &file);
+  return electron::TakeHeapSnapshot(isolate, &file, options, nullptr);
 }
 
 }  // namespace electron
@@ -63,7 +63,8 @@ class ElectronBindings {
                                           v8::Isolate* isolate);
   static v8::Local<v8::Value> GetIOCounters(v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
-                               const base::FilePath& file_path);
+                               const base::FilePath& file_path,
+                               mate::Arguments* args);
 
   void ActivateUVLoop(v8::Isolate* isolate);
 
@@ -2,9 +2,13 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <string>
+#include <vector>
+
 #include "electron/buildflags/buildflags.h"
 #include "native_mate/dictionary.h"
 #include "printing/buildflags/buildflags.h"
+#include "shell/common/node_code_cache.h"
 #include "shell/common/node_includes.h"
 
 namespace {
@@ -49,6 +53,14 @@ bool IsPictureInPictureEnabled() {
   return BUILDFLAG(ENABLE_PICTURE_IN_PICTURE);
 }
 
+bool IsCodeCacheEnabled() {
+  return electron::HasEmbedderCodeCache();
+}
+
+std::vector<std::string> GetRejectedCodeCache() {
+  return electron::GetRejectedEmbedderCodeCache();
+}
+
 bool IsComponentBuild() {
 #if defined(COMPONENT_BUILD)
   return true;
@@ -73,6 +85,8 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("isPrintingEnabled", &IsPrintingEnabled);
   dict.SetMethod("isPictureInPictureEnabled", &IsPictureInPictureEnabled);
   dict.SetMethod("isComponentBuild", &IsComponentBuild);
+  dict.SetMethod("isCodeCacheEnabled", &IsCodeCacheEnabled);
+  dict.SetMethod("getRejectedCodeCache", &GetRejectedCodeCache);
   dict.SetMethod("isExtensionsEnabled", &IsExtensionsEnabled);
 }
 
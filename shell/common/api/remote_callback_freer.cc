@@ -4,9 +4,15 @@
 
 #include "shell/common/api/remote_callback_freer.h"
 
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
-#include "base/values.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
 #include "content/public/browser/web_contents.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
@@ -35,21 +41,51 @@ RemoteCallbackFreer::RemoteCallbackFreer(v8::Isolate* isolate,
 RemoteCallbackFreer::~RemoteCallbackFreer() = default;
 
 void RemoteCallbackFreer::RunDestructor() {
-  auto* channel = "ELECTRON_RENDERER_RELEASE_CALLBACK";
-  base::ListValue args;
-  int32_t sender_id = 0;
-  args.AppendString(context_id_);
-  args.AppendInteger(object_id_);
   auto* frame_host = web_contents()->GetMainFrame();
   if (frame_host) {
+    // The callbacks collected by a garbage collection are released together.
+    PendingReleases* pending = pending_releases();
+    if (pending->empty()) {
+      base::ThreadTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(&RemoteCallbackFreer::FlushReleases));
+    }
+    (*pending)[std::make_tuple(frame_host->GetProcess()->GetID(),
+                               frame_host->GetRoutingID(), context_id_)]
+        .AppendInteger(object_id_);
+  }
+
+  Observe(nullptr);
+}
+
+// static
+RemoteCallbackFreer::PendingReleases* RemoteCallbackFreer::pending_releases() {
+  static base::NoDestructor<PendingReleases> pending;
+  return pending.get();
+}
+
+// static
+void RemoteCallbackFreer::FlushReleases() {
+  PendingReleases pending;
+  pending.swap(*pending_releases());
+
+  auto* channel = "ELECTRON_RENDERER_RELEASE_CALLBACK";
+  int32_t sender_id = 0;
+  for (auto& frame_ids : pending) {
+    auto* frame_host = content::RenderFrameHost::FromID(
+        std::get<0>(frame_ids.first), std::get<1>(frame_ids.first));
+    if (!frame_host)
+      continue;
+
+    base::ListValue args;
+    args.AppendString(std::get<2>(frame_ids.first));
+    args.Append(std::make_unique<base::ListValue>(std::move(frame_ids.second)));
+
     mojom::ElectronRendererAssociatedPtr electron_ptr;
     frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
         mojo::MakeRequest(&electron_ptr));
     electron_ptr->Message(true /* internal */, false /* send_to_all */, channel,
-                          args.Clone(), sender_id);
+                          std::move(args), sender_id, base::TimeTicks::Now());
   }
-
-  Observe(nullptr);
 }
 
 void RemoteCallbackFreer::RenderViewDeleted(content::RenderViewHost*) {
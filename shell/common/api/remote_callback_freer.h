@@ -5,8 +5,11 @@
 #ifndef SHELL_COMMON_API_REMOTE_CALLBACK_FREER_H_
 #define SHELL_COMMON_API_REMOTE_CALLBACK_FREER_H_
 
+#include <map>
 #include <string>
+#include <tuple>
 
+#include "base/values.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "shell/common/api/object_life_monitor.h"
 
@@ -35,6 +38,15 @@ class RemoteCallbackFreer : public ObjectLifeMonitor,
   void RenderViewDeleted(content::RenderViewHost*) override;
 
  private:
+  // { (process_id, routing_id, context_id) => [object_id, ...] }
+  using PendingReleases =
+      std::map<std::tuple<int, int, std::string>, base::ListValue>;
+
+  static PendingReleases* pending_releases();
+  // Sends the callbacks collected since the last flush, one message per frame
+  // and context.
+  static void FlushReleases();
+
   std::string context_id_;
   int object_id_;
 
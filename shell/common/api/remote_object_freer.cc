@@ -4,8 +4,13 @@
 
 #include "shell/common/api/remote_object_freer.h"
 
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/no_destructor.h"
 #include "base/strings/utf_string_conversions.h"
-#include "base/values.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
@@ -80,17 +85,48 @@ void RemoteObjectFreer::RunDestructor() {
       ref_mapper_.erase(objects_it);
   }
 
-  auto* channel = "ELECTRON_BROWSER_DEREFERENCE";
+  // The objects collected by a garbage collection are released together.
+  PendingDereferences* pending = pending_dereferences();
+  if (pending->empty()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&RemoteObjectFreer::FlushDereferences));
+  }
+  auto ref = std::make_unique<base::ListValue>();
+  ref->AppendInteger(object_id_);
+  ref->AppendInteger(ref_count);
+  (*pending)[std::make_pair(routing_id_, context_id_)].Append(std::move(ref));
+}
+
+// static
+RemoteObjectFreer::PendingDereferences*
+RemoteObjectFreer::pending_dereferences() {
+  static base::NoDestructor<PendingDereferences> pending;
+  return pending.get();
+}
 
-  base::ListValue args;
-  args.AppendString(context_id_);
-  args.AppendInteger(object_id_);
-  args.AppendInteger(ref_count);
+// static
+void RemoteObjectFreer::FlushDereferences() {
+  PendingDereferences pending;
+  pending.swap(*pending_dereferences());
 
-  mojom::ElectronBrowserAssociatedPtr electron_ptr;
-  render_frame->GetRemoteAssociatedInterfaces()->GetInterface(
-      mojo::MakeRequest(&electron_ptr));
-  electron_ptr->Message(true, channel, args.Clone());
+  auto* channel = "ELECTRON_BROWSER_DEREFERENCE";
+  for (auto& frame_refs : pending) {
+    content::RenderFrame* render_frame =
+        content::RenderFrame::FromRoutingID(frame_refs.first.first);
+    if (!render_frame)
+      continue;
+
+    base::ListValue args;
+    args.AppendString(frame_refs.first.second);
+    args.Append(
+        std::make_unique<base::ListValue>(std::move(frame_refs.second)));
+
+    mojom::ElectronBrowserAssociatedPtr electron_ptr;
+    render_frame->GetRemoteAssociatedInterfaces()->GetInterface(
+        mojo::MakeRequest(&electron_ptr));
+    electron_ptr->Message(true, channel, std::move(args),
+                          base::TimeTicks::Now());
+  }
 }
 
 }  // namespace electron
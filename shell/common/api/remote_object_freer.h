@@ -7,7 +7,9 @@
 
 #include <map>
 #include <string>
+#include <utility>
 
+#include "base/values.h"
 #include "shell/common/api/object_life_monitor.h"
 
 namespace electron {
@@ -33,6 +35,15 @@ class RemoteObjectFreer : public ObjectLifeMonitor {
   static std::map<std::string, std::map<int, int>> ref_mapper_;
 
  private:
+  // { (routing_id, context_id) => [[object_id, ref_count], ...] }
+  using PendingDereferences =
+      std::map<std::pair<int, std::string>, base::ListValue>;
+
+  static PendingDereferences* pending_dereferences();
+  // Sends the objects collected since the last flush, one message per frame
+  // and context.
+  static void FlushDereferences();
+
   std::string context_id_;
   int object_id_;
   int routing_id_;
@@ -26,6 +26,7 @@
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/std_converter.h"
 #include "shell/common/gin_converters/value_converter_gin_adapter.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_includes.h"
 
 namespace gin {
@@ -225,7 +226,7 @@ bool Converter<net::HttpResponseHeaders*>::FromV8(
 v8::Local<v8::Value> Converter<net::HttpRequestHeaders>::ToV8(
     v8::Isolate* isolate,
     const net::HttpRequestHeaders& val) {
-  gin::Dictionary headers(isolate, v8::Object::New(isolate));
+  gin_helper::Dictionary headers(isolate, v8::Object::New(isolate));
   for (net::HttpRequestHeaders::Iterator it(val); it.GetNext();)
     headers.Set(it.name(), it.value());
   return ConvertToV8(isolate, headers);
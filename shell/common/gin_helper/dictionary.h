@@ -10,6 +10,7 @@
 #include "base/bind.h"
 #include "gin/dictionary.h"
 #include "shell/common/gin_helper/function_template.h"
+#include "shell/common/gin_helper/key_cache.h"
 
 namespace gin_helper {
 
@@ -41,7 +42,8 @@ struct CallbackTraits<base::Callback<T>> {
 template <typename T>
 struct CallbackTraits<
     T,
-    typename std::enable_if<std::is_member_function_pointer<T>::value>::type> {
+    typename std::enable_if<std::is_member_function_pointer<T>::value &&
+                            !MemberFunctionTraits<T>::is_simple>::type> {
   static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate* isolate,
                                                         T callback) {
     int flags = HolderIsFirstArgument;
@@ -50,6 +52,18 @@ struct CallbackTraits<
   }
 };
 
+// Member functions that only take simple arguments are called directly on
+// the holder instead of through a base::Callback.
+template <typename T>
+struct CallbackTraits<
+    T,
+    typename std::enable_if<MemberFunctionTraits<T>::is_simple>::type> {
+  static v8::Local<v8::FunctionTemplate> CreateTemplate(v8::Isolate* isolate,
+                                                        T callback) {
+    return CreateMemberFunctionTemplate(isolate, callback);
+  }
+};
+
 // Adds a few more extends methods to gin::Dictionary.
 //
 // Note that as the destructor of gin::Dictionary is not virtual, and we want to
@@ -65,11 +79,32 @@ class Dictionary : public gin::Dictionary {
   Dictionary(const gin::Dictionary& dict)  // NOLINT(runtime/explicit)
       : gin::Dictionary(dict) {}
 
+  // Same as gin::Dictionary::Get and Set, with the keys cached by KeyToV8.
+  template <typename T>
+  bool Get(base::StringPiece key, T* out) const {
+    v8::Local<v8::Value> val;
+    if (!GetHandle()
+             ->Get(isolate()->GetCurrentContext(), KeyToV8(isolate(), key))
+             .ToLocal(&val))
+      return false;
+    return gin::ConvertFromV8(isolate(), val, out);
+  }
+
+  template <typename T>
+  bool Set(base::StringPiece key, const T& val) {
+    v8::Local<v8::Value> v8_value;
+    if (!gin::TryConvertToV8(isolate(), val, &v8_value))
+      return false;
+    v8::Maybe<bool> result = GetHandle()->Set(
+        isolate()->GetCurrentContext(), KeyToV8(isolate(), key), v8_value);
+    return !result.IsNothing() && result.FromJust();
+  }
+
   template <typename T>
   bool GetHidden(base::StringPiece key, T* out) const {
     v8::Local<v8::Context> context = isolate()->GetCurrentContext();
     v8::Local<v8::Private> privateKey =
-        v8::Private::ForApi(isolate(), gin::StringToV8(isolate(), key));
+        v8::Private::ForApi(isolate(), KeyToV8(isolate(), key));
     v8::Local<v8::Value> value;
     v8::Maybe<bool> result = GetHandle()->HasPrivate(context, privateKey);
     if (result.IsJust() && result.FromJust() &&
@@ -85,7 +120,7 @@ class Dictionary : public gin::Dictionary {
       return false;
     v8::Local<v8::Context> context = isolate()->GetCurrentContext();
     v8::Local<v8::Private> privateKey =
-        v8::Private::ForApi(isolate(), gin::StringToV8(isolate(), key));
+        v8::Private::ForApi(isolate(), KeyToV8(isolate(), key));
     v8::Maybe<bool> result =
         GetHandle()->SetPrivate(context, privateKey, v8_value);
     return !result.IsNothing() && result.FromJust();
@@ -96,7 +131,7 @@ class Dictionary : public gin::Dictionary {
     auto context = isolate()->GetCurrentContext();
     auto templ = CallbackTraits<T>::CreateTemplate(isolate(), callback);
     return GetHandle()
-        ->Set(context, gin::StringToV8(isolate(), key),
+        ->Set(context, KeyToV8(isolate(), key),
               templ->GetFunction(context).ToLocalChecked())
         .ToChecked();
   }
@@ -107,14 +142,14 @@ class Dictionary : public gin::Dictionary {
     if (!gin::TryConvertToV8(isolate(), val, &v8_value))
       return false;
     v8::Maybe<bool> result = GetHandle()->DefineOwnProperty(
-        isolate()->GetCurrentContext(), gin::StringToV8(isolate(), key),
+        isolate()->GetCurrentContext(), KeyToV8(isolate(), key),
         v8_value, v8::ReadOnly);
     return !result.IsNothing() && result.FromJust();
   }
 
   bool Delete(base::StringPiece key) {
     v8::Maybe<bool> result = GetHandle()->Delete(
-        isolate()->GetCurrentContext(), gin::StringToV8(isolate(), key));
+        isolate()->GetCurrentContext(), KeyToV8(isolate(), key));
     return !result.IsNothing() && result.FromJust();
   }
 
@@ -5,7 +5,11 @@
 #ifndef SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
 #define SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
 
+#include <string>
+#include <type_traits>
+
 #include "base/callback.h"
+#include "base/strings/string16.h"
 #include "gin/arguments.h"
 #include "shell/common/gin_helper/destroyable.h"
 #include "shell/common/gin_helper/error_thrower.h"
@@ -160,6 +164,58 @@ struct ArgumentHolder {
   }
 };
 
+// Sets the return value of a call without going through gin::Arguments.
+// Booleans and numbers are stored in the return value directly instead of
+// allocating a handle for them.
+template <typename T>
+void SetReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                    const T& value) {
+  info.GetReturnValue().Set(gin::ConvertToV8(info.GetIsolate(), value));
+}
+inline void SetReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                           bool value) {
+  info.GetReturnValue().Set(value);
+}
+inline void SetReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                           int32_t value) {
+  info.GetReturnValue().Set(value);
+}
+inline void SetReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                           uint32_t value) {
+  info.GetReturnValue().Set(value);
+}
+inline void SetReturnValue(const v8::FunctionCallbackInfo<v8::Value>& info,
+                           double value) {
+  info.GetReturnValue().Set(value);
+}
+
+// Calls a member function and sets its result as the return value.
+template <typename ReturnType>
+struct MethodCaller {
+  template <typename ClassType, typename Method, typename... Args>
+  static void Call(const v8::FunctionCallbackInfo<v8::Value>& info,
+                   ClassType* object,
+                   Method method,
+                   Args&... args) {
+    v8::MicrotasksScope script_scope(info.GetIsolate(),
+                                     v8::MicrotasksScope::kRunMicrotasks);
+    SetReturnValue(info, (object->*method)(args...));
+  }
+};
+
+template <>
+struct MethodCaller<void> {
+  template <typename ClassType, typename Method, typename... Args>
+  static void Call(const v8::FunctionCallbackInfo<v8::Value>& info,
+                   ClassType* object,
+                   Method method,
+                   Args&... args) {
+    v8::MicrotasksScope script_scope(info.GetIsolate(),
+                                     v8::MicrotasksScope::kRunMicrotasks);
+    (object->*method)(args...);
+  }
+};
+
 // Class template for converting arguments from JavaScript to C++ and running
 // the callback with them.
 template <typename IndicesType, typename... ArgTypes>
@@ -200,6 +256,15 @@ class Invoker<IndicesHolder<indices...>, ArgTypes...>
     callback.Run(ArgumentHolder<indices, ArgTypes>::value...);
   }
 
+  // Calls |method| on |object| directly, see MemberDispatcher.
+  template <typename ReturnType, typename ClassType, typename Method>
+  void DispatchToMethod(const v8::FunctionCallbackInfo<v8::Value>& info,
+                        ClassType* object,
+                        Method method) {
+    MethodCaller<ReturnType>::Call(info, object, method,
+                                   ArgumentHolder<indices, ArgTypes>::value...);
+  }
+
  private:
   static bool And() { return true; }
   template <typename... T>
@@ -235,6 +300,123 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
   }
 };
 
+// Whether an argument of type |T| is converted from a single JavaScript value
+// by its Converter, without looking at the rest of the call.
+template <typename T>
+struct IsSimpleArgument
+    : std::integral_constant<bool,
+                             std::is_arithmetic<T>::value ||
+                                 std::is_same<T, std::string>::value ||
+                                 std::is_same<T, base::string16>::value> {};
+template <typename T>
+struct IsSimpleArgument<v8::Local<T>> : std::true_type {};
+
+template <typename... ArgTypes>
+struct AreSimpleArguments : std::true_type {};
+template <typename T, typename... ArgTypes>
+struct AreSimpleArguments<T, ArgTypes...>
+    : std::integral_constant<
+          bool,
+          IsSimpleArgument<typename CallbackParamTraits<T>::LocalType>::value &&
+              AreSimpleArguments<ArgTypes...>::value> {};
+
+template <typename Method,
+          typename ReturnType,
+          typename ClassType,
+          typename... ArgTypes>
+struct MemberFunctionTraitsImpl {
+  using Class = ClassType;
+
+  static constexpr bool is_simple = AreSimpleArguments<ArgTypes...>::value;
+
+  static void Invoke(const v8::FunctionCallbackInfo<v8::Value>& info,
+                     ClassType* object,
+                     Method method) {
+    Invoke(info, object, method,
+           std::integral_constant<bool, sizeof...(ArgTypes) == 0>());
+  }
+
+ private:
+  // Getters and other methods without arguments don't need gin::Arguments at
+  // all.
+  static void Invoke(const v8::FunctionCallbackInfo<v8::Value>& info,
+                     ClassType* object,
+                     Method method,
+                     std::true_type no_arguments) {
+    MethodCaller<ReturnType>::Call(info, object, method);
+  }
+
+  static void Invoke(const v8::FunctionCallbackInfo<v8::Value>& info,
+                     ClassType* object,
+                     Method method,
+                     std::false_type no_arguments) {
+    gin::Arguments args(info);
+    using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
+    Invoker<Indices, ArgTypes...> invoker(&args, 0);
+    if (invoker.IsOK())
+      invoker.template DispatchToMethod<ReturnType>(info, object, method);
+  }
+};
+
+// MemberFunctionTraits<T>::is_simple is true for member function pointers
+// that only take simple arguments, those are bound by
+// CreateMemberFunctionTemplate.
+template <typename T>
+struct MemberFunctionTraits {
+  static constexpr bool is_simple = false;
+};
+template <typename ReturnType, typename ClassType, typename... ArgTypes>
+struct MemberFunctionTraits<ReturnType (ClassType::*)(ArgTypes...)>
+    : MemberFunctionTraitsImpl<ReturnType (ClassType::*)(ArgTypes...),
+                               ReturnType,
+                               ClassType,
+                               ArgTypes...> {};
+template <typename ReturnType, typename ClassType, typename... ArgTypes>
+struct MemberFunctionTraits<ReturnType (ClassType::*)(ArgTypes...) const>
+    : MemberFunctionTraitsImpl<ReturnType (ClassType::*)(ArgTypes...) const,
+                               ReturnType,
+                               ClassType,
+                               ArgTypes...> {};
+
+// MemberFunctionHolder keeps the member function pointer of a function
+// template alive, the same way CallbackHolder keeps its base::Callback.
+template <typename T>
+class MemberFunctionHolder : public CallbackHolderBase {
+ public:
+  MemberFunctionHolder(v8::Isolate* isolate, T method)
+      : CallbackHolderBase(isolate), method(method) {}
+  T method;
+
+ private:
+  virtual ~MemberFunctionHolder() = default;
+
+  DISALLOW_COPY_AND_ASSIGN(MemberFunctionHolder);
+};
+
+// MemberDispatcher calls the member function on the native object of the
+// receiver, without binding it into a base::Callback first.
+template <typename T>
+struct MemberDispatcher {
+  static void DispatchToMethod(
+      const v8::FunctionCallbackInfo<v8::Value>& info) {
+    v8::Local<v8::Object> receiver = info.Holder();
+    if (gin_helper::Destroyable::IsDestroyed(receiver)) {
+      gin::Arguments(info).ThrowTypeError("Object has been destroyed");
+      return;
+    }
+    typename MemberFunctionTraits<T>::Class* object = nullptr;
+    if (!gin::ConvertFromV8(info.GetIsolate(), receiver, &object)) {
+      gin::Arguments(info).ThrowError();
+      return;
+    }
+
+    auto* holder = static_cast<MemberFunctionHolder<T>*>(
+        reinterpret_cast<CallbackHolderBase*>(
+            info.Data().As<v8::External>()->Value()));
+    MemberFunctionTraits<T>::Invoke(info, object, holder->method);
+  }
+};
+
 // CreateFunctionTemplate creates a v8::FunctionTemplate that will create
 // JavaScript functions that execute a provided C++ function or base::Callback.
 // JavaScript arguments are automatically converted via gin::Converter, as is
@@ -258,6 +440,24 @@ v8::Local<v8::FunctionTemplate> CreateFunctionTemplate(
                                        isolate, holder->GetHandle(isolate)));
 }
 
+// CreateMemberFunctionTemplate creates a v8::FunctionTemplate that calls
+// |method| on the object the JavaScript function is called on. Only member
+// functions with simple arguments are supported, see MemberFunctionTraits.
+template <typename T>
+v8::Local<v8::FunctionTemplate> CreateMemberFunctionTemplate(
+    v8::Isolate* isolate,
+    T method) {
+  static_assert(MemberFunctionTraits<T>::is_simple,
+                "Use CreateFunctionTemplate for this member function");
+  typedef MemberFunctionHolder<T> HolderT;
+  HolderT* holder = new HolderT(isolate, method);
+
+  return v8::FunctionTemplate::New(isolate,
+                                   &MemberDispatcher<T>::DispatchToMethod,
+                                   gin::ConvertToV8<v8::Local<v8::External>>(
+                                       isolate, holder->GetHandle(isolate)));
+}
+
 }  // namespace gin_helper
 
 #endif  // SHELL_COMMON_GIN_HELPER_FUNCTION_TEMPLATE_H_
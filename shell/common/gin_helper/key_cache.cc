@@ -0,0 +1,75 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/gin_helper/key_cache.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/lazy_instance.h"
+#include "base/threading/thread_local.h"
+#include "gin/converter.h"
+
+namespace gin_helper {
+
+namespace {
+
+// Longer strings are unlikely to be property names that are used again.
+const size_t kMaxKeyLength = 64;
+
+// Eternal handles are only released with the isolate, so bound their number
+// for callers that pass arbitrary keys, like header names.
+const size_t kMaxKeys = 2048;
+
+struct KeyCache {
+  explicit KeyCache(v8::Isolate* isolate) : isolate(isolate) {}
+
+  v8::Isolate* isolate;
+  // Owns the characters the keys of |strings| point to.
+  std::vector<std::unique_ptr<std::string>> names;
+  std::unordered_map<base::StringPiece,
+                     v8::Eternal<v8::String>,
+                     base::StringPieceHash>
+      strings;
+};
+
+// Each isolate runs on its own thread: the browser and renderer main
+// threads, and the threads of web workers.
+base::LazyInstance<base::ThreadLocalPointer<KeyCache>>::Leaky g_key_cache_tls =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+v8::Local<v8::String> KeyToV8(v8::Isolate* isolate, base::StringPiece key) {
+  KeyCache* cache = g_key_cache_tls.Pointer()->Get();
+  if (!cache) {
+    cache = new KeyCache(isolate);
+    g_key_cache_tls.Pointer()->Set(cache);
+  }
+  if (cache->isolate != isolate || key.size() > kMaxKeyLength)
+    return gin::StringToSymbol(isolate, key);
+
+  auto iter = cache->strings.find(key);
+  if (iter != cache->strings.end())
+    return iter->second.Get(isolate);
+
+  v8::Local<v8::String> string = gin::StringToSymbol(isolate, key);
+  if (cache->strings.size() < kMaxKeys) {
+    cache->names.push_back(std::make_unique<std::string>(key.as_string()));
+    cache->strings[*cache->names.back()].Set(isolate, string);
+  }
+  return string;
+}
+
+void ClearKeyCache(v8::Isolate* isolate) {
+  KeyCache* cache = g_key_cache_tls.Pointer()->Get();
+  if (cache && cache->isolate == isolate) {
+    g_key_cache_tls.Pointer()->Set(nullptr);
+    delete cache;
+  }
+}
+
+}  // namespace gin_helper
@@ -0,0 +1,27 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_GIN_HELPER_KEY_CACHE_H_
+#define SHELL_COMMON_GIN_HELPER_KEY_CACHE_H_
+
+#include "base/strings/string_piece.h"
+#include "v8/include/v8.h"
+
+namespace gin_helper {
+
+// Returns |key| as an internalized V8 string.
+//
+// The strings are kept in eternal handles of the isolate of the current
+// thread, so that setting and reading the same properties over and over does
+// not create a new string each time. Long keys, and keys beyond a fixed
+// number of entries, are internalized without being cached.
+v8::Local<v8::String> KeyToV8(v8::Isolate* isolate, base::StringPiece key);
+
+// Forgets the keys cached for |isolate|, must be called before the isolate is
+// disposed.
+void ClearKeyCache(v8::Isolate* isolate);
+
+}  // namespace gin_helper
+
+#endif  // SHELL_COMMON_GIN_HELPER_KEY_CACHE_H_
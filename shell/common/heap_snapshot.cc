@@ -4,53 +4,289 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/containers/circular_deque.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
+#include "third_party/zlib/zlib.h"
 #include "v8/include/v8-profiler.h"
 
 namespace {
 
+// Size of the chunks V8 serializes the snapshot into.
+const int kChunkSize = 64 * 1024;
+
+// Number of serialized chunks that may wait for the background writer before
+// the serializing thread starts writing them itself.
+const size_t kMaxQueuedChunks = 64;
+
+// Compresses and writes chunks of the snapshot in order.
+//
+// Chunks are queued by the serializing thread and drained by a task on the
+// thread pool. When the queue is full the serializing thread drains it
+// itself, which bounds memory usage without having to block on the writer.
+// Draining happens under |write_lock_| for both, which keeps the chunks in
+// order.
+class SnapshotWriter : public base::RefCountedThreadSafe<SnapshotWriter> {
+ public:
+  SnapshotWriter(base::File* file, bool gzip) : file_(file), gzip_(gzip) {
+    if (gzip_) {
+      // 16 + MAX_WBITS selects the gzip wrapper.
+      gzip_ = deflateInit2(&zstream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                           16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+      failed_ = !gzip_;
+    }
+  }
+
+  // Called on the serializing thread.
+  bool Push(const char* data, int size, base::TimeDelta* stall_time) {
+    uncompressed_bytes_ += size;
+    bool start_writer = false;
+    bool queue_full = false;
+    {
+      base::AutoLock auto_lock(queue_lock_);
+      if (failed_)
+        return false;
+      queue_.emplace_back(data, data + size);
+      queue_full = queue_.size() > kMaxQueuedChunks;
+      start_writer = !writer_scheduled_;
+      writer_scheduled_ = true;
+    }
+
+    if (start_writer) {
+      PostDrainTask();
+    }
+
+    if (queue_full) {
+      base::TimeTicks start = base::TimeTicks::Now();
+      TRACE_EVENT0("electron", "SnapshotWriter::Stall");
+      DrainChunks();
+      *stall_time += base::TimeTicks::Now() - start;
+    }
+    return true;
+  }
+
+  // Called on the serializing thread once V8 is done, waits for the queued
+  // chunks to be written and flushes the compressor.
+  bool Finish() {
+    DrainChunks();
+    base::AutoLock write_lock(write_lock_);
+    if (gzip_ && !HasFailed())
+      Deflate(nullptr, 0, Z_FINISH);
+    if (gzip_)
+      deflateEnd(&zstream_);
+    // Tasks that are still scheduled must not touch |file_| anymore.
+    file_ = nullptr;
+    return !HasFailed();
+  }
+
+  uint64_t uncompressed_bytes() const { return uncompressed_bytes_; }
+  // Also read by the serializing thread to report progress while the
+  // background writer is running.
+  uint64_t bytes_written() const { return bytes_written_.load(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<SnapshotWriter>;
+  ~SnapshotWriter() = default;
+
+  void PostDrainTask() {
+    base::PostTaskWithTraits(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&SnapshotWriter::Drain, this));
+  }
+
+  void Drain() {
+    TRACE_EVENT0("electron", "SnapshotWriter::Drain");
+    DrainChunks();
+    base::AutoLock auto_lock(queue_lock_);
+    writer_scheduled_ = false;
+    // Chunks pushed after DrainChunks() returned are drained by another task.
+    if (!queue_.empty() && !failed_) {
+      writer_scheduled_ = true;
+      PostDrainTask();
+    }
+  }
+
+  void DrainChunks() {
+    base::AutoLock write_lock(write_lock_);
+    while (file_) {
+      std::vector<char> chunk;
+      {
+        base::AutoLock queue_lock(queue_lock_);
+        if (queue_.empty() || failed_)
+          return;
+        chunk = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      bool success = gzip_ ? Deflate(chunk.data(), chunk.size(), Z_NO_FLUSH)
+                           : Write(chunk.data(), chunk.size());
+      if (!success) {
+        base::AutoLock queue_lock(queue_lock_);
+        failed_ = true;
+        queue_.clear();
+        return;
+      }
+      TRACE_COUNTER1("electron", "HeapSnapshotBytesWritten", bytes_written());
+    }
+  }
+
+  bool Write(const char* data, size_t size) {
+    write_lock_.AssertAcquired();
+    int written = file_->WriteAtCurrentPos(data, size);
+    if (written < 0 || static_cast<size_t>(written) != size)
+      return false;
+    bytes_written_ += size;
+    return true;
+  }
+
+  bool Deflate(const char* data, size_t size, int flush) {
+    write_lock_.AssertAcquired();
+    zstream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    zstream_.avail_in = size;
+    deflate_buffer_.resize(kChunkSize);
+    int result;
+    do {
+      zstream_.next_out = reinterpret_cast<Bytef*>(deflate_buffer_.data());
+      zstream_.avail_out = deflate_buffer_.size();
+      result = deflate(&zstream_, flush);
+      if (result == Z_STREAM_ERROR)
+        return false;
+      if (!Write(deflate_buffer_.data(),
+                 deflate_buffer_.size() - zstream_.avail_out))
+        return false;
+    } while (zstream_.avail_out == 0 ||
+             (flush == Z_FINISH && result != Z_STREAM_END));
+    return true;
+  }
+
+  bool HasFailed() {
+    base::AutoLock queue_lock(queue_lock_);
+    return failed_;
+  }
+
+  // Guarded by |write_lock_|.
+  base::Lock write_lock_;
+  base::File* file_;
+  bool gzip_;
+  z_stream zstream_ = {};
+  std::vector<char> deflate_buffer_;
+  std::atomic<uint64_t> bytes_written_{0};
+
+  // Guarded by |queue_lock_|. Never acquire |write_lock_| while holding it.
+  base::Lock queue_lock_;
+  base::circular_deque<std::vector<char>> queue_;
+  bool writer_scheduled_ = false;
+  bool failed_ = false;
+
+  // Only touched by the serializing thread.
+  uint64_t uncompressed_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SnapshotWriter);
+};
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
-  explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
-    DCHECK(file_);
+  HeapSnapshotOutputStream(SnapshotWriter* writer,
+                           base::TimeDelta snapshot_time,
+                           const electron::HeapSnapshotOptions& options)
+      : writer_(writer),
+        snapshot_time_(snapshot_time),
+        progress_(options.progress),
+        start_(base::TimeTicks::Now()) {
+    DCHECK(writer_);
   }
 
   bool IsComplete() const { return is_complete_; }
 
+  electron::HeapSnapshotStats GetStats() const {
+    electron::HeapSnapshotStats stats;
+    stats.uncompressed_bytes = writer_->uncompressed_bytes();
+    stats.bytes_written = writer_->bytes_written();
+    stats.snapshot_time = snapshot_time_;
+    stats.serialization_time = base::TimeTicks::Now() - start_;
+    stats.stall_time = stall_time_;
+    return stats;
+  }
+
+  void ReportProgress() const {
+    if (progress_)
+      progress_.Run(GetStats());
+  }
+
   // v8::OutputStream
-  int GetChunkSize() override { return 65536; }
+  int GetChunkSize() override { return kChunkSize; }
   void EndOfStream() override { is_complete_ = true; }
 
   v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
-    auto bytes_written = file_->WriteAtCurrentPos(data, size);
-    return bytes_written == size ? kContinue : kAbort;
+    if (!writer_->Push(data, size, &stall_time_))
+      return kAbort;
+    // The snapshot is not on the JavaScript heap, so the callback may run
+    // script while it is serialized.
+    ReportProgress();
+    return kContinue;
   }
 
  private:
-  base::File* file_ = nullptr;
+  SnapshotWriter* writer_;
+  base::TimeDelta snapshot_time_;
+  base::RepeatingCallback<void(const electron::HeapSnapshotStats&)> progress_;
+  base::TimeTicks start_;
+  base::TimeDelta stall_time_;
   bool is_complete_ = false;
 };
 
+// Reports the progress of taking the snapshot to tracing.
+class HeapSnapshotProgress : public v8::ActivityControl {
+ public:
+  // v8::ActivityControl
+  ControlOption ReportProgressValue(int done, int total) override {
+    TRACE_COUNTER2("electron", "HeapSnapshotProgress", "done", done, "total",
+                   total);
+    return kContinue;
+  }
+};
+
 }  // namespace
 
 namespace electron {
 
-bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File* file,
+                      const HeapSnapshotOptions& options,
+                      HeapSnapshotStats* stats) {
   DCHECK(isolate);
   DCHECK(file);
+  TRACE_EVENT1("electron", "TakeHeapSnapshot", "gzip", options.gzip);
 
   if (!file->IsValid())
     return false;
 
-  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  base::TimeTicks start = base::TimeTicks::Now();
+  HeapSnapshotProgress progress;
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot(&progress);
   if (!snapshot)
     return false;
+  base::TimeTicks snapshot_taken = base::TimeTicks::Now();
 
-  HeapSnapshotOutputStream stream(file);
+  auto writer = base::MakeRefCounted<SnapshotWriter>(file, options.gzip);
+  HeapSnapshotOutputStream stream(writer.get(), snapshot_taken - start,
+                                  options);
   snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
 
   const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
 
-  return stream.IsComplete();
+  bool success = writer->Finish() && stream.IsComplete();
+  if (success)
+    stream.ReportProgress();
+  if (stats)
+    *stats = stream.GetStats();
+  return success;
 }
 
 }  // namespace electron
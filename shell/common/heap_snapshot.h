@@ -5,12 +5,44 @@
 #ifndef SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include <cstdint>
+
+#include "base/callback.h"
 #include "base/files/file.h"
+#include "base/time/time.h"
 #include "v8/include/v8.h"
 
 namespace electron {
 
-bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
+struct HeapSnapshotStats {
+  // Size of the serialized JSON.
+  uint64_t uncompressed_bytes = 0;
+  // Size of what ended up in the file.
+  uint64_t bytes_written = 0;
+  // Time spent taking the snapshot and serializing it on the calling thread.
+  base::TimeDelta snapshot_time;
+  base::TimeDelta serialization_time;
+  // Part of |serialization_time| the calling thread spent writing chunks
+  // itself because the background writer fell behind.
+  base::TimeDelta stall_time;
+};
+
+struct HeapSnapshotOptions {
+  // Whether to write the snapshot as a gzip stream.
+  bool gzip = false;
+  // Called on the calling thread with the stats so far after each serialized
+  // chunk, and with the final stats once everything is written.
+  base::RepeatingCallback<void(const HeapSnapshotStats&)> progress;
+};
+
+// Takes a heap snapshot of |isolate| and writes it to |file|. The snapshot is
+// serialized on the calling thread while the chunks are compressed and
+// written on a background sequence. Returns once everything is written.
+// |stats| is optional.
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      base::File* file,
+                      const HeapSnapshotOptions& options,
+                      HeapSnapshotStats* stats);
 
 }  // namespace electron
 
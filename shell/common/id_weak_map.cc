@@ -0,0 +1,156 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/id_weak_map.h"
+
+#include <utility>
+
+namespace electron {
+
+namespace {
+
+// The window is never trimmed below this many slots.
+const size_t kMinWindow = 64;
+
+}  // namespace
+
+IDWeakMap::IDWeakMap() = default;
+
+// The entries are weak, destroying their handles is enough.
+IDWeakMap::~IDWeakMap() = default;
+
+void IDWeakMap::Set(v8::Isolate* isolate,
+                    int32_t id,
+                    v8::Local<v8::Object> object,
+                    void* pointer) {
+  Entry* entry = Find(id);
+  if (!entry) {
+    std::unique_ptr<Entry>* slot = GetSlot(id);
+    if (slot)
+      ++window_size_;
+    else
+      slot = &overflow_[id];
+    *slot = std::make_unique<Entry>();
+    entry = slot->get();
+  }
+  entry->id = id;
+  entry->pointer = pointer;
+  entry->self = this;
+  entry->object.Reset(isolate, object);
+  entry->object.SetWeak(entry, OnObjectGC, v8::WeakCallbackType::kParameter);
+}
+
+v8::MaybeLocal<v8::Object> IDWeakMap::Get(v8::Isolate* isolate,
+                                          int32_t id) const {
+  const Entry* entry = Find(id);
+  if (!entry)
+    return v8::MaybeLocal<v8::Object>();
+  return v8::Local<v8::Object>::New(isolate, entry->object);
+}
+
+void* IDWeakMap::GetPointer(int32_t id) const {
+  const Entry* entry = Find(id);
+  return entry ? entry->pointer : nullptr;
+}
+
+void IDWeakMap::SetPointer(int32_t id, void* pointer) {
+  Entry* entry = Find(id);
+  if (entry)
+    entry->pointer = pointer;
+}
+
+std::vector<v8::Local<v8::Object>> IDWeakMap::Values(
+    v8::Isolate* isolate) const {
+  std::vector<v8::Local<v8::Object>> values;
+  values.reserve(size());
+  ForEach([&](const Entry& entry) {
+    values.emplace_back(v8::Local<v8::Object>::New(isolate, entry.object));
+  });
+  return values;
+}
+
+void IDWeakMap::Remove(int32_t id) {
+  size_t index = static_cast<uint32_t>(id) - static_cast<uint32_t>(base_);
+  if (index < slots_.size() && slots_[index] && slots_[index]->id == id) {
+    slots_[index].reset();
+    --window_size_;
+    Trim();
+    return;
+  }
+  overflow_.erase(id);
+}
+
+// static
+void IDWeakMap::OnObjectGC(const v8::WeakCallbackInfo<Entry>& data) {
+  Entry* entry = data.GetParameter();
+  entry->self->Remove(entry->id);
+}
+
+const IDWeakMap::Entry* IDWeakMap::Find(int32_t id) const {
+  // IDs below |base_| wrap around to indices past the end of the window.
+  size_t index = static_cast<uint32_t>(id) - static_cast<uint32_t>(base_);
+  if (index < slots_.size()) {
+    const Entry* entry = slots_[index].get();
+    if (entry && entry->id == id)
+      return entry;
+  }
+  if (overflow_.empty())
+    return nullptr;
+  auto it = overflow_.find(id);
+  return it == overflow_.end() ? nullptr : it->second.get();
+}
+
+std::unique_ptr<IDWeakMap::Entry>* IDWeakMap::GetSlot(int32_t id) {
+  if (slots_.empty()) {
+    base_ = id;
+    slots_.emplace_back();
+    return &slots_.back();
+  }
+
+  int64_t index = static_cast<int64_t>(id) - base_;
+  int64_t size = static_cast<int64_t>(slots_.size());
+  if (index >= 0 && index < size)
+    return &slots_[index];
+
+  int64_t needed = index < 0 ? size - index : index + 1;
+  if (static_cast<size_t>(needed) > MaxWindow(window_size_ + 1))
+    return nullptr;
+
+  if (index < 0) {
+    for (int64_t i = index; i < 0; ++i)
+      slots_.emplace_front();
+    base_ = id;
+    return &slots_.front();
+  }
+  slots_.resize(index + 1);
+  return &slots_.back();
+}
+
+void IDWeakMap::Trim() {
+  while (!slots_.empty() && !slots_.back())
+    slots_.pop_back();
+  while (!slots_.empty() && !slots_.front()) {
+    slots_.pop_front();
+    ++base_;
+  }
+
+  while (slots_.size() > MaxWindow(window_size_)) {
+    // The front slot is live, otherwise it would have been dropped. Only the
+    // pointer moves, so the weak callback keeps its parameter.
+    int32_t id = slots_.front()->id;
+    overflow_[id] = std::move(slots_.front());
+    --window_size_;
+    do {
+      slots_.pop_front();
+      ++base_;
+    } while (!slots_.empty() && !slots_.front());
+  }
+}
+
+// static
+size_t IDWeakMap::MaxWindow(size_t entries) {
+  return entries * 2 + kMinWindow;
+}
+
+}  // namespace electron
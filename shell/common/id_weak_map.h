@@ -0,0 +1,113 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_ID_WEAK_MAP_H_
+#define SHELL_COMMON_ID_WEAK_MAP_H_
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+// Like KeyWeakMap<int32_t>, but optimized for IDs that are handed out in
+// increasing order and never reused, like the IDs of TrackableObjects.
+//
+// Live IDs are stored in a dense window of slots indexed by |id - base|, so
+// a lookup is an array access followed by a check of the ID stored in the
+// slot. The window is trimmed as IDs are removed; when a few long-lived IDs
+// would keep a mostly empty window alive they are moved to a hash map.
+//
+// Each entry can carry a raw pointer next to the object, which lets callers
+// get to their native object without creating a handle.
+class IDWeakMap {
+ public:
+  struct Entry {
+    int32_t id = 0;
+    void* pointer = nullptr;
+    v8::Global<v8::Object> object;
+    IDWeakMap* self = nullptr;
+  };
+
+  IDWeakMap();
+  virtual ~IDWeakMap();
+
+  // Sets the object with the given |id|, replacing any previous one.
+  void Set(v8::Isolate* isolate,
+           int32_t id,
+           v8::Local<v8::Object> object,
+           void* pointer = nullptr);
+
+  // Gets the object with |id|.
+  v8::MaybeLocal<v8::Object> Get(v8::Isolate* isolate, int32_t id) const;
+
+  // Gets the pointer stored with |id|, or nullptr.
+  void* GetPointer(int32_t id) const;
+
+  // Replaces the pointer stored with |id|, if there is one.
+  void SetPointer(int32_t id, void* pointer);
+
+  bool Has(int32_t id) const { return Find(id) != nullptr; }
+
+  // Returns all objects.
+  std::vector<v8::Local<v8::Object>> Values(v8::Isolate* isolate) const;
+
+  // Removes the object with |id|.
+  void Remove(int32_t id);
+
+  // Calls |callback| with each live Entry, without allocating. The map must
+  // not be modified while iterating.
+  template <typename Callback>
+  void ForEach(const Callback& callback) const {
+    for (const auto& entry : slots_) {
+      if (entry)
+        callback(*entry);
+    }
+    for (const auto& it : overflow_)
+      callback(*it.second);
+  }
+
+  size_t size() const { return window_size_ + overflow_.size(); }
+
+ private:
+  static void OnObjectGC(const v8::WeakCallbackInfo<Entry>& data);
+
+  const Entry* Find(int32_t id) const;
+  Entry* Find(int32_t id) {
+    return const_cast<Entry*>(static_cast<const IDWeakMap*>(this)->Find(id));
+  }
+
+  // Returns an empty slot for |id|, growing the window when |id| is close
+  // enough to it, or nullptr if it should go to |overflow_|.
+  std::unique_ptr<Entry>* GetSlot(int32_t id);
+
+  // Drops empty slots at both ends of the window, and moves the oldest
+  // entries out of it while it is mostly empty.
+  void Trim();
+
+  // The largest window allowed for |entries| live entries in it.
+  static size_t MaxWindow(size_t entries);
+
+  // Slots for the IDs in [base_, base_ + slots_.size()), empty slots are
+  // null. Entries are allocated on their own so that their address, which
+  // the weak callbacks hold, stays the same when they move to |overflow_|:
+  // Trim() runs from those callbacks, while V8 may still have callbacks for
+  // other entries of the same garbage collection queued.
+  std::deque<std::unique_ptr<Entry>> slots_;
+  int32_t base_ = 0;
+  size_t window_size_ = 0;
+
+  // Entries whose ID is outside of the window.
+  std::unordered_map<int32_t, std::unique_ptr<Entry>> overflow_;
+
+  DISALLOW_COPY_AND_ASSIGN(IDWeakMap);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_ID_WEAK_MAP_H_
@@ -0,0 +1,283 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/image_ops.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/aligned_memory.h"
+#include "skia/ext/image_operations.h"
+#include "third_party/libyuv/include/libyuv/convert_argb.h"
+#include "third_party/libyuv/include/libyuv/convert_from_argb.h"
+#include "third_party/libyuv/include/libyuv/cpu_id.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
+#include "third_party/libyuv/include/libyuv/scale_argb.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "ui/gfx/geometry/point_conversions.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+// libyuv's ARGB is the B, G, R, A byte order used by N32 on the platforms
+// Electron supports.
+static_assert(kN32_SkColorType == kBGRA_8888_SkColorType,
+              "image_ops expects N32 to be BGRA");
+
+namespace electron {
+
+namespace image_ops {
+
+namespace {
+
+const uint8_t* Pixels(const SkBitmap& bitmap) {
+  return static_cast<const uint8_t*>(bitmap.getPixels());
+}
+
+uint8_t* Pixels(SkBitmap* bitmap) {
+  return static_cast<uint8_t*>(bitmap->getPixels());
+}
+
+int Stride(const SkBitmap& bitmap) {
+  return static_cast<int>(bitmap.rowBytes());
+}
+
+// Picks the overlay representation closest to |scale|.
+const gfx::ImageSkiaRep* FindRep(const std::vector<gfx::ImageSkiaRep>& reps,
+                                 float scale) {
+  const gfx::ImageSkiaRep* best = nullptr;
+  for (const auto& rep : reps) {
+    if (!best ||
+        std::abs(rep.scale() - scale) < std::abs(best->scale() - scale))
+      best = &rep;
+  }
+  return best;
+}
+
+class Pipeline {
+ public:
+  explicit Pipeline(const SkBitmap& source) : current_(source) {}
+
+  SkBitmap Finish() { return std::move(current_); }
+
+  void Resize(const gfx::Size& size, ScaleFilter filter) {
+    if (size.IsEmpty()) {
+      current_.reset();
+      return;
+    }
+    if (current_.drawsNothing())
+      return;
+    if (size.width() == current_.width() && size.height() == current_.height())
+      return;
+
+    if (filter == ScaleFilter::kLanczos) {
+      current_ = skia::ImageOperations::Resize(
+          current_, skia::ImageOperations::RESIZE_LANCZOS3, size.width(),
+          size.height());
+      writable_ = true;
+      return;
+    }
+
+    SkBitmap* dst = Scratch(size.width(), size.height());
+    libyuv::ARGBScale(Pixels(current_), Stride(current_), current_.width(),
+                      current_.height(), Pixels(dst), Stride(*dst),
+                      dst->width(), dst->height(),
+                      filter == ScaleFilter::kBox ? libyuv::kFilterBox
+                                                  : libyuv::kFilterBilinear);
+    SwapWithScratch();
+  }
+
+  void Blur(int radius) {
+    int width = current_.width();
+    int height = current_.height();
+    // Same clamping as libyuv, which sizes the summed area table below.
+    radius = std::min({radius, height, width / 2 - 1});
+    if (radius <= 0 || current_.drawsNothing())
+      return;
+
+    // The table is used as a ring buffer of radius * 2 + 2 rows.
+    const int stride32 = width * 4;
+    const int rows = std::min(height, radius * 2 + 2);
+    const size_t table_size = sizeof(int32_t) * stride32 * rows;
+    std::unique_ptr<int32_t, base::AlignedFreeDeleter> cumsum(
+        static_cast<int32_t*>(base::AlignedAlloc(table_size, 16)));
+
+    SkBitmap* dst = Scratch(width, height);
+    libyuv::ARGBBlur(Pixels(current_), Stride(current_), Pixels(dst),
+                     Stride(*dst), cumsum.get(), stride32, width, height,
+                     radius);
+    SwapWithScratch();
+  }
+
+  void Grayscale() {
+    if (current_.drawsNothing())
+      return;
+    MakeWritable();
+    libyuv::ARGBGray(Pixels(&current_), Stride(current_), 0, 0,
+                     current_.width(), current_.height());
+  }
+
+  void Composite(const SkBitmap& overlay, const gfx::Point& origin) {
+    if (current_.drawsNothing() || overlay.drawsNothing())
+      return;
+    MakeWritable();
+    // Skia blends in place with its own SIMD code and, unlike libyuv's
+    // ARGBBlend, keeps the destination alpha.
+    SkCanvas canvas(current_);
+    canvas.drawBitmap(overlay, origin.x(), origin.y());
+  }
+
+ private:
+  // Returns a bitmap of the given size that can be written to, reusing the
+  // previous scratch bitmap when the size matches.
+  SkBitmap* Scratch(int width, int height) {
+    if (scratch_.width() != width || scratch_.height() != height)
+      scratch_.allocN32Pixels(width, height);
+    return &scratch_;
+  }
+
+  void SwapWithScratch() {
+    std::swap(current_, scratch_);
+    // The source must never become the destination of a later step.
+    if (!writable_)
+      scratch_.reset();
+    writable_ = true;
+  }
+
+  void MakeWritable() {
+    if (writable_)
+      return;
+    SkBitmap* dst = Scratch(current_.width(), current_.height());
+    libyuv::ARGBCopy(Pixels(current_), Stride(current_), Pixels(dst),
+                     Stride(*dst), current_.width(), current_.height());
+    SwapWithScratch();
+  }
+
+  SkBitmap current_;
+  SkBitmap scratch_;
+  // Whether |current_| is owned by the pipeline rather than the source.
+  bool writable_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(Pipeline);
+};
+
+}  // namespace
+
+Operation::Operation() = default;
+Operation::Operation(const Operation&) = default;
+Operation::~Operation() = default;
+
+SkBitmap ApplyOperations(const SkBitmap& source,
+                         float scale,
+                         const std::vector<Operation>& operations) {
+  DCHECK(source.isNull() || source.colorType() == kN32_SkColorType);
+  Pipeline pipeline(source);
+  for (const auto& operation : operations) {
+    switch (operation.type) {
+      case Operation::Type::kResize:
+        pipeline.Resize(gfx::ScaleToFlooredSize(operation.size, scale),
+                        operation.filter);
+        break;
+      case Operation::Type::kBlur:
+        pipeline.Blur(std::lround(operation.radius * scale));
+        break;
+      case Operation::Type::kGrayscale:
+        pipeline.Grayscale();
+        break;
+      case Operation::Type::kComposite: {
+        const gfx::ImageSkiaRep* rep = FindRep(operation.overlay, scale);
+        if (rep) {
+          pipeline.Composite(rep->GetBitmap(), gfx::ScaleToFlooredPoint(
+                                                   operation.origin, scale));
+        }
+        break;
+      }
+    }
+  }
+  return pipeline.Finish();
+}
+
+std::vector<uint8_t> ExportPixels(const SkBitmap& bitmap,
+                                  PixelFormat format,
+                                  bool premultiplied) {
+  if (bitmap.drawsNothing())
+    return std::vector<uint8_t>();
+
+  const int width = bitmap.width();
+  const int height = bitmap.height();
+  const int stride = width * 4;
+  std::vector<uint8_t> pixels(static_cast<size_t>(stride) * height);
+  if (format == PixelFormat::kRGBA) {
+    libyuv::ARGBToABGR(Pixels(bitmap), Stride(bitmap), pixels.data(), stride,
+                       width, height);
+    if (!premultiplied) {
+      // Unpremultiplying only looks at the alpha channel, which is in the
+      // same place for both orders.
+      libyuv::ARGBUnattenuate(pixels.data(), stride, pixels.data(), stride,
+                              width, height);
+    }
+  } else if (premultiplied) {
+    libyuv::ARGBCopy(Pixels(bitmap), Stride(bitmap), pixels.data(), stride,
+                     width, height);
+  } else {
+    libyuv::ARGBUnattenuate(Pixels(bitmap), Stride(bitmap), pixels.data(),
+                            stride, width, height);
+  }
+  return pixels;
+}
+
+SkBitmap ImportPixels(const uint8_t* pixels,
+                      int width,
+                      int height,
+                      PixelFormat format,
+                      bool premultiplied) {
+  SkBitmap bitmap;
+  if (width <= 0 || height <= 0 || !bitmap.tryAllocN32Pixels(width, height))
+    return bitmap;
+
+  const int stride = width * 4;
+  uint8_t* dst = Pixels(&bitmap);
+  if (format == PixelFormat::kRGBA) {
+    libyuv::ABGRToARGB(pixels, stride, dst, Stride(bitmap), width, height);
+    if (!premultiplied) {
+      libyuv::ARGBAttenuate(dst, Stride(bitmap), dst, Stride(bitmap), width,
+                            height);
+    }
+  } else if (premultiplied) {
+    libyuv::ARGBCopy(pixels, stride, dst, Stride(bitmap), width, height);
+  } else {
+    libyuv::ARGBAttenuate(pixels, stride, dst, Stride(bitmap), width, height);
+  }
+  return bitmap;
+}
+
+std::vector<uint8_t> ExportI420(const SkBitmap& bitmap) {
+  if (bitmap.drawsNothing())
+    return std::vector<uint8_t>();
+
+  const int width = bitmap.width();
+  const int height = bitmap.height();
+  const int chroma_width = (width + 1) / 2;
+  const int chroma_height = (height + 1) / 2;
+  const size_t y_size = static_cast<size_t>(width) * height;
+  const size_t chroma_size = static_cast<size_t>(chroma_width) * chroma_height;
+  std::vector<uint8_t> planes(y_size + chroma_size * 2);
+  uint8_t* y = planes.data();
+  uint8_t* u = y + y_size;
+  uint8_t* v = u + chroma_size;
+  libyuv::ARGBToI420(Pixels(bitmap), Stride(bitmap), y, width, u, chroma_width,
+                     v, chroma_width, width, height);
+  return planes;
+}
+
+void SetSIMDEnabled(bool enabled) {
+  // -1 enables every feature the CPU has, 1 leaves only kCpuInitialized.
+  libyuv::MaskCpuFlags(enabled ? -1 : 1);
+}
+
+}  // namespace image_ops
+
+}  // namespace electron
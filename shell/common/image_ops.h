@@ -0,0 +1,94 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_IMAGE_OPS_H_
+#define SHELL_COMMON_IMAGE_OPS_H_
+
+#include <vector>
+
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/size.h"
+#include "ui/gfx/image/image_skia_rep.h"
+
+namespace electron {
+
+namespace image_ops {
+
+// Pixel operations on N32 premultiplied bitmaps. The kernels come from libyuv
+// and Skia, which pick SSE2/AVX2/NEON implementations at runtime and fall back
+// to portable C.
+
+enum class ScaleFilter {
+  kBox,
+  kBilinear,
+  kLanczos,
+};
+
+// One step of a pipeline. Sizes and positions are in DIP and are scaled by
+// the scale factor of the representation being processed.
+struct Operation {
+  enum class Type {
+    kResize,
+    kBlur,
+    kGrayscale,
+    kComposite,
+  };
+
+  Operation();
+  Operation(const Operation&);
+  ~Operation();
+
+  Type type = Type::kGrayscale;
+
+  // kResize.
+  gfx::Size size;
+  ScaleFilter filter = ScaleFilter::kBox;
+
+  // kBlur.
+  float radius = 0.f;
+
+  // kComposite: draws |overlay| over the image at |origin|.
+  std::vector<gfx::ImageSkiaRep> overlay;
+  gfx::Point origin;
+};
+
+// Runs |operations| on a representation with |scale|. The source is never
+// written to. Steps reuse one scratch bitmap, so only the first write and
+// steps that change the size allocate.
+SkBitmap ApplyOperations(const SkBitmap& source,
+                         float scale,
+                         const std::vector<Operation>& operations);
+
+// Pixel layouts of raw bitmaps exchanged with JavaScript.
+enum class PixelFormat {
+  kBGRA,
+  kRGBA,
+};
+
+// Converts |bitmap| to tightly packed pixels in |format|.
+std::vector<uint8_t> ExportPixels(const SkBitmap& bitmap,
+                                  PixelFormat format,
+                                  bool premultiplied);
+
+// Creates an N32 premultiplied bitmap from tightly packed pixels.
+SkBitmap ImportPixels(const uint8_t* pixels,
+                      int width,
+                      int height,
+                      PixelFormat format,
+                      bool premultiplied);
+
+// Converts |bitmap| to I420: the Y plane followed by the U and V planes, each
+// subsampled by two and rounded up.
+std::vector<uint8_t> ExportI420(const SkBitmap& bitmap);
+
+// Restricts the libyuv kernels to their portable C versions. Used for
+// benchmarking, it affects the whole process.
+void SetSIMDEnabled(bool enabled);
+
+}  // namespace image_ops
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_IMAGE_OPS_H_
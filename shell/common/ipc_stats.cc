@@ -0,0 +1,106 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/ipc_stats.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/no_destructor.h"
+
+namespace electron {
+
+namespace {
+
+// Tags, lengths and the like that every serialized value carries.
+const size_t kValueOverhead = 8;
+
+}  // namespace
+
+IpcStats::IpcStats() = default;
+
+IpcStats::~IpcStats() = default;
+
+// static
+IpcStats* IpcStats::GetForRendererProcess() {
+  static base::NoDestructor<IpcStats> instance;
+  return instance.get();
+}
+
+// static
+size_t IpcStats::EstimateSize(const base::Value& value) {
+  switch (value.type()) {
+    case base::Value::Type::STRING:
+      return kValueOverhead + value.GetString().size();
+    case base::Value::Type::BINARY:
+      return kValueOverhead + value.GetBlob().size();
+    case base::Value::Type::DICTIONARY: {
+      size_t size = kValueOverhead;
+      for (const auto& item : value.DictItems())
+        size += item.first.size() + EstimateSize(item.second);
+      return size;
+    }
+    case base::Value::Type::LIST: {
+      size_t size = kValueOverhead;
+      for (const auto& item : value.GetList())
+        size += EstimateSize(item);
+      return size;
+    }
+    default:
+      return kValueOverhead;
+  }
+}
+
+void IpcStats::RecordSent(const std::string& channel,
+                          size_t bytes,
+                          base::TimeDelta conversion_time) {
+  ChannelStats& stats = channels_[channel];
+  stats.messages_sent++;
+  stats.bytes_sent += bytes;
+  stats.conversion_time += conversion_time;
+}
+
+void IpcStats::RecordReceived(const std::string& channel,
+                              size_t bytes,
+                              base::TimeDelta conversion_time,
+                              base::TimeDelta queue_delay,
+                              base::TimeDelta handler_time) {
+  ChannelStats& stats = channels_[channel];
+  stats.messages_received++;
+  stats.bytes_received += bytes;
+  stats.conversion_time += conversion_time;
+  // Clocks of different processes are not guaranteed to agree exactly.
+  stats.queue_delay += std::max(queue_delay, base::TimeDelta());
+  stats.handler_time += handler_time;
+}
+
+void IpcStats::Reset() {
+  channels_.clear();
+}
+
+base::Value IpcStats::ToValue() const {
+  base::Value result(base::Value::Type::DICTIONARY);
+  for (const auto& it : channels_) {
+    const ChannelStats& stats = it.second;
+    base::Value channel(base::Value::Type::DICTIONARY);
+    channel.SetKey("messagesSent",
+                   base::Value(static_cast<double>(stats.messages_sent)));
+    channel.SetKey("bytesSent",
+                   base::Value(static_cast<double>(stats.bytes_sent)));
+    channel.SetKey("messagesReceived",
+                   base::Value(static_cast<double>(stats.messages_received)));
+    channel.SetKey("bytesReceived",
+                   base::Value(static_cast<double>(stats.bytes_received)));
+    channel.SetKey("conversionTime",
+                   base::Value(stats.conversion_time.InMillisecondsF()));
+    channel.SetKey("queueDelay",
+                   base::Value(stats.queue_delay.InMillisecondsF()));
+    channel.SetKey("handlerTime",
+                   base::Value(stats.handler_time.InMillisecondsF()));
+    result.SetKey(it.first, std::move(channel));
+  }
+  return result;
+}
+
+}  // namespace electron
@@ -0,0 +1,71 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_IPC_STATS_H_
+#define SHELL_COMMON_IPC_STATS_H_
+
+#include <map>
+#include <string>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace electron {
+
+// Per-channel counters for the IPC traffic of one endpoint: a WebContents in
+// the browser process, or the whole renderer process. All methods must be
+// called on the thread that owns the endpoint.
+class IpcStats {
+ public:
+  struct ChannelStats {
+    uint64_t messages_sent = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t messages_received = 0;
+    uint64_t bytes_received = 0;
+    // Time spent converting between V8 values and base::Value.
+    base::TimeDelta conversion_time;
+    // Time between the sender posting a message and it being dispatched.
+    base::TimeDelta queue_delay;
+    // Time spent in the JavaScript handlers of received messages.
+    base::TimeDelta handler_time;
+  };
+
+  IpcStats();
+  ~IpcStats();
+
+  // The instance shared by all frames of a renderer process.
+  static IpcStats* GetForRendererProcess();
+
+  // Rough size in bytes of |value| once serialized, good enough to spot the
+  // heavy channels.
+  static size_t EstimateSize(const base::Value& value);
+
+  void RecordSent(const std::string& channel,
+                  size_t bytes,
+                  base::TimeDelta conversion_time);
+  void RecordReceived(const std::string& channel,
+                      size_t bytes,
+                      base::TimeDelta conversion_time,
+                      base::TimeDelta queue_delay,
+                      base::TimeDelta handler_time);
+  void Reset();
+
+  // Returns { [channel]: { messagesSent, bytesSent, ... } } with times in
+  // milliseconds.
+  base::Value ToValue() const;
+
+  const std::map<std::string, ChannelStats>& channels() const {
+    return channels_;
+  }
+
+ private:
+  std::map<std::string, ChannelStats> channels_;
+
+  DISALLOW_COPY_AND_ASSIGN(IpcStats);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_IPC_STATS_H_
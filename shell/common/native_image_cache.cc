@@ -0,0 +1,229 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/native_image_cache.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+#include "shell/common/asar/archive.h"
+#include "shell/common/asar/asar_util.h"
+#include "shell/common/skia_util.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace electron {
+
+namespace {
+
+// Enough for a few hundred typical icons at 1x and 2x.
+const size_t kDefaultBudget = 32 * 1024 * 1024;
+
+// One of the files an image is read from.
+struct Variant {
+  base::FilePath path;
+  float scale = 1.0f;
+  int64_t size = 0;
+  base::Time last_modified;
+
+};
+
+// Reads the size and modification time of |path|. Files inside an asar
+// archive take the modification time of the archive, unpacked ones their
+// own.
+bool StatFile(const base::FilePath& path, Variant* variant) {
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::FilePath asar_path, relative_path;
+  if (!asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+    base::File::Info info;
+    if (!base::GetFileInfo(path, &info) || info.is_directory)
+      return false;
+    variant->size = info.size;
+    variant->last_modified = info.last_modified;
+    return true;
+  }
+
+  std::shared_ptr<asar::Archive> archive =
+      asar::GetOrCreateAsarArchive(asar_path);
+  asar::Archive::FileInfo file_info;
+  if (!archive || !archive->GetFileInfo(relative_path, &file_info))
+    return false;
+  base::FilePath real_path = asar_path;
+  if (file_info.unpacked) {
+    real_path = asar_path.AddExtension(FILE_PATH_LITERAL("unpacked"))
+                    .Append(relative_path);
+  }
+  base::File::Info info;
+  if (!base::GetFileInfo(real_path, &info))
+    return false;
+  variant->size = file_info.unpacked ? info.size : file_info.size;
+  variant->last_modified = info.last_modified;
+  return true;
+}
+
+SkBitmap DecodeFile(const Variant& variant) {
+  gfx::ImageSkia decoded;
+  if (!util::AddImageSkiaRepFromPath(&decoded, variant.path, variant.scale))
+    return SkBitmap();
+  SkBitmap bitmap = decoded.image_reps().front().GetBitmap();
+  bitmap.setImmutable();
+  return bitmap;
+}
+
+}  // namespace
+
+class NativeImageCache::Entry
+    : public base::RefCountedThreadSafe<NativeImageCache::Entry> {
+ public:
+  explicit Entry(std::vector<Variant> variants)
+      : variants_(std::move(variants)) {}
+
+  // Whether |variants| describe the same files as this entry.
+  bool Matches(const std::vector<Variant>& variants) const {
+    if (variants.size() != variants_.size())
+      return false;
+    for (size_t i = 0; i < variants.size(); ++i) {
+      if (variants[i].path != variants_[i].path ||
+          variants[i].size != variants_[i].size ||
+          variants[i].last_modified != variants_[i].last_modified)
+        return false;
+    }
+    return true;
+  }
+
+  // Decodes every variant, skipping the ones that fail like
+  // util::AddImageSkiaRepFromPath does. Called from Load, where blocking IO is
+  // allowed, before the entry is shared, so drawing a cached image never
+  // reads from disk.
+  bool Init() {
+    for (const auto& variant : variants_) {
+      SkBitmap bitmap = DecodeFile(variant);
+      if (bitmap.isNull())
+        continue;
+      bytes_ += bitmap.computeByteSize();
+      reps_.emplace_back(bitmap, variant.scale);
+    }
+    return !reps_.empty();
+  }
+
+  const std::vector<gfx::ImageSkiaRep>& reps() const { return reps_; }
+  size_t bytes() const { return bytes_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<Entry>;
+
+  ~Entry() = default;
+
+  std::vector<Variant> variants_;
+  std::vector<gfx::ImageSkiaRep> reps_;
+  size_t bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(Entry);
+};
+
+// static
+NativeImageCache* NativeImageCache::GetInstance() {
+  static base::NoDestructor<NativeImageCache> instance;
+  return instance.get();
+}
+
+NativeImageCache::NativeImageCache()
+    : entries_(decltype(entries_)::NO_AUTO_EVICT), budget_(kDefaultBudget) {}
+
+NativeImageCache::~NativeImageCache() = default;
+
+scoped_refptr<NativeImageCache::Entry> NativeImageCache::Load(
+    const base::FilePath& path) {
+  std::vector<Variant> variants;
+  for (const auto& scaled_path : util::GetScaledImagePaths(path)) {
+    Variant variant;
+    variant.path = scaled_path.first;
+    variant.scale = scaled_path.second;
+    if (StatFile(variant.path, &variant))
+      variants.push_back(std::move(variant));
+  }
+  if (variants.empty())
+    return nullptr;
+
+  {
+    base::AutoLock auto_lock(lock_);
+    auto it = entries_.Get(path.value());
+    if (it != entries_.end() && it->second->Matches(variants)) {
+      ++hits_;
+      return it->second;
+    }
+    ++misses_;
+  }
+
+  auto entry = base::MakeRefCounted<Entry>(std::move(variants));
+  if (!entry->Init())
+    return nullptr;
+
+  base::AutoLock auto_lock(lock_);
+  // Replaces an outdated entry for the same path, or one added by another
+  // thread in the meantime.
+  auto it = entries_.Peek(path.value());
+  if (it != entries_.end())
+    bytes_ -= it->second->bytes();
+  entries_.Put(path.value(), entry);
+  OnDecoded(entry->bytes());
+  return entry;
+}
+
+// static
+gfx::ImageSkia NativeImageCache::CreateImage(scoped_refptr<Entry> entry) {
+  if (!entry)
+    return gfx::ImageSkia();
+  // Every variant was decoded by Load. Without a source gfx::ImageSkia falls
+  // back to the closest representation for scales without a file.
+  gfx::ImageSkia image;
+  for (const auto& rep : entry->reps())
+    image.AddRepresentation(rep);
+  return image;
+}
+
+gfx::ImageSkia NativeImageCache::GetImage(const base::FilePath& path) {
+  return CreateImage(Load(path));
+}
+
+void NativeImageCache::SetBudget(size_t bytes) {
+  base::AutoLock auto_lock(lock_);
+  budget_ = bytes;
+  EvictIfNeeded();
+}
+
+NativeImageCache::Stats NativeImageCache::GetStats() {
+  base::AutoLock auto_lock(lock_);
+  Stats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  stats.entries = entries_.size();
+  stats.bytes = bytes_;
+  stats.budget = budget_;
+  return stats;
+}
+
+void NativeImageCache::OnDecoded(size_t bytes) {
+  lock_.AssertAcquired();
+  bytes_ += bytes;
+  EvictIfNeeded();
+}
+
+void NativeImageCache::EvictIfNeeded() {
+  lock_.AssertAcquired();
+  while (bytes_ > budget_ && !entries_.empty()) {
+    auto oldest = entries_.rbegin();
+    // Images created from the entry keep its bitmaps alive.
+    bytes_ -= oldest->second->bytes();
+    entries_.Erase(oldest);
+    ++evictions_;
+  }
+}
+
+}  // namespace electron
@@ -0,0 +1,88 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_NATIVE_IMAGE_CACHE_H_
+#define SHELL_COMMON_NATIVE_IMAGE_CACHE_H_
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "ui/gfx/image/image_skia.h"
+
+namespace electron {
+
+// A process-wide cache of images decoded from files, shared by every
+// NativeImage created from a path.
+//
+// Entries are keyed by path and are only reused while the size and
+// modification time of each scale variant ("icon.png", "icon@2x.png", ...)
+// are unchanged. All variants are decoded when the entry is loaded, so that
+// drawing a cached image never does blocking IO. The decoded bitmaps are
+// immutable and shared by all images using the entry; callers handing their
+// pixels to JavaScript must copy them.
+// When the decoded bitmaps exceed the budget, the least recently used
+// entries are dropped; images still holding their bitmaps keep them alive.
+class NativeImageCache {
+ public:
+  class Entry;
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t budget = 0;
+  };
+
+  static NativeImageCache* GetInstance();
+
+  // Looks up or decodes the image at |path|. Returns nullptr if no variant
+  // of the image could be decoded. Does blocking IO and can be called on any
+  // thread.
+  scoped_refptr<Entry> Load(const base::FilePath& path);
+
+  // Creates an image backed by |entry|. The image is bound to the calling
+  // sequence like any other gfx::ImageSkia.
+  static gfx::ImageSkia CreateImage(scoped_refptr<Entry> entry);
+
+  // Shortcut for CreateImage(Load(path)).
+  gfx::ImageSkia GetImage(const base::FilePath& path);
+
+  void SetBudget(size_t bytes);
+  Stats GetStats();
+
+ private:
+  friend class base::NoDestructor<NativeImageCache>;
+
+  NativeImageCache();
+  ~NativeImageCache();
+
+  // Accounts for |bytes| of newly decoded pixels. Must be called with |lock_|
+  // held.
+  void OnDecoded(size_t bytes);
+
+  // Drops the least recently used entries until the budget is respected.
+  // Must be called with |lock_| held.
+  void EvictIfNeeded();
+
+  base::Lock lock_;
+  base::MRUCache<base::FilePath::StringType, scoped_refptr<Entry>> entries_;
+  size_t bytes_ = 0;
+  size_t budget_;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(NativeImageCache);
+};
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_NATIVE_IMAGE_CACHE_H_
@@ -0,0 +1,58 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_NATIVE_MATE_CONVERTERS_HEAP_SNAPSHOT_CONVERTER_H_
+#define SHELL_COMMON_NATIVE_MATE_CONVERTERS_HEAP_SNAPSHOT_CONVERTER_H_
+
+#include <string>
+
+#include "native_mate/dictionary.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/heap_snapshot.h"
+#include "shell/common/native_mate_converters/callback_converter_deprecated.h"
+
+namespace mate {
+
+template <>
+struct Converter<electron::HeapSnapshotStats> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const electron::HeapSnapshotStats& val) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    // TODO(zcbenz): Just call SetHidden when this file is converted to gin.
+    gin_helper::Dictionary(isolate, dict.GetHandle()).SetHidden("simple", true);
+    dict.Set("uncompressedBytes", static_cast<double>(val.uncompressed_bytes));
+    dict.Set("bytesWritten", static_cast<double>(val.bytes_written));
+    dict.Set("snapshotTime", val.snapshot_time.InMillisecondsF());
+    dict.Set("serializationTime", val.serialization_time.InMillisecondsF());
+    dict.Set("stallTime", val.stall_time.InMillisecondsF());
+    return dict.GetHandle();
+  }
+};
+
+template <>
+struct Converter<electron::HeapSnapshotOptions> {
+  static bool FromV8(v8::Isolate* isolate,
+                     v8::Local<v8::Value> val,
+                     electron::HeapSnapshotOptions* out) {
+    mate::Dictionary dict;
+    if (!ConvertFromV8(isolate, val, &dict))
+      return false;
+    std::string compression;
+    if (dict.Get("compression", &compression)) {
+      if (compression == "gzip")
+        out->gzip = true;
+      else if (compression != "none")
+        return false;
+    }
+    v8::Local<v8::Value> on_progress;
+    if (dict.Get("onProgress", &on_progress) &&
+        !ConvertFromV8(isolate, on_progress, &out->progress))
+      return false;
+    return true;
+  }
+};
+
+}  // namespace mate
+
+#endif  // SHELL_COMMON_NATIVE_MATE_CONVERTERS_HEAP_SNAPSHOT_CONVERTER_H_
@@ -4,7 +4,7 @@
 
 #include "shell/common/native_mate_converters/v8_value_converter.h"
 
-#include <map>
+#include <array>
 #include <memory>
 #include <string>
 #include <utility>
@@ -12,6 +12,7 @@
 
 #include "base/values.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/key_cache.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
 
@@ -21,6 +22,18 @@ namespace {
 
 const int kMaxRecursionDepth = 100;
 
+// Converts |str| to UTF-8 without the intermediate buffer of Utf8Value.
+std::string V8StringToUTF8(v8::Isolate* isolate, v8::Local<v8::String> str) {
+  std::string result;
+  int length = str->Utf8Length(isolate);
+  if (length > 0) {
+    result.resize(length);
+    str->WriteUtf8(isolate, &result[0], length, nullptr,
+                   v8::String::NO_NULL_TERMINATION);
+  }
+  return result;
+}
+
 }  // namespace
 
 // The state of a call to FromV8Value.
@@ -40,54 +53,43 @@ class V8ValueConverter::FromV8ValueState {
 
   FromV8ValueState() : max_recursion_depth_(kMaxRecursionDepth) {}
 
-  // If |handle| is not in |unique_map_|, then add it to |unique_map_| and
-  // return true.
+  // If |handle| is not one of the objects currently being converted, push it
+  // onto the ancestor stack and return true.
   //
-  // Otherwise do nothing and return false. Here "A is unique" means that no
-  // other handle B in the map points to the same object as A. Note that A can
-  // be unique even if there already is another handle with the same identity
-  // hash (key) in the map, because two objects can have the same hash.
-  bool AddToUniquenessCheck(v8::Local<v8::Object> handle) {
-    int hash;
-    auto iter = GetIteratorInMap(handle, &hash);
-    if (iter != unique_map_.end())
-      return false;
-
-    unique_map_.insert(std::make_pair(hash, handle));
+  // Otherwise do nothing and return false. Only ancestors have to be checked
+  // since converting the same object twice through different paths is fine,
+  // and the stack never gets deeper than kMaxRecursionDepth, so a linear scan
+  // comparing identity hashes first is cheaper than maintaining a map.
+  bool PushAncestor(v8::Local<v8::Object> handle) {
+    int hash = handle->GetIdentityHash();
+    for (size_t i = 0; i < ancestor_count_; ++i) {
+      // Operator == for handles actually compares the underlying objects.
+      if (ancestors_[i].hash == hash && ancestors_[i].object == handle)
+        return false;
+    }
+    CHECK_LT(ancestor_count_, ancestors_.size());
+    ancestors_[ancestor_count_++] = {hash, handle};
     return true;
   }
 
-  bool RemoveFromUniquenessCheck(v8::Local<v8::Object> handle) {
-    int unused_hash;
-    auto iter = GetIteratorInMap(handle, &unused_hash);
-    if (iter == unique_map_.end())
-      return false;
-    unique_map_.erase(iter);
-    return true;
+  void PopAncestor(v8::Local<v8::Object> handle) {
+    DCHECK_GT(ancestor_count_, 0u);
+    DCHECK(ancestors_[ancestor_count_ - 1].object == handle);
+    ancestor_count_--;
   }
 
   bool HasReachedMaxRecursionDepth() { return max_recursion_depth_ < 0; }
 
  private:
-  using HashToHandleMap = std::multimap<int, v8::Local<v8::Object>>;
-  using Iterator = HashToHandleMap::const_iterator;
-
-  Iterator GetIteratorInMap(v8::Local<v8::Object> handle, int* hash) {
-    *hash = handle->GetIdentityHash();
-    // We only compare using == with handles to objects with the same identity
-    // hash. Different hash obviously means different objects, but two objects
-    // in a couple of thousands could have the same identity hash.
-    std::pair<Iterator, Iterator> range = unique_map_.equal_range(*hash);
-    for (auto it = range.first; it != range.second; ++it) {
-      // Operator == for handles actually compares the underlying objects.
-      if (it->second == handle)
-        return it;
-    }
-    // Not found.
-    return unique_map_.end();
-  }
+  struct Ancestor {
+    int hash;
+    v8::Local<v8::Object> object;
+  };
 
-  HashToHandleMap unique_map_;
+  // Each container takes one recursion level before being pushed, so this
+  // can never overflow.
+  std::array<Ancestor, kMaxRecursionDepth + 1> ancestors_;
+  size_t ancestor_count_ = 0;
 
   int max_recursion_depth_;
 };
@@ -103,18 +105,15 @@ class V8ValueConverter::ScopedUniquenessGuard {
                         v8::Local<v8::Object> value)
       : state_(state),
         value_(value),
-        is_valid_(state_->AddToUniquenessCheck(value_)) {}
+        is_valid_(state_->PushAncestor(value_)) {}
   ~ScopedUniquenessGuard() {
-    if (is_valid_) {
-      bool removed = state_->RemoveFromUniquenessCheck(value_);
-      DCHECK(removed);
-    }
+    if (is_valid_)
+      state_->PopAncestor(value_);
   }
 
   bool is_valid() const { return is_valid_; }
 
  private:
-  typedef std::multimap<int, v8::Local<v8::Object>> HashToHandleMap;
   V8ValueConverter::FromV8ValueState* state_;
   v8::Local<v8::Object> value_;
   bool is_valid_;
@@ -150,7 +149,11 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Value(
   v8::Context::Scope context_scope(context);
   v8::HandleScope handle_scope(context->GetIsolate());
   FromV8ValueState state;
-  return FromV8ValueImpl(&state, val, context->GetIsolate());
+  base::Optional<base::Value> result =
+      FromV8ValueImpl(&state, val, context->GetIsolate());
+  if (!result)
+    return nullptr;
+  return std::make_unique<base::Value>(std::move(*result));
 }
 
 v8::Local<v8::Value> V8ValueConverter::ToV8ValueImpl(
@@ -176,8 +179,8 @@ v8::Local<v8::Value> V8ValueConverter::ToV8ValueImpl(
     }
 
     case base::Value::Type::STRING: {
-      std::string val = value->GetString();
-      return v8::String::NewFromUtf8(isolate, val.c_str(),
+      const std::string& val = value->GetString();
+      return v8::String::NewFromUtf8(isolate, val.data(),
                                      v8::NewStringType::kNormal, val.length())
           .ToLocalChecked();
     }
@@ -201,44 +204,42 @@ v8::Local<v8::Value> V8ValueConverter::ToV8ValueImpl(
 v8::Local<v8::Value> V8ValueConverter::ToV8Array(
     v8::Isolate* isolate,
     const base::ListValue* val) const {
-  v8::Local<v8::Array> result(v8::Array::New(isolate, val->GetSize()));
-  auto context = isolate->GetCurrentContext();
-
-  for (size_t i = 0; i < val->GetSize(); ++i) {
-    const base::Value* child = nullptr;
-    val->Get(i, &child);
-
-    v8::Local<v8::Value> child_v8 = ToV8ValueImpl(isolate, child);
-
-    v8::TryCatch try_catch(isolate);
-    result->Set(context, static_cast<uint32_t>(i), child_v8).Check();
-    if (try_catch.HasCaught())
-      LOG(ERROR) << "Setter for index " << i << " threw an exception.";
-  }
-
-  return result;
+  // Creating the array from its elements avoids going through the indexed
+  // setters for every element.
+  const base::Value::ListStorage& list = val->GetList();
+  std::vector<v8::Local<v8::Value>> elements;
+  elements.reserve(list.size());
+  for (const base::Value& child : list)
+    elements.push_back(ToV8ValueImpl(isolate, &child));
+
+  return v8::Array::New(isolate, elements.data(), elements.size());
 }
 
 v8::Local<v8::Value> V8ValueConverter::ToV8Object(
     v8::Isolate* isolate,
     const base::DictionaryValue* val) const {
-  gin_helper::Dictionary result = gin::Dictionary::CreateEmpty(isolate);
-  result.SetHidden("simple", true);
+  v8::Local<v8::Object> result = v8::Object::New(isolate);
+  gin_helper::Dictionary(isolate, result).SetHidden("simple", true);
+  auto context = isolate->GetCurrentContext();
 
-  for (base::DictionaryValue::Iterator iter(*val); !iter.IsAtEnd();
-       iter.Advance()) {
-    const std::string& key = iter.key();
-    v8::Local<v8::Value> child_v8 = ToV8ValueImpl(isolate, &iter.value());
+  for (const auto& item : val->DictItems()) {
+    const std::string& key = item.first;
+    // Dictionaries sent over IPC tend to share their keys, internalizing them
+    // lets V8 reuse the strings and the object shapes, and caching them skips
+    // the lookup in the string table.
+    v8::Local<v8::String> key_v8 = gin_helper::KeyToV8(isolate, key);
+    v8::Local<v8::Value> child_v8 = ToV8ValueImpl(isolate, &item.second);
 
     v8::TryCatch try_catch(isolate);
-    result.Set(key, child_v8);
-    if (try_catch.HasCaught()) {
+    if (!result->CreateDataProperty(context, key_v8, child_v8)
+             .FromMaybe(false) ||
+        try_catch.HasCaught()) {
       LOG(ERROR) << "Setter for property " << key.c_str() << " threw an "
                  << "exception.";
     }
   }
 
-  return result.GetHandle();
+  return result;
 }
 
 v8::Local<v8::Value> V8ValueConverter::ToArrayBuffer(
@@ -288,43 +289,40 @@ v8::Local<v8::Value> V8ValueConverter::ToArrayBuffer(
   return v8::Uint8Array::New(array_buffer, 0, length);
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
+base::Optional<base::Value> V8ValueConverter::FromV8ValueImpl(
     FromV8ValueState* state,
     v8::Local<v8::Value> val,
     v8::Isolate* isolate) const {
-  FromV8ValueState::Level state_level(state);
-  if (state->HasReachedMaxRecursionDepth())
-    return nullptr;
-
-  if (val->IsExternal())
-    return std::make_unique<base::Value>();
-
-  if (val->IsNull())
-    return std::make_unique<base::Value>();
-
-  auto context = isolate->GetCurrentContext();
-
-  if (val->IsBoolean())
-    return std::make_unique<base::Value>(val->ToBoolean(isolate)->Value());
+  // Primitives can't recurse, so they skip the depth bookkeeping. This keeps
+  // large arrays of numbers and strings cheap.
+  if (val->IsString())
+    return base::Value(V8StringToUTF8(isolate, val.As<v8::String>()));
 
   if (val->IsInt32())
-    return std::make_unique<base::Value>(val.As<v8::Int32>()->Value());
+    return base::Value(val.As<v8::Int32>()->Value());
 
   if (val->IsNumber()) {
     double val_as_double = val.As<v8::Number>()->Value();
     if (!std::isfinite(val_as_double))
-      return nullptr;
-    return std::make_unique<base::Value>(val_as_double);
+      return base::nullopt;
+    return base::Value(val_as_double);
   }
 
-  if (val->IsString()) {
-    v8::String::Utf8Value utf8(isolate, val);
-    return std::make_unique<base::Value>(std::string(*utf8, utf8.length()));
-  }
+  if (val->IsBoolean())
+    return base::Value(val->ToBoolean(isolate)->Value());
+
+  if (val->IsNull() || val->IsExternal())
+    return base::Value();
 
   if (val->IsUndefined())
     // JSON.stringify ignores undefined.
-    return nullptr;
+    return base::nullopt;
+
+  FromV8ValueState::Level state_level(state);
+  if (state->HasReachedMaxRecursionDepth())
+    return base::nullopt;
+
+  auto context = isolate->GetCurrentContext();
 
   if (val->IsDate()) {
     v8::Date* date = v8::Date::Cast(*val);
@@ -338,7 +336,7 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
           toISOString.As<v8::Function>()->Call(context, val, 0, nullptr);
       if (!result.IsEmpty()) {
         v8::String::Utf8Value utf8(isolate, result.ToLocalChecked());
-        return std::make_unique<base::Value>(std::string(*utf8, utf8.length()));
+        return base::Value(std::string(*utf8, utf8.length()));
       }
     }
   }
@@ -347,7 +345,7 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
     if (!reg_exp_allowed_)
       // JSON.stringify converts to an object.
       return FromV8Object(val.As<v8::Object>(), state, isolate);
-    return std::make_unique<base::Value>(*v8::String::Utf8Value(isolate, val));
+    return base::Value(*v8::String::Utf8Value(isolate, val));
   }
 
   // v8::Value doesn't have a ToArray() method for some reason.
@@ -357,10 +355,11 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
   if (val->IsFunction()) {
     if (!function_allowed_)
       // JSON.stringify refuses to convert function(){}.
-      return nullptr;
+      return base::nullopt;
     return FromV8Object(val.As<v8::Object>(), state, isolate);
   }
 
+  // Covers Buffer and every other ArrayBufferView, e.g. Uint8Array.
   if (node::Buffer::HasInstance(val)) {
     return FromNodeBuffer(val, state, isolate);
   }
@@ -370,16 +369,15 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8ValueImpl(
   }
 
   LOG(ERROR) << "Unexpected v8 value type encountered.";
-  return nullptr;
+  return base::nullopt;
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8Array(
-    v8::Local<v8::Array> val,
-    FromV8ValueState* state,
-    v8::Isolate* isolate) const {
+base::Value V8ValueConverter::FromV8Array(v8::Local<v8::Array> val,
+                                          FromV8ValueState* state,
+                                          v8::Isolate* isolate) const {
   ScopedUniquenessGuard uniqueness_guard(state, val);
   if (!uniqueness_guard.is_valid())
-    return std::make_unique<base::Value>();
+    return base::Value();
 
   std::unique_ptr<v8::Context::Scope> scope;
   // If val was created in a different context than our current one, change to
@@ -388,54 +386,51 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Array(
       val->CreationContext() != isolate->GetCurrentContext())
     scope = std::make_unique<v8::Context::Scope>(val->CreationContext());
 
-  std::unique_ptr<base::ListValue> result(new base::ListValue());
+  auto context = isolate->GetCurrentContext();
+  uint32_t length = val->Length();
+  base::Value::ListStorage result;
+  result.reserve(length);
 
   // Only fields with integer keys are carried over to the ListValue.
-  for (uint32_t i = 0; i < val->Length(); ++i) {
+  for (uint32_t i = 0; i < length; ++i) {
     v8::TryCatch try_catch(isolate);
     v8::Local<v8::Value> child_v8;
-    v8::MaybeLocal<v8::Value> maybe_child =
-        val->Get(isolate->GetCurrentContext(), i);
+    v8::MaybeLocal<v8::Value> maybe_child = val->Get(context, i);
     if (try_catch.HasCaught() || !maybe_child.ToLocal(&child_v8)) {
       LOG(ERROR) << "Getter for index " << i << " threw an exception.";
       child_v8 = v8::Null(isolate);
     }
 
-    if (!val->HasRealIndexedProperty(isolate->GetCurrentContext(), i)
-             .FromMaybe(false)) {
-      result->Append(std::make_unique<base::Value>());
-      continue;
-    }
-
-    std::unique_ptr<base::Value> child =
+    // Holes read as undefined and, like values that don't serialize (for
+    // example undefined and functions), are turned into null the way
+    // JSON.stringify does it.
+    base::Optional<base::Value> child =
         FromV8ValueImpl(state, child_v8, isolate);
     if (child)
-      result->Append(std::move(child));
+      result.push_back(std::move(*child));
     else
-      // JSON.stringify puts null in places where values don't serialize, for
-      // example undefined and functions. Emulate that behavior.
-      result->Append(std::make_unique<base::Value>());
+      result.emplace_back();
   }
-  return std::move(result);
+  return base::Value(std::move(result));
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromNodeBuffer(
-    v8::Local<v8::Value> value,
-    FromV8ValueState* state,
-    v8::Isolate* isolate) const {
-  std::vector<char> buffer(
-      node::Buffer::Data(value),
-      node::Buffer::Data(value) + node::Buffer::Length(value));
-  return std::make_unique<base::Value>(std::move(buffer));
+base::Value V8ValueConverter::FromNodeBuffer(v8::Local<v8::Value> value,
+                                             FromV8ValueState* state,
+                                             v8::Isolate* isolate) const {
+  // Copy straight into the blob storage, base::Value's std::vector<char>
+  // constructor would copy a second time.
+  const auto* data =
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(value));
+  return base::Value(
+      base::Value::BlobStorage(data, data + node::Buffer::Length(value)));
 }
 
-std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
-    v8::Local<v8::Object> val,
-    FromV8ValueState* state,
-    v8::Isolate* isolate) const {
+base::Value V8ValueConverter::FromV8Object(v8::Local<v8::Object> val,
+                                           FromV8ValueState* state,
+                                           v8::Isolate* isolate) const {
   ScopedUniquenessGuard uniqueness_guard(state, val);
   if (!uniqueness_guard.is_valid())
-    return std::make_unique<base::Value>();
+    return base::Value();
 
   std::unique_ptr<v8::Context::Scope> scope;
   // If val was created in a different context than our current one, change to
@@ -444,16 +439,15 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
       val->CreationContext() != isolate->GetCurrentContext())
     scope = std::make_unique<v8::Context::Scope>(val->CreationContext());
 
-  auto result = std::make_unique<base::DictionaryValue>();
+  auto context = isolate->GetCurrentContext();
+  base::Value result(base::Value::Type::DICTIONARY);
   v8::Local<v8::Array> property_names;
-  if (!val->GetOwnPropertyNames(isolate->GetCurrentContext())
-           .ToLocal(&property_names)) {
-    return std::move(result);
+  if (!val->GetOwnPropertyNames(context).ToLocal(&property_names)) {
+    return result;
   }
 
   for (uint32_t i = 0; i < property_names->Length(); ++i) {
-    v8::Local<v8::Value> key =
-        property_names->Get(isolate->GetCurrentContext(), i).ToLocalChecked();
+    v8::Local<v8::Value> key = property_names->Get(context, i).ToLocalChecked();
 
     // Extend this test to cover more types as necessary and if sensible.
     if (!key->IsString() && !key->IsNumber()) {
@@ -463,19 +457,23 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
       continue;
     }
 
-    v8::String::Utf8Value name_utf8(isolate, key);
+    std::string name;
+    if (key->IsString()) {
+      name = V8StringToUTF8(isolate, key.As<v8::String>());
+    } else {
+      v8::String::Utf8Value name_utf8(isolate, key);
+      name.assign(*name_utf8, name_utf8.length());
+    }
 
     v8::TryCatch try_catch(isolate);
     v8::Local<v8::Value> child_v8;
-    v8::MaybeLocal<v8::Value> maybe_child =
-        val->Get(isolate->GetCurrentContext(), key);
+    v8::MaybeLocal<v8::Value> maybe_child = val->Get(context, key);
     if (try_catch.HasCaught() || !maybe_child.ToLocal(&child_v8)) {
-      LOG(ERROR) << "Getter for property " << *name_utf8
-                 << " threw an exception.";
+      LOG(ERROR) << "Getter for property " << name << " threw an exception.";
       child_v8 = v8::Null(isolate);
     }
 
-    std::unique_ptr<base::Value> child =
+    base::Optional<base::Value> child =
         FromV8ValueImpl(state, child_v8, isolate);
     if (!child)
       // JSON.stringify skips properties whose values don't serialize, for
@@ -505,11 +503,10 @@ std::unique_ptr<base::Value> V8ValueConverter::FromV8Object(
     if (strip_null_from_objects_ && child->is_none())
       continue;
 
-    result->SetWithoutPathExpansion(std::string(*name_utf8, name_utf8.length()),
-                                    std::move(child));
+    result.SetKey(std::move(name), std::move(*child));
   }
 
-  return std::move(result);
+  return result;
 }
 
 }  // namespace electron
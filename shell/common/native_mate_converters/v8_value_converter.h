@@ -9,6 +9,7 @@
 
 #include "base/compiler_specific.h"
 #include "base/macros.h"
+#include "base/optional.h"
 #include "v8/include/v8.h"
 
 namespace base {
@@ -46,18 +47,20 @@ class V8ValueConverter {
   v8::Local<v8::Value> ToArrayBuffer(v8::Isolate* isolate,
                                      const base::Value* value) const;
 
-  std::unique_ptr<base::Value> FromV8ValueImpl(FromV8ValueState* state,
-                                               v8::Local<v8::Value> value,
-                                               v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromV8Array(v8::Local<v8::Array> array,
-                                           FromV8ValueState* state,
-                                           v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromNodeBuffer(v8::Local<v8::Value> value,
-                                              FromV8ValueState* state,
+  // The FromV8* methods return base::nullopt for values that JSON.stringify
+  // would skip, e.g. undefined and functions.
+  base::Optional<base::Value> FromV8ValueImpl(FromV8ValueState* state,
+                                              v8::Local<v8::Value> value,
                                               v8::Isolate* isolate) const;
-  std::unique_ptr<base::Value> FromV8Object(v8::Local<v8::Object> object,
-                                            FromV8ValueState* state,
-                                            v8::Isolate* isolate) const;
+  base::Value FromV8Array(v8::Local<v8::Array> array,
+                          FromV8ValueState* state,
+                          v8::Isolate* isolate) const;
+  base::Value FromNodeBuffer(v8::Local<v8::Value> value,
+                             FromV8ValueState* state,
+                             v8::Isolate* isolate) const;
+  base::Value FromV8Object(v8::Local<v8::Object> object,
+                           FromV8ValueState* state,
+                           v8::Isolate* isolate) const;
 
   // If true, we will convert RegExp JavaScript objects to string.
   bool reg_exp_allowed_ = false;
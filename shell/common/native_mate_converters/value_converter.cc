@@ -5,6 +5,7 @@
 #include "shell/common/native_mate_converters/value_converter.h"
 
 #include <memory>
+#include <utility>
 
 #include "base/values.h"
 #include "shell/common/native_mate_converters/v8_value_converter.h"
@@ -39,7 +40,7 @@ bool Converter<base::Value>::FromV8(v8::Isolate* isolate,
   std::unique_ptr<base::Value> value(
       converter.FromV8Value(val, isolate->GetCurrentContext()));
   if (value) {
-    *out = value->Clone();
+    *out = std::move(*value);
     return true;
   } else {
     return false;
@@ -58,7 +59,7 @@ bool Converter<base::ListValue>::FromV8(v8::Isolate* isolate,
   electron::V8ValueConverter converter;
   std::unique_ptr<base::Value> value(
       converter.FromV8Value(val, isolate->GetCurrentContext()));
-  if (value->is_list()) {
+  if (value && value->is_list()) {
     out->Swap(static_cast<base::ListValue*>(value.get()));
     return true;
   } else {
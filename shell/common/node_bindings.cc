@@ -16,6 +16,7 @@
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
@@ -28,6 +29,7 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/mac/main_application_bundle.h"
+#include "shell/common/node_code_cache.h"
 #include "shell/common/node_includes.h"
 
 #define ELECTRON_BUILTIN_MODULES(V)  \
@@ -46,6 +48,7 @@
   V(atom_browser_power_monitor)      \
   V(atom_browser_power_save_blocker) \
   V(atom_browser_protocol)           \
+  V(atom_browser_remote_objects)     \
   V(atom_browser_session)            \
   V(atom_browser_system_preferences) \
   V(atom_browser_top_level_window)   \
@@ -212,6 +215,10 @@ void NodeBindings::Initialize() {
   // Explicitly register electron's builtin modules.
   RegisterBuiltinModules();
 
+  // Seed node's code cache so the js2c bundles are not compiled from source
+  // in every environment.
+  RegisterEmbedderCodeCache();
+
   // pass non-null program name to argv so it doesn't crash
   // trying to index into a nullptr
   int argc = 1;
@@ -291,6 +298,7 @@ node::Environment* NodeBindings::CreateEnvironment(
     v8::Handle<v8::Context> context,
     node::MultiIsolatePlatform* platform,
     bool bootstrap_env) {
+  TRACE_EVENT0("electron", "NodeBindings::CreateEnvironment");
 #if defined(OS_WIN)
   auto& atom_args = AtomCommandLine::argv();
   std::vector<std::string> args(atom_args.size());
@@ -363,7 +371,16 @@ node::Environment* NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  TRACE_EVENT0("electron", "NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env);
+  if (HasEmbedderCodeCache()) {
+    std::vector<std::string> rejected = GetRejectedEmbedderCodeCache();
+    if (!rejected.empty()) {
+      TRACE_EVENT_INSTANT1("electron", "EmbedderCodeCacheRejected",
+                           TRACE_EVENT_SCOPE_PROCESS, "ids",
+                           base::JoinString(rejected, ","));
+    }
+  }
   gin_helper::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
 
@@ -0,0 +1,31 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef SHELL_COMMON_NODE_CODE_CACHE_H_
+#define SHELL_COMMON_NODE_CODE_CACHE_H_
+
+#include <string>
+#include <vector>
+
+namespace electron {
+
+// Hands the V8 code cache generated at build time for Electron's js2c
+// bundles to node's NativeModuleLoader, so that environments created later
+// deserialize those bundles instead of compiling them from source.
+//
+// The definition lives in the generated electron_code_cache.cc when the
+// |enable_code_cache| build arg is set, otherwise in
+// node_code_cache_stub.cc where it is a no-op.
+void RegisterEmbedderCodeCache();
+
+// Whether the binary was built with an embedded code cache.
+bool HasEmbedderCodeCache();
+
+// Ids of the bundles whose embedded cache V8 rejected, which happens when the
+// cache was generated under different V8 flags than the running process.
+std::vector<std::string> GetRejectedEmbedderCodeCache();
+
+}  // namespace electron
+
+#endif  // SHELL_COMMON_NODE_CODE_CACHE_H_
@@ -0,0 +1,22 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/node_code_cache.h"
+
+// Used when Electron is built without enable_code_cache, in which case the
+// js2c bundles are always compiled from source.
+
+namespace electron {
+
+void RegisterEmbedderCodeCache() {}
+
+bool HasEmbedderCodeCache() {
+  return false;
+}
+
+std::vector<std::string> GetRejectedEmbedderCodeCache() {
+  return {};
+}
+
+}  // namespace electron
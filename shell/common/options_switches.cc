@@ -265,6 +265,9 @@ const char kAuthNegotiateDelegateWhitelist[] =
 // If set, include the port in generated Kerberos SPNs.
 const char kEnableAuthNegotiatePort[] = "enable-auth-negotiate-port";
 
+// Exposes a method to turn the SIMD image kernels off, for benchmarks.
+const char kImageOpsSIMDToggle[] = "image-ops-simd-toggle";
+
 }  // namespace switches
 
 }  // namespace electron
@@ -129,6 +129,8 @@ extern const char kAuthServerWhitelist[];
 extern const char kAuthNegotiateDelegateWhitelist[];
 extern const char kEnableAuthNegotiatePort[];
 
+extern const char kImageOpsSIMDToggle[];
+
 }  // namespace switches
 
 }  // namespace electron
@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/files/file_util.h"
 #include "base/strings/pattern.h"
@@ -135,21 +137,31 @@ bool AddImageSkiaRepFromPath(gfx::ImageSkia* image,
   return AddImageSkiaRepFromBuffer(image, data, size, 0, 0, scale_factor);
 }
 
-bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
-                                   const base::FilePath& path) {
-  bool succeed = false;
+std::vector<std::pair<base::FilePath, float>> GetScaledImagePaths(
+    const base::FilePath& path) {
+  std::vector<std::pair<base::FilePath, float>> paths;
   std::string filename(path.BaseName().RemoveExtension().AsUTF8Unsafe());
-  if (base::MatchPattern(filename, "*@*x"))
+  if (base::MatchPattern(filename, "*@*x")) {
     // Don't search for other representations if the DPI has been specified.
-    return AddImageSkiaRepFromPath(image, path, GetScaleFactorFromPath(path));
-  else
-    succeed |= AddImageSkiaRepFromPath(image, path, 1.0f);
+    paths.emplace_back(path, GetScaleFactorFromPath(path));
+    return paths;
+  }
 
+  paths.emplace_back(path, 1.0f);
   for (const ScaleFactorPair& pair : kScaleFactorPairs)
-    succeed |= AddImageSkiaRepFromPath(
-        image, path.InsertBeforeExtensionASCII(pair.name), pair.scale);
+    paths.emplace_back(path.InsertBeforeExtensionASCII(pair.name), pair.scale);
+  return paths;
+}
+
+bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
+                                   const base::FilePath& path) {
+  bool succeed = false;
+  for (const auto& scaled_path : GetScaledImagePaths(path))
+    succeed |=
+        AddImageSkiaRepFromPath(image, scaled_path.first, scaled_path.second);
   return succeed;
 }
+
 #if defined(OS_WIN)
 bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
   // Convert the icon from the Windows specific HICON to gfx::ImageSkia.
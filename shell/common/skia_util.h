@@ -6,6 +6,8 @@
 #define SHELL_COMMON_SKIA_UTIL_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "ui/gfx/image/image_skia.h"
 
@@ -13,9 +15,18 @@ namespace electron {
 
 namespace util {
 
+// Returns the files PopulateImageSkiaRepsFromPath reads for |path|, with the
+// scale factor of each.
+std::vector<std::pair<base::FilePath, float>> GetScaledImagePaths(
+    const base::FilePath& path);
+
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
                                    const base::FilePath& path);
 
+bool AddImageSkiaRepFromPath(gfx::ImageSkia* image,
+                             const base::FilePath& path,
+                             double scale_factor);
+
 bool AddImageSkiaRepFromBuffer(gfx::ImageSkia* image,
                                const unsigned char* data,
                                size_t size,
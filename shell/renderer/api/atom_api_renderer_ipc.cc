@@ -5,6 +5,7 @@
 #include <string>
 
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "electron/shell/common/api/api.mojom.h"
@@ -14,6 +15,7 @@
 #include "native_mate/object_template_builder.h"
 #include "native_mate/wrappable.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/common/ipc_stats.h"
 #include "shell/common/native_mate_converters/value_converter.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
@@ -59,28 +61,40 @@ class IPCRenderer : public mate::Wrappable<IPCRenderer> {
         .SetMethod("sendSync", &IPCRenderer::SendSync)
         .SetMethod("sendTo", &IPCRenderer::SendTo)
         .SetMethod("sendToHost", &IPCRenderer::SendToHost)
-        .SetMethod("invoke", &IPCRenderer::Invoke);
+        .SetMethod("invoke", &IPCRenderer::Invoke)
+        .SetMethod("getStats", &IPCRenderer::GetStats)
+        .SetMethod("resetStats", &IPCRenderer::ResetStats);
   }
 
   static mate::Handle<IPCRenderer> Create(v8::Isolate* isolate) {
     return mate::CreateHandle(isolate, new IPCRenderer(isolate));
   }
 
-  void Send(bool internal,
+  void Send(mate::Arguments* args,
+            bool internal,
             const std::string& channel,
-            const base::ListValue& arguments) {
-    electron_browser_ptr_->get()->Message(internal, channel, arguments.Clone());
+            v8::Local<v8::Value> value) {
+    TRACE_EVENT1("electron", "IPCRenderer::Send", "channel", channel);
+    base::ListValue arguments;
+    if (!ConvertArguments(args, channel, value, &arguments))
+      return;
+    electron_browser_ptr_->get()->Message(internal, channel, arguments.Clone(),
+                                          base::TimeTicks::Now());
   }
 
   v8::Local<v8::Promise> Invoke(mate::Arguments* args,
                                 bool internal,
                                 const std::string& channel,
-                                const base::Value& arguments) {
+                                v8::Local<v8::Value> value) {
+    TRACE_EVENT1("electron", "IPCRenderer::Invoke", "channel", channel);
+    base::ListValue arguments;
+    if (!ConvertArguments(args, channel, value, &arguments))
+      return v8::Local<v8::Promise>();
+
     electron::util::Promise<base::Value> p(args->isolate());
     auto handle = p.GetHandle();
-
     electron_browser_ptr_->get()->Invoke(
-        internal, channel, arguments.Clone(),
+        internal, channel, arguments.Clone(), base::TimeTicks::Now(),
         base::BindOnce([](electron::util::Promise<base::Value> p,
                           base::Value result) { p.Resolve(result); },
                        std::move(p)));
@@ -88,23 +102,41 @@ class IPCRenderer : public mate::Wrappable<IPCRenderer> {
     return handle;
   }
 
-  void SendTo(bool internal,
+  void SendTo(mate::Arguments* args,
+              bool internal,
               bool send_to_all,
               int32_t web_contents_id,
               const std::string& channel,
-              const base::ListValue& arguments) {
-    electron_browser_ptr_->get()->MessageTo(
-        internal, send_to_all, web_contents_id, channel, arguments.Clone());
+              v8::Local<v8::Value> value) {
+    base::ListValue arguments;
+    if (!ConvertArguments(args, channel, value, &arguments))
+      return;
+    electron_browser_ptr_->get()->MessageTo(internal, send_to_all,
+                                            web_contents_id, channel,
+                                            arguments.Clone(),
+                                            base::TimeTicks::Now());
+  }
+
+  void SendToHost(mate::Arguments* args,
+                  const std::string& channel,
+                  v8::Local<v8::Value> value) {
+    base::ListValue arguments;
+    if (!ConvertArguments(args, channel, value, &arguments))
+      return;
+    electron_browser_ptr_->get()->MessageHost(channel, arguments.Clone(),
+                                              base::TimeTicks::Now());
   }
 
-  void SendToHost(const std::string& channel,
-                  const base::ListValue& arguments) {
-    electron_browser_ptr_->get()->MessageHost(channel, arguments.Clone());
+  base::Value GetStats() {
+    return electron::IpcStats::GetForRendererProcess()->ToValue();
   }
 
-  base::Value SendSync(bool internal,
+  void ResetStats() { electron::IpcStats::GetForRendererProcess()->Reset(); }
+
+  base::Value SendSync(mate::Arguments* args,
+                       bool internal,
                        const std::string& channel,
-                       const base::ListValue& arguments) {
+                       v8::Local<v8::Value> value) {
     // We aren't using a true synchronous mojo call here. We're calling an
     // asynchronous method and blocking on the result. The reason we're doing
     // this is a little complicated, so buckle up.
@@ -151,6 +183,10 @@ class IPCRenderer : public mate::Wrappable<IPCRenderer> {
     //
     // Phew. If you got this far, here's a gold star: ⭐️
 
+    TRACE_EVENT1("electron", "IPCRenderer::SendSync", "channel", channel);
+    base::ListValue arguments;
+    if (!ConvertArguments(args, channel, value, &arguments))
+      return base::Value();
     base::Value result;
 
     // A task is posted to a worker thread to execute the request so that
@@ -164,19 +200,37 @@ class IPCRenderer : public mate::Wrappable<IPCRenderer> {
                                   base::Unretained(this),
                                   base::Unretained(&response_received_event),
                                   base::Unretained(&result), internal, channel,
-                                  arguments.Clone()));
+                                  arguments.Clone(), base::TimeTicks::Now()));
     response_received_event.Wait();
     return result;
   }
 
  private:
+  // Converts the arguments of a message, failing like the bindings do, and
+  // records the message in the IPC stats along with the conversion time.
+  static bool ConvertArguments(mate::Arguments* args,
+                               const std::string& channel,
+                               v8::Local<v8::Value> value,
+                               base::ListValue* arguments) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    if (!mate::ConvertFromV8(args->isolate(), value, arguments)) {
+      args->ThrowError();
+      return false;
+    }
+    electron::IpcStats::GetForRendererProcess()->RecordSent(
+        channel, electron::IpcStats::EstimateSize(*arguments),
+        base::TimeTicks::Now() - start);
+    return true;
+  }
+
   void SendMessageSyncOnWorkerThread(base::WaitableEvent* event,
                                      base::Value* result,
                                      bool internal,
                                      const std::string& channel,
-                                     base::Value arguments) {
+                                     base::Value arguments,
+                                     base::TimeTicks sent_at) {
     electron_browser_ptr_->get()->MessageSync(
-        internal, channel, std::move(arguments),
+        internal, channel, std::move(arguments), sent_at,
         base::BindOnce(&IPCRenderer::ReturnSyncResponseToMainThread,
                        base::Unretained(event), base::Unretained(result)));
   }
@@ -19,6 +19,7 @@
 #include "shell/common/native_mate_converters/string16_converter.h"
 #include "shell/common/native_mate_converters/value_converter.h"
 #include "shell/common/node_bindings.h"
+#include "shell/common/node_code_cache.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/renderer/atom_render_frame_observer.h"
@@ -122,6 +123,7 @@ void InvokeHiddenCallback(v8::Handle<v8::Context> context,
 AtomSandboxedRendererClient::AtomSandboxedRendererClient() {
   // Explicitly register electron's builtin modules.
   NodeBindings::RegisterBuiltinModules();
+  RegisterEmbedderCodeCache();
   metrics_ = base::ProcessMetrics::CreateCurrentProcessMetrics();
 }
 
@@ -11,10 +11,12 @@
 #include "base/environment.h"
 #include "base/macros.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 #include "mojo/public/cpp/system/platform_handle.h"
 #include "shell/common/atom_constants.h"
 #include "shell/common/gin_converters/value_converter_gin_adapter.h"
 #include "shell/common/heap_snapshot.h"
+#include "shell/common/ipc_stats.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/renderer/atom_render_frame_observer.h"
@@ -73,8 +75,10 @@ void InvokeIpcCallback(v8::Local<v8::Context> context,
 void EmitIPCEvent(v8::Local<v8::Context> context,
                   bool internal,
                   const std::string& channel,
-                  const std::vector<base::Value>& args,
-                  int32_t sender_id) {
+                  const base::Value& args,
+                  int32_t sender_id,
+                  base::TimeTicks sent_at) {
+  base::TimeTicks received_at = base::TimeTicks::Now();
   auto* isolate = context->GetIsolate();
 
   v8::HandleScope handle_scope(isolate);
@@ -84,9 +88,15 @@ void EmitIPCEvent(v8::Local<v8::Context> context,
 
   std::vector<v8::Local<v8::Value>> argv = {
       gin::ConvertToV8(isolate, internal), gin::ConvertToV8(isolate, channel),
-      gin::ConvertToV8(isolate, args), gin::ConvertToV8(isolate, sender_id)};
+      gin::ConvertToV8(isolate, args.GetList()),
+      gin::ConvertToV8(isolate, sender_id)};
+  base::TimeTicks converted_at = base::TimeTicks::Now();
 
   InvokeIpcCallback(context, "onMessage", argv);
+
+  IpcStats::GetForRendererProcess()->RecordReceived(
+      channel, IpcStats::EstimateSize(args), converted_at - received_at,
+      received_at - sent_at, base::TimeTicks::Now() - converted_at);
 }
 
 }  // namespace
@@ -129,7 +139,10 @@ void ElectronApiServiceImpl::Message(bool internal,
                                      bool send_to_all,
                                      const std::string& channel,
                                      base::Value arguments,
-                                     int32_t sender_id) {
+                                     int32_t sender_id,
+                                     base::TimeTicks sent_at) {
+  TRACE_EVENT1("electron", "ElectronApiServiceImpl::Message", "channel",
+               channel);
   // Don't handle browser messages before document element is created.
   //
   // Note: It is probably better to save the message and then replay it after
@@ -158,7 +171,7 @@ void ElectronApiServiceImpl::Message(bool internal,
 
   v8::Local<v8::Context> context = renderer_client_->GetContext(frame, isolate);
 
-  EmitIPCEvent(context, internal, channel, arguments.GetList(), sender_id);
+  EmitIPCEvent(context, internal, channel, arguments, sender_id, sent_at);
 
   // Also send the message to all sub-frames.
   // TODO(MarshallOfSound): Completely move this logic to the main process
@@ -168,8 +181,8 @@ void ElectronApiServiceImpl::Message(bool internal,
       if (child->IsWebLocalFrame()) {
         v8::Local<v8::Context> child_context =
             renderer_client_->GetContext(child->ToWebLocalFrame(), isolate);
-        EmitIPCEvent(child_context, internal, channel, arguments.GetList(),
-                     sender_id);
+        EmitIPCEvent(child_context, internal, channel, arguments, sender_id,
+                     sent_at);
       }
   }
 }
@@ -184,6 +197,7 @@ void ElectronApiServiceImpl::UpdateCrashpadPipeName(
 
 void ElectronApiServiceImpl::TakeHeapSnapshot(
     mojo::ScopedHandle file,
+    bool gzip,
     TakeHeapSnapshotCallback callback) {
   base::ThreadRestrictions::ScopedAllowIO allow_io;
 
@@ -191,15 +205,22 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   if (mojo::UnwrapPlatformFile(std::move(file), &platform_file) !=
       MOJO_RESULT_OK) {
     LOG(ERROR) << "Unable to get the file handle from mojo.";
-    std::move(callback).Run(false);
+    std::move(callback).Run(false, mojom::HeapSnapshotStats::New());
     return;
   }
   base::File base_file(platform_file);
 
-  bool success =
-      electron::TakeHeapSnapshot(blink::MainThreadIsolate(), &base_file);
-
-  std::move(callback).Run(success);
+  HeapSnapshotOptions options;
+  options.gzip = gzip;
+  HeapSnapshotStats stats;
+  bool success = electron::TakeHeapSnapshot(blink::MainThreadIsolate(),
+                                            &base_file, options, &stats);
+
+  std::move(callback).Run(
+      success, mojom::HeapSnapshotStats::New(
+                   stats.uncompressed_bytes, stats.bytes_written,
+                   stats.snapshot_time, stats.serialization_time,
+                   stats.stall_time));
 }
 
 }  // namespace electron
@@ -29,9 +29,11 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
                bool send_to_all,
                const std::string& channel,
                base::Value arguments,
-               int32_t sender_id) override;
+               int32_t sender_id,
+               base::TimeTicks sent_at) override;
   void UpdateCrashpadPipeName(const std::string& pipe_name) override;
   void TakeHeapSnapshot(mojo::ScopedHandle file,
+                        bool gzip,
                         TakeHeapSnapshotCallback callback) override;
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
@@ -9,6 +9,7 @@
 #include "shell/common/api/electron_bindings.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
+#include "shell/common/gin_helper/key_cache.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
 
@@ -70,6 +71,7 @@ void WebWorkerObserver::ContextWillDestroy(v8::Local<v8::Context> context) {
   node::Environment* env = node::Environment::GetCurrent(context);
   if (env)
     gin_helper::EmitEvent(env->isolate(), env->process_object(), "exit");
+  gin_helper::ClearKeyCache(context->GetIsolate());
 
   delete this;
 }
@@ -1015,6 +1015,51 @@ describe('app module', () => {
     })
   })
 
+  describe('startMetricsSampling() API', () => {
+    afterEach(() => {
+      app.stopMetricsSampling()
+    })
+
+    it('validates its options', () => {
+      expect(() => app.startMetricsSampling({ interval: 10 })).to.throw(/interval/)
+      expect(() => app.startMetricsSampling({ bufferSize: 0 })).to.throw(/bufferSize/)
+    })
+
+    it('rejects getMetricsSamples() when not sampling', async () => {
+      await expect(app.getMetricsSamples()).to.eventually.be.rejectedWith(/not been started/)
+    })
+
+    it('collects samples of the browser process', async () => {
+      app.startMetricsSampling({ interval: 100, bufferSize: 5 })
+      await new Promise(resolve => setTimeout(resolve, 350))
+
+      const { fields, samples } = await app.getMetricsSamples()
+      expect(fields).to.include.members(['pid', 'timestamp', 'percentCPUUsage', 'workingSetSize'])
+      expect(samples).to.be.an.instanceOf(Float64Array)
+      expect(samples.length % fields.length).to.equal(0)
+
+      const rows = []
+      for (let i = 0; i < samples.length; i += fields.length) {
+        rows.push(samples.subarray(i, i + fields.length))
+      }
+      const browserRows = rows.filter(row => row[fields.indexOf('pid')] === process.pid)
+      expect(browserRows).to.have.lengthOf.at.least(1)
+      for (const row of browserRows) {
+        expect(row[fields.indexOf('timestamp')]).to.be.greaterThan(0)
+        expect(row[fields.indexOf('workingSetSize')]).to.be.greaterThan(0)
+      }
+
+      // Samples are only returned once.
+      const lastTimestamp = Math.max(...browserRows.map(row => row[fields.indexOf('timestamp')]))
+      const again = await app.getMetricsSamples()
+      for (let i = 0; i < again.samples.length; i += fields.length) {
+        if (again.samples[i + fields.indexOf('pid')] === process.pid) {
+          expect(again.samples[i + fields.indexOf('timestamp')]).to.be.greaterThan(lastTimestamp)
+        }
+      }
+    })
+  })
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus()
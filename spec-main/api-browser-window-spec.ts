@@ -2748,6 +2748,35 @@ describe('BrowserWindow module', () => {
         w.webContents.beginFrameSubscription(true, true as any)
       }).to.throw('Error processing argument at index 1, conversion failure from true')
     })
+
+    it('subscribes to scaled I420 frames', (done) => {
+      const w = new BrowserWindow({show: false})
+      const [contentWidth, contentHeight] = w.getContentSize()
+      w.webContents.on('did-finish-load', () => {
+        w.webContents.beginFrameSubscription({ pixelFormat: 'i420', scaleFactor: 0.5, maxFrameRate: 10 }, (frame: any) => {
+          if (frame.size.width === 0) return
+          w.webContents.endFrameSubscription()
+          const { width, height } = frame.size
+          expect(frame.format).to.equal('i420')
+          expect(width).to.be.at.most(Math.ceil(contentWidth / 2))
+          expect(height).to.be.at.most(Math.ceil(contentHeight / 2))
+          const chroma = Math.ceil(width / 2) * Math.ceil(height / 2)
+          expect(frame.data).to.be.an.instanceOf(Buffer).with.lengthOf(width * height + 2 * chroma)
+          done()
+        })
+      })
+      w.loadFile(path.join(fixtures, 'api', 'frame-subscriber.html'))
+    })
+
+    it('throws error when options are invalid', () => {
+      const w = new BrowserWindow({show: false})
+      expect(() => {
+        w.webContents.beginFrameSubscription({ pixelFormat: 'rgb565' } as any, () => {})
+      }).to.throw('Invalid frame subscription options')
+      expect(() => {
+        w.webContents.beginFrameSubscription({ scaleFactor: 2 }, () => {})
+      }).to.throw('Invalid frame subscription options')
+    })
   })
 
   describe('savePage method', () => {
@@ -3943,6 +3972,148 @@ describe('BrowserWindow module', () => {
       })
     })
 
+    describe('window.webContents.getPaintStats()', () => {
+      it('counts the painted frames and the bytes copied for them', (done) => {
+        w.webContents.once('paint', function (event, rect, data) {
+          const stats = w.webContents.getPaintStats()
+          expect(stats.frames).to.be.at.least(1)
+          expect(stats.bytesCopied).to.be.above(0)
+          expect(stats.bytesAllocated).to.be.at.least(data.toBitmap().length)
+          done()
+        })
+        w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+      })
+
+      it('reuses its bitmaps and copies only the damaged area of each frame', async () => {
+        const v8Util = process.electronBinding('v8_util')
+        let frameBytes = 0
+        let painted = 0
+        const waitForPaints = (count: number) => new Promise((resolve) => {
+          const onPaint = (event: Electron.Event, rect: Electron.Rectangle, image: Electron.NativeImage) => {
+            frameBytes = image.getSize().width * image.getSize().height * 4
+            // Collects the images of the previous frames, which pin their
+            // bitmaps until then.
+            v8Util.requestGarbageCollectionForTesting()
+            if (++painted % count === 0) {
+              w.webContents.removeListener('paint', onPaint)
+              resolve()
+            }
+          }
+          w.webContents.on('paint', onPaint)
+        })
+        await w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        // The first frames are written in full.
+        await waitForPaints(5)
+        const before = w.webContents.getPaintStats()
+        await waitForPaints(5)
+        const after = w.webContents.getPaintStats()
+        expect(after.bytesAllocated).to.equal(before.bytesAllocated)
+        const bytesPerFrame = (after.bytesCopied - before.bytesCopied) / (after.frames - before.frames)
+        expect(bytesPerFrame).to.be.below(frameBytes)
+      })
+
+      it('returns zeros for regular windows', () => {
+        const c = new BrowserWindow({ show: false })
+        expect(c.webContents.getPaintStats()).to.deep.equal({ frames: 0, bytesCopied: 0, bytesAllocated: 0 })
+        c.destroy()
+      })
+    })
+
+    describe('window.webContents.startVideoEncoding()', () => {
+      afterEach(async () => {
+        if (w.webContents.isVideoEncoding()) await w.webContents.stopVideoEncoding()
+      })
+
+      it('emits encoded frames starting with a key frame', async () => {
+        await w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        w.webContents.startVideoEncoding({ codec: 'vp8' })
+        expect(w.webContents.isVideoEncoding()).to.be.true('isVideoEncoding')
+        const [, packet, details] = await emittedOnce(w.webContents, 'video-packet')
+        expect(packet).to.be.an.instanceOf(Buffer)
+        expect(packet.length).to.be.above(0)
+        expect(details.keyFrame).to.be.true('keyFrame')
+        expect(details.size.width).to.be.above(0)
+        const stats = await w.webContents.stopVideoEncoding()
+        expect(stats.frames).to.be.at.least(1)
+        expect(stats.bytes).to.be.at.least(packet.length)
+        expect(w.webContents.isVideoEncoding()).to.be.false('isVideoEncoding')
+      })
+
+      it('writes a WebM file', async () => {
+        const file = path.join(os.tmpdir(), `osr-video-${process.pid}.webm`)
+        await w.loadFile(path.join(fixtures, 'api', 'offscreen-rendering.html'))
+        w.webContents.startVideoEncoding({ codec: 'vp9', path: file })
+        await emittedOnce(w.webContents, 'paint')
+        await new Promise(resolve => setTimeout(resolve, 200))
+        await w.webContents.stopVideoEncoding()
+        try {
+          // EBML header.
+          expect(fs.readFileSync(file).readUInt32BE(0)).to.equal(0x1A45DFA3)
+        } finally {
+          fs.unlinkSync(file)
+        }
+      })
+
+      it('rejects invalid options', () => {
+        expect(() => w.webContents.startVideoEncoding({ codec: 'h264' } as any)).to.throw(/Invalid codec/)
+      })
+
+      it('is not supported for regular windows', () => {
+        const c = new BrowserWindow({ show: false })
+        expect(() => c.webContents.startVideoEncoding()).to.throw(/offscreen/)
+        c.destroy()
+      })
+    })
+
+    describe('begin frames', () => {
+      // Counts the animation frames the page gets in |duration| ms, which is
+      // bounded by the begin frames the view issues to the renderer.
+      const countAnimationFrames = (contents: WebContents, duration: number, paint: boolean): Promise<number> => contents.executeJavaScript(`new Promise((resolve) => {
+        let frames = 0
+        let start
+        const tick = (now) => {
+          if (start === undefined) start = now
+          if (now - start >= ${duration}) return resolve(frames)
+          frames++
+          if (${paint}) document.body.style.backgroundColor = frames % 2 ? 'red' : 'blue'
+          requestAnimationFrame(tick)
+        }
+        requestAnimationFrame(tick)
+      })`)
+
+      it('are issued less often while nothing is damaged and recover once the page paints', async () => {
+        await w.loadURL('about:blank')
+        // Gives the interval time to back off.
+        await countAnimationFrames(w.webContents, 1000, false)
+        const idle = await countAnimationFrames(w.webContents, 1000, false)
+        expect(idle).to.be.below(30)
+        const painting = await countAnimationFrames(w.webContents, 1000, true)
+        expect(painting).to.be.above(idle * 2)
+      })
+
+      it('follow the frame rate of each view sharing the timer', async () => {
+        const slow = new BrowserWindow({
+          width: 100,
+          height: 100,
+          show: false,
+          webPreferences: {
+            backgroundThrottling: false,
+            offscreen: true
+          }
+        })
+        await Promise.all([w.loadURL('about:blank'), slow.loadURL('about:blank')])
+        w.webContents.frameRate = 60
+        slow.webContents.frameRate = 10
+        const [fast, slowFrames] = await Promise.all([
+          countAnimationFrames(w.webContents, 1000, true),
+          countAnimationFrames(slow.webContents, 1000, true)
+        ])
+        expect(slowFrames).to.be.above(0)
+        expect(slowFrames).to.be.at.most(15)
+        expect(fast).to.be.above(slowFrames * 2)
+      })
+    })
+
     describe('window.webContents.FrameRate', () => {
       it('has default frame rate', (done) => {
         w.webContents.once('paint', function (event, rect, data) {
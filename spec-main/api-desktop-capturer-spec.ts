@@ -96,6 +96,29 @@ ifdescribe(features.isDesktopCapturerEnabled() && !process.arch.includes('arm')
     expect(isEmpties.every(e => e === true)).to.be.true()
   })
 
+  it('streams sources before their thumbnails with onSource', async () => {
+    const { ids, updates } = await w.webContents.executeJavaScript(`
+      new Promise((resolve, reject) => {
+        const updates = []
+        require('electron').desktopCapturer.getSources({
+          types: ['screen'],
+          thumbnailSizes: [{ width: 16, height: 16 }, { width: 150, height: 150 }],
+          onSource: (source) => updates.push({ id: source.id, width: source.thumbnail.getSize().width })
+        }).then((sources) => resolve({ ids: sources.map(s => s.id), updates }), reject)
+      })
+    `)
+
+    expect(ids).to.be.an('array').that.is.not.empty()
+    for (const id of ids) {
+      const widths = updates.filter((update: any) => update.id === id).map((update: any) => update.width)
+      expect(widths).to.not.be.empty()
+      expect(widths[0]).to.equal(0)
+      for (const width of widths) {
+        expect(width).to.be.at.most(150)
+      }
+    }
+  })
+
   it('getMediaSourceId should match DesktopCapturerSource.id', async () => {
     const w = new BrowserWindow({ show: false, width: 100, height: 100 })
     const wShown = emittedOnce(w, 'show')
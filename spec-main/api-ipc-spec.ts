@@ -186,4 +186,66 @@ describe('ipc module', () => {
       expect(received).to.deep.equal([...received].sort((a, b) => a - b))
     })
   })
+
+  describe('stats', () => {
+    let w = (null as unknown as BrowserWindow);
+
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+      await w.loadURL('about:blank')
+    })
+    after(async () => {
+      w.destroy()
+    })
+
+    it('counts messages per channel in both processes', async () => {
+      w.webContents.resetIPCStats()
+      await w.webContents.executeJavaScript(`require('electron').ipcRenderer.resetStats()`)
+      const done = new Promise(resolve => ipcMain.once('stats-done', resolve))
+      w.webContents.executeJavaScript(`(() => {
+        const { ipcRenderer } = require('electron')
+        for (let i = 0; i < 3; i++) ipcRenderer.send('stats-test', 'x'.repeat(100))
+        ipcRenderer.send('stats-done')
+      })()`)
+      await done
+
+      const stats = w.webContents.getIPCStats()
+      expect(stats['stats-test'].messagesReceived).to.equal(3)
+      expect(stats['stats-test'].bytesReceived).to.be.greaterThan(300)
+      expect(stats['stats-test'].handlerTime).to.be.at.least(0)
+
+      const rendererStats = await w.webContents.executeJavaScript(`require('electron').ipcRenderer.getStats()`)
+      expect(rendererStats['stats-test'].messagesSent).to.equal(3)
+    })
+
+    it('times the conversion of sent messages', async () => {
+      const done = new Promise(resolve => ipcMain.once('stats-conversion', resolve))
+      w.webContents.executeJavaScript(`(() => {
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.resetStats()
+        const payload = Array.from({ length: 10000 }, (v, i) => ({ i, name: 'item ' + i }))
+        ipcRenderer.send('stats-conversion', payload)
+      })()`)
+      await done
+      const rendererStats = await w.webContents.executeJavaScript(`require('electron').ipcRenderer.getStats()`)
+      expect(rendererStats['stats-conversion'].conversionTime).to.be.greaterThan(0)
+
+      w.webContents.resetIPCStats()
+      w.webContents.send('stats-conversion', Array.from({ length: 10000 }, (v, i) => ({ i })))
+      expect(w.webContents.getIPCStats()['stats-conversion'].conversionTime).to.be.greaterThan(0)
+    })
+
+    it('counts messages sent to another webContents', async () => {
+      w.webContents.resetIPCStats()
+      await w.webContents.executeJavaScript(`new Promise((resolve) => {
+        const { ipcRenderer } = require('electron')
+        ipcRenderer.once('stats-send-to', () => resolve())
+        ipcRenderer.sendTo(${w.webContents.id}, 'stats-send-to', 'x'.repeat(100))
+      })`)
+      const stats = w.webContents.getIPCStats()
+      expect(stats['stats-send-to'].messagesReceived).to.equal(1)
+      expect(stats['stats-send-to'].bytesReceived).to.be.greaterThan(100)
+      expect(stats['stats-send-to'].messagesSent).to.equal(1)
+    })
+  })
 })
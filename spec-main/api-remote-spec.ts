@@ -94,6 +94,55 @@ describe('remote module', () => {
     })
   })
 
+  describe('remote objects registry', () => {
+    const registry = (process as any).electronBinding('remote_objects')
+    const owner = 'remote-objects-registry-spec'
+    afterEach(() => {
+      registry.clear(owner)
+    })
+
+    it('rejects handles of released objects', () => {
+      const first = {}
+      const id = registry.add(owner, first)
+      expect(registry.add(owner, first)).to.equal(id)
+      expect(registry.get(id)).to.equal(first)
+      registry.remove(owner, id, 2)
+      expect(registry.get(id)).to.be.undefined()
+
+      // Objects registered later never get the stale handle.
+      const objects = Array.from({ length: 100 }, () => ({}))
+      for (const object of objects) {
+        expect(registry.add(owner, object)).to.not.equal(id)
+      }
+      expect(registry.get(id)).to.be.undefined()
+    })
+
+    it('releases the objects collected by a garbage collection in one message', async () => {
+      const size = registry.getSize()
+      const messages: any[][] = []
+      const listener = (event: any, internal: boolean, channel: string, args: any[]) => {
+        if (internal && channel === 'ELECTRON_BROWSER_DEREFERENCE') messages.push(args)
+      }
+      w.webContents.on('-ipc-message' as any, listener)
+      try {
+        await remotely(`(() => {
+          const { remote } = require('electron')
+          for (let i = 0; i < 10; i++) remote.process.memoryUsage()
+          return 0
+        })()`)
+        expect(registry.getSize()).to.be.at.least(size + 10)
+        await remotely(`process.electronBinding('v8_util').requestGarbageCollectionForTesting()`)
+        while (registry.getSize() > size) {
+          await new Promise(resolve => setTimeout(resolve, 50))
+        }
+      } finally {
+        w.webContents.removeListener('-ipc-message' as any, listener)
+      }
+      expect(messages).to.have.lengthOf(1)
+      expect(messages[0][1]).to.have.lengthOf.at.least(10)
+    })
+  })
+
   describe('remote.getCurrentWebContents filtering', () => {
     it('can return custom value', async () => {
       w.webContents.once('remote-get-current-web-contents', (event) => {
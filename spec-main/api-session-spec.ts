@@ -220,6 +220,38 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.getPreferenceWriteStats()', () => {
+    let server: http.Server
+    let serverUrl: string
+    before(async () => {
+      server = http.createServer((req, res) => res.end('<title>zoom</title>'))
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve))
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}/`
+    })
+    after(() => server.close())
+    afterEach(closeAllWindows)
+
+    it('writes zoom level changes made together once', async () => {
+      const ses = session.fromPartition(`persist:zoom-stats-${Date.now()}`)
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+      await w.loadURL(serverUrl)
+      const before = ses.getPreferenceWriteStats()
+      for (let i = 1; i <= 5; i++) w.webContents.setZoomLevel(i / 10)
+      ses.flushStorageData()
+
+      let stats = ses.getPreferenceWriteStats()
+      expect(stats.changes - before.changes).to.be.at.least(5)
+      while (stats.commits === before.commits) {
+        await new Promise(resolve => setTimeout(resolve, 50))
+        stats = ses.getPreferenceWriteStats()
+      }
+      expect(stats.commits - before.commits).to.equal(1)
+      expect(stats.failedCommits).to.equal(0)
+      expect(stats.bytesWritten).to.be.greaterThan(before.bytesWritten)
+      expect(stats.maxCommitLatency).to.be.at.least(0)
+    })
+  })
+
   describe('will-download event', () => {
     afterEach(closeAllWindows)
     it('can cancel default download behavior', async () => {
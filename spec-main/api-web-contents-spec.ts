@@ -3,7 +3,7 @@ import { AddressInfo } from 'net'
 import * as chaiAsPromised from 'chai-as-promised'
 import * as path from 'path'
 import * as http from 'http'
-import { BrowserWindow, ipcMain, webContents, session, clipboard } from 'electron'
+import { app, BrowserWindow, ipcMain, nativeImage, webContents, session, clipboard } from 'electron'
 import { emittedOnce } from './events-helpers'
 import { closeAllWindows } from './window-helpers'
 import { ifdescribe, ifit } from './spec-helpers'
@@ -41,10 +41,35 @@ describe('webContents module', () => {
     })
   })
 
+  describe('event emission', () => {
+    afterEach(closeAllWindows)
+
+    it('calls an overridden emit even when nothing listens', async () => {
+      const w = new BrowserWindow({ show: false })
+      const emitted: string[] = []
+      const emit = w.webContents.emit
+      w.webContents.emit = function (name: string, ...args: any[]) {
+        emitted.push(name)
+        return emit.call(this, name, ...args)
+      }
+      await w.loadURL('about:blank')
+      expect(emitted).to.include('did-start-loading')
+      expect(emitted).to.include('did-stop-loading')
+    })
+
+    it('emits to listeners added after creation', async () => {
+      const w = new BrowserWindow({ show: false })
+      let count = 0
+      w.webContents.on('did-start-loading', () => { count++ })
+      await w.loadURL('about:blank')
+      expect(count).to.equal(1)
+    })
+  })
+
   describe('will-prevent-unload event', () => {
     afterEach(closeAllWindows)
     it('does not emit if beforeunload returns undefined', (done) => {
-      const w = new BrowserWindow({show: false})
+      const w = new BrowserWindow({ show: false })
       w.once('closed', () => done())
       w.webContents.once('will-prevent-unload', (e) => {
         expect.fail('should not have fired')
@@ -53,13 +78,13 @@ describe('webContents module', () => {
     })
 
     it('emits if beforeunload returns false', (done) => {
-      const w = new BrowserWindow({show: false})
+      const w = new BrowserWindow({ show: false })
       w.webContents.once('will-prevent-unload', () => done())
       w.loadFile(path.join(fixturesPath, 'api', 'close-beforeunload-false.html'))
     })
 
     it('supports calling preventDefault on will-prevent-unload events', (done) => {
-      const w = new BrowserWindow({show: false})
+      const w = new BrowserWindow({ show: false })
       w.webContents.once('will-prevent-unload', event => event.preventDefault())
       w.once('closed', () => done())
       w.loadFile(path.join(fixturesPath, 'api', 'close-beforeunload-false.html'))
@@ -123,6 +148,152 @@ describe('webContents module', () => {
     })
   })
 
+  describe('webContents.capturePageToBuffer()', () => {
+    afterEach(closeAllWindows)
+
+    const createShownWindow = async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 100, useContentSize: true })
+      w.loadURL('about:blank')
+      await emittedOnce(w, 'ready-to-show')
+      w.show()
+      return w
+    }
+
+    it('scales the captured page to the requested size', async () => {
+      const w = await createShownWindow()
+      const image = await w.webContents.capturePage(undefined, { width: 100 })
+      expect(image.getSize()).to.deep.equal({ width: 100, height: 50 })
+    })
+
+    it('encodes the captured page as PNG or JPEG', async () => {
+      const w = await createShownWindow()
+      const png = await w.webContents.capturePageToBuffer(undefined, { width: 50 })
+      expect(png.slice(1, 4).toString()).to.equal('PNG')
+      const jpeg = await w.webContents.capturePageToBuffer(undefined, { format: 'jpeg', quality: 50 })
+      expect(jpeg[0]).to.equal(0xFF)
+      expect(jpeg[1]).to.equal(0xD8)
+    })
+
+    it('rejects invalid options', async () => {
+      const w = await createShownWindow()
+      await expect(w.webContents.capturePageToBuffer(undefined, { format: 'gif' as any })).to.eventually.be.rejectedWith('Invalid capture options')
+    })
+
+    it('captures several pages at once', async () => {
+      const windows = await Promise.all([createShownWindow(), createShownWindow()])
+      const buffers = await webContents.capturePages(windows.map(w => w.webContents), { width: 20 })
+      expect(buffers).to.have.lengthOf(2)
+      for (const buffer of buffers) {
+        expect(buffer.slice(1, 4).toString()).to.equal('PNG')
+        // The options apply to the whole page rather than to a capture rect.
+        expect(nativeImage.createFromBuffer(buffer).getSize().width).to.equal(20)
+      }
+    })
+  })
+
+  ifdescribe(process.electronBinding('features').isPrintingEnabled())('webContents.printToPDF variants', () => {
+    let w: BrowserWindow
+    before(async () => {
+      w = new BrowserWindow({ show: false })
+      await w.loadURL('data:text/html,%3Ch1%3EHello%2C%20World!%3C%2Fh1%3E')
+    })
+    after(closeAllWindows)
+
+    it('prints to a writable ArrayBuffer', async () => {
+      const data = await w.webContents.printToPDFArrayBuffer({})
+      expect(data).to.be.an.instanceof(ArrayBuffer)
+      const bytes = new Uint8Array(data)
+      expect(Buffer.from(bytes.subarray(0, 5)).toString('latin1')).to.equal('%PDF-')
+      bytes[0] = 0
+      expect(bytes[0]).to.equal(0)
+    })
+
+    it('prints to a stream', async () => {
+      const stream = await w.webContents.printToPDFStream({})
+      const chunks: Buffer[] = []
+      stream.on('data', (chunk: Buffer) => chunks.push(chunk))
+      await emittedOnce(stream, 'end')
+      const data = Buffer.concat(chunks)
+      expect(data.toString('latin1', 0, 5)).to.equal('%PDF-')
+      // Chunks are writable, they never share the read-only PDF memory.
+      chunks[0][0] = 0
+      expect(chunks[0][0]).to.equal(0)
+    })
+  })
+
+  ifdescribe(process.electronBinding('features').isPrintingEnabled())('webContents.createPDFRenderPool()', () => {
+    let pool: Electron.PDFRenderPool
+    beforeEach(() => {
+      pool = webContents.createPDFRenderPool({ size: 2 })
+    })
+    afterEach(() => {
+      pool.close()
+    })
+
+    it('renders queued documents in parallel', async () => {
+      expect(pool.size).to.equal(2)
+      const results = await Promise.all([1, 2, 3].map((i) => {
+        return pool.render({ html: `<h1>Document ${i}</h1>` })
+      }))
+      for (const { data, timing } of results) {
+        expect(data).to.be.an.instanceof(Buffer)
+        expect((data as Buffer).toString('latin1', 0, 5)).to.equal('%PDF-')
+        expect(timing.total).to.be.at.least(timing.load + timing.print)
+      }
+      expect(pool.pendingJobCount).to.equal(0)
+    })
+
+    it('rejects documents that fail to load', async () => {
+      await expect(pool.render({ url: 'file:///does-not-exist.html' })).to.eventually.be.rejectedWith(/Failed to load/)
+    })
+
+    it('rejects pending jobs when closed', async () => {
+      const job = pool.render({ html: '<h1>Document</h1>' })
+      pool.close()
+      expect(pool.closed).to.be.true('closed')
+      await expect(job).to.eventually.be.rejectedWith('The PDF render pool is closed')
+    })
+
+    it('rejects html too large to be loaded as a data: URL', async () => {
+      const html = `<p>${'a'.repeat(2 * 1024 * 1024)}</p>`
+      await expect(pool.render({ html })).to.eventually.be.rejectedWith(/html is too large/)
+      expect(pool.pendingJobCount).to.equal(0)
+    })
+
+    it('rejects documents that do not finish loading before the timeout', async () => {
+      // Accepts the request but never answers it.
+      const server = http.createServer(() => {})
+      await new Promise(resolve => server.listen(0, '127.0.0.1', resolve))
+      const { port } = server.address() as AddressInfo
+      const timeoutPool = webContents.createPDFRenderPool({ size: 1, timeout: 200 })
+      try {
+        await expect(timeoutPool.render({ url: `http://127.0.0.1:${port}` })).to.eventually.be.rejectedWith('Timed out rendering PDF')
+        // The renderer is replaced and the pool keeps working.
+        const { data } = await timeoutPool.render({ html: '<h1>Document</h1>' })
+        expect((data as Buffer).toString('latin1', 0, 5)).to.equal('%PDF-')
+      } finally {
+        timeoutPool.close()
+        server.close()
+      }
+    })
+
+    it('replaces renderers after maxJobsPerRenderer jobs', async () => {
+      const created: Electron.WebContents[] = []
+      const onCreated = (event: Electron.Event, contents: Electron.WebContents) => { created.push(contents) }
+      app.on('web-contents-created', onCreated)
+      const replacingPool = webContents.createPDFRenderPool({ size: 1, maxJobsPerRenderer: 2 })
+      try {
+        for (let i = 0; i < 4; ++i) {
+          await replacingPool.render({ html: `<h1>Document ${i}</h1>` })
+        }
+      } finally {
+        replacingPool.close()
+        app.removeListener('web-contents-created', onCreated)
+      }
+      expect(created).to.have.lengthOf(2)
+    })
+  })
+
   describe('webContents.executeJavaScript', () => {
     describe('in about:blank', () => {
       const expected = 'hello, world!'
@@ -433,6 +604,15 @@ describe('webContents module', () => {
         done()
       })
     })
+
+    it('reflects preferences changed after creation', () => {
+      const w = new BrowserWindow({ show: false })
+      w.setBackgroundColor('#ff0000')
+      w.webContents.setIgnoreMenuShortcuts(true)
+      const preferences = w.webContents.getWebPreferences()
+      expect(preferences.backgroundColor).to.equal('#ff0000')
+      expect(preferences.ignoreMenuShortcuts).to.be.true('ignoreMenuShortcuts')
+    })
   })
 
   describe('openDevTools() API', () => {
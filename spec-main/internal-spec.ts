@@ -1,4 +1,9 @@
 import { expect } from 'chai'
+import { BrowserWindow } from 'electron'
+import { ifdescribe } from './spec-helpers'
+import { closeAllWindows } from './window-helpers'
+
+const features = process.electronBinding('features')
 
 describe('feature-string parsing', () => {
   it('is indifferent to whitespace around keys and values', () => {
@@ -20,3 +25,50 @@ describe('feature-string parsing', () => {
     checkParse(' a = yes , c = d ', { a: true, c: 'd' })
   })
 })
+
+describe('v8Util.createIDWeakMap', () => {
+  it('keeps working when many of its objects are collected at once', () => {
+    const v8Util = process.electronBinding('v8_util')
+    const map = v8Util.createIDWeakMap()
+    const kept: { id: number }[] = []
+    for (let id = 1; id <= 10000; id++) {
+      const object = { id }
+      map.set(id, object)
+      // The survivors keep the window mostly empty, so it is trimmed and
+      // entries are moved out of it from within the weak callbacks.
+      if (id % 500 === 0) kept.push(object)
+    }
+    v8Util.requestGarbageCollectionForTesting()
+    for (const object of kept) {
+      expect(map.get(object.id)).to.equal(object)
+    }
+    expect(map.has(1)).to.equal(false)
+
+    // Everything dies in the same collection, including the moved entries.
+    kept.length = 0
+    v8Util.requestGarbageCollectionForTesting()
+    expect(map.has(500)).to.equal(false)
+    expect(map.has(10000)).to.equal(false)
+
+    const object = { id: 10001 }
+    map.set(object.id, object)
+    expect(map.get(object.id)).to.equal(object)
+  })
+})
+
+ifdescribe(features.isCodeCacheEnabled())('embedded code cache', () => {
+  afterEach(closeAllWindows)
+
+  // The cache is only accepted when it was generated under the same V8
+  // flags as the process that loads it.
+  it('is not rejected in the main process', () => {
+    expect(features.getRejectedCodeCache()).to.deep.equal([])
+  })
+
+  it('is not rejected in renderers', async () => {
+    const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true } })
+    await w.loadURL('about:blank')
+    const rejected = await w.webContents.executeJavaScript(`process.electronBinding('features').getRejectedCodeCache()`)
+    expect(rejected).to.deep.equal([])
+  })
+})
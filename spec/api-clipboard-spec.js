@@ -136,4 +136,34 @@ describe('clipboard module', () => {
       expect(buffer.equals(clipboard.readBuffer('public.utf8-plain-text'))).to.equal(true)
     })
   })
+
+  describe('async variants', () => {
+    it('reads and writes images', async () => {
+      const i = nativeImage.createFromPath(path.join(fixtures, 'assets', 'logo.png'))
+      await clipboard.writeImageAsync(i)
+      const image = await clipboard.readImageAsync()
+      expect(image.getSize()).to.deep.equal(i.getSize())
+      expect(image.toDataURL()).to.equal(clipboard.readImage().toDataURL())
+    })
+
+    it('reads markup', async () => {
+      clipboard.writeHTML('<string>Hi</string>')
+      expect(await clipboard.readHTMLAsync()).to.equal(clipboard.readHTML())
+    })
+
+    it('reads and writes Buffers', async function () {
+      if (process.platform !== 'darwin') {
+        this.skip()
+      }
+
+      const buffer = Buffer.from('writeBufferAsync', 'utf8')
+      await clipboard.writeBufferAsync('public.utf8-plain-text', buffer)
+      expect(clipboard.readText()).to.equal('writeBufferAsync')
+      expect(buffer.equals(await clipboard.readBufferAsync('public.utf8-plain-text'))).to.equal(true)
+    })
+
+    it('rejects when a non-Buffer is specified', async () => {
+      await expect(clipboard.writeBufferAsync('public.utf8-plain-text', 'hello')).to.eventually.be.rejectedWith(/buffer must be a node Buffer/)
+    })
+  })
 })
@@ -3,6 +3,8 @@
 const chai = require('chai')
 const dirtyChai = require('dirty-chai')
 const { nativeImage } = require('electron')
+const fs = require('fs')
+const os = require('os')
 const path = require('path')
 
 const { expect } = chai
@@ -170,6 +172,46 @@ describe('nativeImage module', () => {
       expect(imageC.getSize()).to.deep.equal({ width: 269, height: 95 })
     })
 
+    it('can use the memory of the buffer without copying it', () => {
+      const pixels = Buffer.alloc(4 * 4 * 4, 0xff)
+      const image = nativeImage.createFromBitmap(pixels, { width: 4, height: 4, copy: false })
+      expect(image.getSize()).to.deep.equal({ width: 4, height: 4 })
+      expect(image.toBitmap().equals(pixels)).to.be.true()
+
+      pixels.fill(0x80)
+      expect(image.toBitmap().equals(pixels)).to.be.true()
+      expect(image.getBitmap().equals(pixels)).to.be.true()
+    })
+
+    it('copies the memory of the buffer before reading it on another thread', async () => {
+      const pixels = Buffer.alloc(4 * 4 * 4, 0xff)
+      const image = nativeImage.createFromBitmap(pixels, { width: 4, height: 4, copy: false })
+      const resized = image.resizeAsync({ width: 2, height: 2 })
+      pixels.fill(0)
+      expect((await resized).toBitmap().every((byte) => byte === 0xff)).to.be.true()
+      expect(image.toBitmap().every((byte) => byte === 0xff)).to.be.true()
+    })
+
+    it('copies the memory of the buffer for images derived from it', () => {
+      const pixels = Buffer.alloc(4 * 4 * 4, 0xff)
+      const image = nativeImage.createFromBitmap(pixels, { width: 4, height: 4, copy: false })
+      const cropped = image.crop({ x: 0, y: 0, width: 2, height: 2 })
+      const transformed = image.transform([])
+      pixels.fill(0)
+      expect(cropped.toBitmap().every((byte) => byte === 0xff)).to.be.true()
+      expect(transformed.toBitmap().every((byte) => byte === 0xff)).to.be.true()
+    })
+
+    it('becomes empty when the memory of the buffer is transferred', () => {
+      const pixels = Buffer.from(new ArrayBuffer(4 * 4 * 4))
+      const image = nativeImage.createFromBitmap(pixels, { width: 4, height: 4, copy: false })
+      const { port1 } = new MessageChannel()
+      port1.postMessage(null, [pixels.buffer])
+      expect(pixels.buffer.byteLength).to.equal(0)
+      expect(image.isEmpty()).to.be.true()
+      expect(image.toBitmap().length).to.equal(0)
+    })
+
     it('throws on invalid arguments', () => {
       expect(() => nativeImage.createFromBitmap(null, {})).to.throw('buffer must be a node Buffer')
       expect(() => nativeImage.createFromBitmap([12, 14, 124, 12], {})).to.throw('buffer must be a node Buffer')
@@ -392,6 +434,60 @@ describe('nativeImage module', () => {
       expect(image.isEmpty()).to.be.false()
       expect(image.getSize()).to.deep.equal({ width: 256, height: 256 })
     })
+    describe('cache', () => {
+      const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+      let budget
+
+      before(() => {
+        budget = nativeImage.getCacheStats().budget
+      })
+
+      afterEach(() => {
+        nativeImage.setCacheBudget(budget)
+      })
+
+      it('reuses decoded files', () => {
+        const first = nativeImage.createFromPath(logoPath)
+        const { hits } = nativeImage.getCacheStats()
+        const second = nativeImage.createFromPath(logoPath)
+        expect(nativeImage.getCacheStats().hits).to.equal(hits + 1)
+        expect(second.toBitmap().equals(first.toBitmap())).to.be.true()
+      })
+
+      it('does not let getBitmap() write to the shared pixels', () => {
+        const first = nativeImage.createFromPath(logoPath)
+        const second = nativeImage.createFromPath(logoPath)
+        const original = second.toBitmap()
+        first.getBitmap().fill(0)
+        expect(second.toBitmap().equals(original)).to.be.true()
+        expect(nativeImage.createFromPath(logoPath).toBitmap().equals(original)).to.be.true()
+      })
+
+      it('decodes files again after they change', () => {
+        const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-native-image-'))
+        const imagePath = path.join(dir, 'image.png')
+        try {
+          fs.copyFileSync(logoPath, imagePath)
+          expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 538, height: 190 })
+          fs.copyFileSync(path.join(__dirname, 'fixtures', 'assets', '3x3.png'), imagePath)
+          expect(nativeImage.createFromPath(imagePath).getSize()).to.deep.equal({ width: 3, height: 3 })
+        } finally {
+          fs.unlinkSync(imagePath)
+          fs.rmdirSync(dir)
+        }
+      })
+
+      it('evicts files to stay within the budget', () => {
+        const image = nativeImage.createFromPath(logoPath)
+        const { evictions } = nativeImage.getCacheStats()
+        nativeImage.setCacheBudget(0)
+        const stats = nativeImage.getCacheStats()
+        expect(stats.entries).to.equal(0)
+        expect(stats.size).to.equal(0)
+        expect(stats.evictions).to.be.above(evictions)
+        expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
+      })
+    })
   })
 
   describe('createFromNamedImage(name)', () => {
@@ -493,6 +589,126 @@ describe('nativeImage module', () => {
     })
   })
 
+  describe('async variants', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    it('createFromPathAsync() decodes the same image as createFromPath()', async () => {
+      const image = await nativeImage.createFromPathAsync(logoPath)
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
+      expect(image.toBitmap().equals(nativeImage.createFromPath(logoPath).toBitmap())).to.be.true()
+      expect((await nativeImage.createFromPathAsync('does-not-exist.png')).isEmpty()).to.be.true()
+    })
+
+    it('createFromBufferAsync() decodes PNG buffers', async () => {
+      const image = await nativeImage.createFromBufferAsync(nativeImage.createFromPath(logoPath).toPNG())
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
+    })
+
+    it('createFromBufferAsync() rejects non-buffers', async () => {
+      await expect(nativeImage.createFromBufferAsync('not a buffer')).to.eventually.be.rejected()
+    })
+
+    it('toPNGAsync() and toJPEGAsync() return encoded buffers', async () => {
+      const image = nativeImage.createFromPath(logoPath).resize({ width: 100 })
+      expect((await image.toPNGAsync()).equals(image.toPNG())).to.be.true()
+      const jpeg = nativeImage.createFromBuffer(await image.toJPEGAsync(80))
+      expect(jpeg.getSize()).to.deep.equal(image.getSize())
+    })
+
+    it('resizeAsync() and cropAsync() match their synchronous versions', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const resized = await image.resizeAsync({ width: 269 })
+      expect(resized.getSize()).to.deep.equal({ width: 269, height: 95 })
+      expect((await image.resizeAsync({ width: 0, height: 0 })).isEmpty()).to.be.true()
+
+      const cropped = await image.cropAsync({ width: 25, height: 64, x: 30, y: 40 })
+      expect(cropped.toBitmap().equals(image.crop({ width: 25, height: 64, x: 30, y: 40 }).toBitmap())).to.be.true()
+      expect((await image.cropAsync({ width: 100, height: 100, x: 1000, y: 1000 })).isEmpty()).to.be.true()
+    })
+  })
+
+  describe('toBitmap(options)', () => {
+    const pixel = (b, g, r, a) => Buffer.from([b, g, r, a])
+
+    it('converts between channel orders and alpha modes', () => {
+      // A half transparent red pixel, premultiplied and in BGRA order.
+      const image = nativeImage.createFromBitmap(pixel(0, 0, 0x80, 0x80), { width: 1, height: 1, format: 'bgra' })
+      expect(image.toBitmap({ format: 'bgra' })).to.deep.equal(pixel(0, 0, 0x80, 0x80))
+      expect(image.toBitmap({ format: 'rgba' })).to.deep.equal(Buffer.from([0x80, 0, 0, 0x80]))
+      expect(image.toBitmap({ format: 'rgba', premultiplied: false })[0]).to.be.within(0xfe, 0xff)
+
+      const fromRGBA = nativeImage.createFromBitmap(Buffer.from([0xff, 0, 0, 0x80]), { width: 1, height: 1, format: 'rgba', premultiplied: false })
+      expect(fromRGBA.toBitmap({ format: 'bgra' })[2]).to.be.within(0x7f, 0x81)
+    })
+
+    it('returns I420 planes', () => {
+      const image = nativeImage.createFromBitmap(Buffer.alloc(3 * 3 * 4, 0xff), { width: 3, height: 3 })
+      const planes = image.toBitmap({ format: 'i420' })
+      expect(planes).to.have.lengthOf(3 * 3 + 2 * 2 * 2)
+    })
+
+    it('throws on an invalid format', () => {
+      const image = nativeImage.createFromPath(path.join(__dirname, 'fixtures', 'assets', 'logo.png'))
+      expect(() => image.toBitmap({ format: 'argb' })).to.throw('invalid format: argb')
+    })
+  })
+
+  describe('transform(operations)', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    it('chains operations', () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const result = image.transform([
+        { type: 'resize', width: 269 },
+        { type: 'blur', radius: 2 },
+        { type: 'grayscale' }
+      ])
+      expect(result.getSize()).to.deep.equal({ width: 269, height: 95 })
+      const bitmap = result.toBitmap()
+      for (let i = 0; i < bitmap.length; i += 4) {
+        expect(bitmap[i]).to.equal(bitmap[i + 1])
+        expect(bitmap[i + 1]).to.equal(bitmap[i + 2])
+      }
+      expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
+    })
+
+    it('supports every resize filter', () => {
+      const image = nativeImage.createFromPath(logoPath)
+      for (const filter of ['box', 'bilinear', 'lanczos']) {
+        expect(image.transform([{ type: 'resize', width: 100, height: 50, filter }]).getSize())
+          .to.deep.equal({ width: 100, height: 50 })
+      }
+    })
+
+    it('composites images', () => {
+      const background = nativeImage.createFromBitmap(Buffer.alloc(4 * 4 * 4), { width: 4, height: 4 })
+      const overlay = nativeImage.createFromBitmap(Buffer.alloc(2 * 2 * 4, 0xff), { width: 2, height: 2 })
+      const bitmap = background.transform([{ type: 'composite', image: overlay, x: 2, y: 2 }]).toBitmap()
+      expect(bitmap.readUInt32LE(0)).to.equal(0)
+      expect(bitmap.readUInt32LE((3 * 4 + 3) * 4)).to.equal(0xffffffff)
+    })
+
+    it('does not modify the image when there are no operations', () => {
+      const image = nativeImage.createFromPath(logoPath)
+      expect(image.transform([]).toBitmap().equals(image.toBitmap())).to.be.true()
+    })
+
+    it('throws on invalid operations', () => {
+      const image = nativeImage.createFromPath(logoPath)
+      expect(() => image.transform([{ type: 'sharpen' }])).to.throw('invalid operation type: sharpen')
+      expect(() => image.transform([{ type: 'resize' }])).to.throw('resize requires a width or a height')
+      expect(() => image.transform([{ type: 'composite' }])).to.throw('composite requires an image')
+    })
+
+    it('has an async variant', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const operations = [{ type: 'resize', width: 100, height: 40 }, { type: 'grayscale' }]
+      const result = await image.transformAsync(operations)
+      expect(result.toBitmap().equals(image.transform(operations).toBitmap())).to.be.true()
+      await expect(image.transformAsync([{ type: 'sharpen' }])).to.eventually.be.rejectedWith('invalid operation type: sharpen')
+    })
+  })
+
   describe('getAspectRatio()', () => {
     it('returns an aspect ratio of an empty image', () => {
       expect(nativeImage.createEmpty().getAspectRatio()).to.equal(1.0)
@@ -114,5 +114,44 @@ describe('process module', () => {
       const success = process.takeHeapSnapshot('')
       expect(success).to.be.false()
     })
+
+    it('writes a gzipped snapshot and reports progress', () => {
+      const filePath = path.join(remote.app.getPath('temp'), 'test.heapsnapshot.gz')
+
+      try {
+        const progress = []
+        const success = process.takeHeapSnapshot(filePath, {
+          compression: 'gzip',
+          onProgress: stats => progress.push(stats)
+        })
+        expect(success).to.be.true()
+        expect(progress).to.not.be.empty()
+
+        const stats = progress[progress.length - 1]
+        expect(stats.uncompressedBytes).to.be.greaterThan(stats.bytesWritten)
+        expect(stats.snapshotTime).to.be.a('number')
+        expect(stats.serializationTime).to.be.a('number')
+        expect(stats.stallTime).to.be.a('number')
+        for (let i = 1; i < progress.length; i++) {
+          expect(progress[i].uncompressedBytes).to.be.at.least(progress[i - 1].uncompressedBytes)
+        }
+
+        const data = fs.readFileSync(filePath)
+        expect(data.length).to.equal(stats.bytesWritten)
+        const json = require('zlib').gunzipSync(data).toString()
+        expect(json.length).to.equal(stats.uncompressedBytes)
+        expect(JSON.parse(json)).to.have.property('snapshot')
+      } finally {
+        try {
+          fs.unlinkSync(filePath)
+        } catch (e) {
+          // ignore error
+        }
+      }
+    })
+
+    it('throws on invalid options', () => {
+      expect(() => process.takeHeapSnapshot('', { compression: 'bogus' })).to.throw(/Invalid heap snapshot options/)
+    })
   })
 })
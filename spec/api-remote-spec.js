@@ -190,6 +190,33 @@ describe('remote module', () => {
       property.property = 1127
     })
 
+    it('reads the current values of its data properties', () => {
+      const batch = remote.require(path.join(fixtures, 'module', 'batch-properties.js'))
+      expect(batch.frozen).to.equal(42)
+      expect(batch.counter).to.equal(0)
+      batch.increment()
+      expect(batch.counter).to.equal(1)
+      expect(batch.label).to.equal('batch')
+      batch.label = 'changed'
+      expect(batch.label).to.equal('changed')
+    })
+
+    it('reads several properties in one round trip with getProperties()', () => {
+      const batch = remote.require(path.join(fixtures, 'module', 'batch-properties.js'))
+      batch.label = 'batch'
+      expect(remote.getProperties(batch, ['frozen', 'label', 'missing'])).to.deep.equal({
+        frozen: 42,
+        label: 'batch',
+        missing: undefined
+      })
+      batch.label = 'changed'
+      expect(remote.getProperties(batch, ['label'])).to.deep.equal({ label: 'changed' })
+      expect(() => remote.getProperties({}, ['label'])).to.throw('Expected a remote object')
+
+      const foo = remote.require(path.join(fixtures, 'module', 'error-properties.js'))
+      expect(() => remote.getProperties(foo, ['bar'])).to.throw('getting error')
+    })
+
     it('rethrows errors getting/setting properties', () => {
       const foo = remote.require(path.join(fixtures, 'module', 'error-properties.js'))
 
@@ -437,6 +437,26 @@ describe('webContents module', () => {
       }
     })
 
+    it('can write a gzipped snapshot', async () => {
+      await w.loadURL('about:blank')
+
+      const filePath = path.join(remote.app.getPath('temp'), 'test.heapsnapshot.gz')
+
+      try {
+        const stats = await w.webContents.takeHeapSnapshot(filePath, { compression: 'gzip' })
+        expect(stats.bytesWritten).to.equal(fs.statSync(filePath).size)
+        expect(stats.uncompressedBytes).to.be.greaterThan(stats.bytesWritten)
+        const json = require('zlib').gunzipSync(fs.readFileSync(filePath)).toString()
+        expect(JSON.parse(json)).to.have.property('snapshot')
+      } finally {
+        try {
+          fs.unlinkSync(filePath)
+        } catch (e) {
+          // ignore error
+        }
+      }
+    })
+
     it('fails with invalid file path', async () => {
       w.destroy()
       w = new BrowserWindow({
@@ -526,6 +546,22 @@ describe('webContents module', () => {
       const data = await w.webContents.printToPDF({})
       expect(data).to.be.an.instanceof(Buffer).that.is.not.empty()
     })
+
+    it('can print to a PDF file', async () => {
+      const pdfPath = path.join(remote.app.getPath('temp'), 'print-to-pdf-file.pdf')
+      await w.loadURL('data:text/html,%3Ch1%3EHello%2C%20World!%3C%2Fh1%3E')
+      await w.webContents.printToPDFFile(pdfPath, {})
+      try {
+        const data = fs.readFileSync(pdfPath)
+        expect(data.toString('latin1', 0, 5)).to.equal('%PDF-')
+      } finally {
+        fs.unlinkSync(pdfPath)
+      }
+    })
+
+    it('rejects printing to a PDF file without a path', async () => {
+      await expect(w.webContents.printToPDFFile('', {})).to.eventually.be.rejectedWith('Must specify a path')
+    })
   })
 
   describe('PictureInPicture video', () => {
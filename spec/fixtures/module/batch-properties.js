@@ -0,0 +1,8 @@
+Object.defineProperty(exports, 'frozen', { value: 42, enumerable: true })
+
+exports.label = 'batch'
+exports.counter = 0
+
+exports.increment = () => {
+  exports.counter++
+}
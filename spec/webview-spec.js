@@ -1070,6 +1070,10 @@ describe('<webview> tag', function () {
       const data = await webview.printToPDF({})
       expect(data).to.be.an.instanceof(Buffer).that.is.not.empty()
     })
+
+    it('does not expose writing the PDF to a file', () => {
+      expect(webview.printToPDFFile).to.be.undefined()
+    })
   })
 
   describe('will-attach-webview event', () => {
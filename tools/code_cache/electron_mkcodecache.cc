@@ -0,0 +1,223 @@
+// Copyright (c) 2019 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+// Build-time tool that compiles Electron's js2c bundles and writes their V8
+// code cache out as a C++ source file defining
+// electron::RegisterEmbedderCodeCache().
+//
+// Usage: electron_mkcodecache <output.cc>
+//
+// V8 only accepts a code cache produced under the same flag hash, so the
+// tool goes through the same gin and node initialization as
+// JavascriptEnvironment and NodeBindings::Initialize rather than running
+// with V8's defaults.
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/environment.h"
+#include "gin/array_buffer.h"
+#include "gin/public/isolate_holder.h"
+#include "libplatform/libplatform.h"
+#include "shell/common/node_includes.h"
+#include "third_party/electron_node/src/node_native_module_env.h"
+#include "v8/include/v8.h"
+
+namespace {
+
+// Parameters of the function wrapper each bundle is compiled with at
+// runtime. These have to match the callers of NativeModuleEnv, otherwise
+// V8 rejects the cache and the bundle is compiled from source.
+struct BundleInfo {
+  const char* id;
+  std::vector<const char*> parameters;
+};
+
+// Bundles that node's loader requires as builtin modules.
+const std::vector<const char*> kModuleParameters = {
+    "exports", "require", "module", "process", "internalBinding",
+    "primordials"};
+
+const std::vector<BundleInfo> kBundles = {
+    {"electron/js2c/browser_init", kModuleParameters},
+    {"electron/js2c/renderer_init", kModuleParameters},
+    {"electron/js2c/worker_init", kModuleParameters},
+    {"electron/js2c/asar", kModuleParameters},
+    // See InitAsarSupport in atom_api_asar.cc.
+    {"electron/js2c/asar_init", {"require"}},
+    // See AtomSandboxedRendererClient::DidCreateScriptContext.
+    {"electron/js2c/sandbox_bundle", {"binding"}},
+    // See SetupMainWorldOverrides in the renderer clients.
+    {"electron/js2c/isolated_bundle", {"nodeProcess", "isolatedWorld"}},
+    // See SetupExtensionWorldOverrides in the renderer clients.
+    {"electron/js2c/content_script_bundle",
+     {"nodeProcess", "isolatedWorld", "worldId"}},
+};
+
+std::string GetDefinitionName(const std::string& id) {
+  std::string name;
+  for (char c : id)
+    name += (isalnum(c) ? c : '_');
+  return name + "_code_cache";
+}
+
+std::string FormatCodeCache(const std::string& name,
+                            const v8::ScriptCompiler::CachedData* data) {
+  std::ostringstream ss;
+  ss << "const uint8_t " << name << "[] = {";
+  for (int i = 0; i < data->length; ++i) {
+    if (i % 16 == 0)
+      ss << "\n   ";
+    ss << " " << static_cast<int>(data->data[i]) << ",";
+  }
+  ss << "\n};\n\n";
+  return ss.str();
+}
+
+bool Generate(v8::Local<v8::Context> context, std::string* out) {
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::Local<v8::Object> sources =
+      node::native_module::NativeModuleEnv::GetSourceObject(context);
+
+  std::ostringstream definitions;
+  std::ostringstream initializers;
+  for (const auto& bundle : kBundles) {
+    v8::Local<v8::Value> source;
+    if (!sources
+             ->Get(context, v8::String::NewFromUtf8(isolate, bundle.id,
+                                                    v8::NewStringType::kNormal)
+                                .ToLocalChecked())
+             .ToLocal(&source) ||
+        !source->IsString()) {
+      std::cerr << "Missing js2c source for " << bundle.id << std::endl;
+      return false;
+    }
+
+    std::vector<v8::Local<v8::String>> parameters;
+    for (const char* parameter : bundle.parameters) {
+      parameters.push_back(v8::String::NewFromUtf8(isolate, parameter,
+                                                   v8::NewStringType::kNormal)
+                               .ToLocalChecked());
+    }
+
+    std::string filename = std::string(bundle.id) + ".js";
+    v8::ScriptOrigin origin(
+        v8::String::NewFromUtf8(isolate, filename.c_str(),
+                                v8::NewStringType::kNormal)
+            .ToLocalChecked(),
+        v8::Integer::New(isolate, 0), v8::Integer::New(isolate, 0),
+        v8::True(isolate));
+    v8::ScriptCompiler::Source script_source(source.As<v8::String>(), origin);
+    v8::TryCatch try_catch(isolate);
+    v8::Local<v8::Function> fn;
+    if (!v8::ScriptCompiler::CompileFunctionInContext(
+             context, &script_source, parameters.size(), parameters.data(), 0,
+             nullptr, v8::ScriptCompiler::kEagerCompile)
+             .ToLocal(&fn)) {
+      std::cerr << "Failed to compile " << bundle.id << std::endl;
+      return false;
+    }
+
+    std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+        v8::ScriptCompiler::CreateCodeCacheForFunction(fn));
+    if (!cached_data) {
+      std::cerr << "Failed to create code cache for " << bundle.id
+                << std::endl;
+      return false;
+    }
+
+    std::string name = GetDefinitionName(bundle.id);
+    definitions << FormatCodeCache(name, cached_data.get());
+    initializers << "  node::native_module::NativeModuleEnv::"
+                    "AddEmbedderCodeCache(\n      \""
+                 << bundle.id << "\", " << name << ", sizeof(" << name
+                 << "));\n";
+  }
+
+  std::ostringstream ss;
+  ss << "// This file is generated by electron_mkcodecache, do not edit.\n\n"
+     << "#include <cstdint>\n"
+     << "#include <string>\n"
+     << "#include <vector>\n\n"
+     << "#include \"shell/common/node_code_cache.h\"\n"
+     << "#include \"shell/common/node_includes.h\"\n"
+     << "#include \"third_party/electron_node/src/node_native_module_env.h\""
+        "\n\n"
+     << "namespace electron {\n\nnamespace {\n\n"
+     << definitions.str() << "}  // namespace\n\n"
+     << "void RegisterEmbedderCodeCache() {\n"
+     << initializers.str() << "}\n\n"
+     << "bool HasEmbedderCodeCache() {\n  return true;\n}\n\n"
+     << "std::vector<std::string> GetRejectedEmbedderCodeCache() {\n"
+     << "  return node::native_module::NativeModuleEnv::"
+        "GetRejectedCodeCache();\n}\n\n"
+     << "}  // namespace electron\n";
+  *out = ss.str();
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <output.cc>" << std::endl;
+    return 1;
+  }
+
+  v8::V8::InitializeICUDefaultLocation(argv[0]);
+  v8::V8::InitializeExternalStartupData(argv[0]);
+  std::unique_ptr<v8::Platform> platform = v8::platform::NewDefaultPlatform();
+  v8::V8::InitializePlatform(platform.get());
+  // Applies the feature-driven V8 flags and initializes V8.
+  gin::IsolateHolder::Initialize(gin::IsolateHolder::kNonStrictMode,
+                                 gin::ArrayBufferAllocator::SharedInstance(),
+                                 nullptr /* external_reference_table */,
+                                 false /* create_v8_platform */);
+
+  // Applies node's own V8 options. NODE_OPTIONS from the build environment
+  // must not leak into the cache.
+  base::Environment::Create()->UnSetVar("NODE_OPTIONS");
+  int node_argc = 1;
+  int node_exec_argc = 0;
+  const char* prog_name = "electron";
+  const char** node_argv = &prog_name;
+  const char** node_exec_argv = nullptr;
+  node::g_upstream_node_mode = false;
+  node::Init(&node_argc, node_argv, &node_exec_argc, &node_exec_argv);
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator =
+      gin::ArrayBufferAllocator::SharedInstance();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+
+  std::string cache;
+  bool success;
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    success = Generate(context, &cache);
+  }
+  isolate->Dispose();
+  v8::V8::Dispose();
+  v8::V8::ShutdownPlatform();
+
+  if (!success)
+    return 1;
+
+  std::ofstream out(argv[1], std::ios::out | std::ios::binary);
+  if (!out.is_open()) {
+    std::cerr << "Cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+  out << cache;
+  return out.good() ? 0 : 1;
+}
@@ -13,6 +13,8 @@ declare namespace NodeJS {
     isPictureInPictureEnabled(): boolean;
     isExtensionsEnabled(): boolean;
     isComponentBuild(): boolean;
+    isCodeCacheEnabled(): boolean;
+    getRejectedCodeCache(): string[];
   }
 
   interface IpcBinding {
@@ -21,6 +23,8 @@ declare namespace NodeJS {
     sendToHost(channel: string, args: any[]): void;
     sendTo(internal: boolean, sendToAll: boolean, webContentsId: number, channel: string, args: any[]): void;
     invoke<T>(internal: boolean, channel: string, args: any[]): Promise<{ error: string, result: T }>;
+    getStats(): Record<string, Electron.IPCChannelStats>;
+    resetStats(): void;
   }
 
   interface V8UtilBinding {
@@ -103,6 +103,8 @@ declare namespace ElectronInternal {
 
   interface DesktopCapturer {
     startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
+    startStreaming(captureWindow: boolean, captureScreen: boolean, thumbnailSizes: Electron.Size[], fetchWindowIcons: boolean): void;
+    releaseLists(): void;
     emit: typeof NodeJS.EventEmitter.prototype.emit | null;
   }
 
@@ -111,6 +113,10 @@ declare namespace ElectronInternal {
     captureScreen: boolean;
     thumbnailSize: Electron.Size;
     fetchWindowIcons: boolean;
+    // Set when the renderer wants sources and thumbnails as they are
+    // captured, for each of |thumbnailSizes| in turn.
+    streamId?: number;
+    thumbnailSizes?: Electron.Size[];
   }
 
   interface GetSourcesResult {